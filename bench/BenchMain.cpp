@@ -0,0 +1,136 @@
+// Runs the benchmark suite and writes its results as JSON.
+//
+// Usage: poiesis-bench [--quick] [--filter SEGMENTS] [--ticks N] [--workers N]
+//     [--seed N] [--output FILE] [--revision TEXT]
+//
+// Quick runs time micro benchmarks for less time and leave out the largest
+// worlds, for a fast check. Only benchmarks whose name contains the filter
+// as whole segments run, so "level3" runs every world of level 3 and
+// "macro/level1/10000" runs that world alone. The ticks given are the ones of
+// the smallest worlds, the larger ones run proportionally fewer. Results go to
+// the standard output unless a file is given, and progress to the standard
+// error. The revision is only written along with the results, to tell runs
+// apart. Macro benchmarks are seeded with a fixed seed, 42 unless given, so
+// every run simulates the same worlds, and the seed is written along with the
+// results too. Simulation checks run first, and nothing is timed when any of
+// them fails.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "bandit/Engine.h"
+
+#include "Benchmark.h"
+#include "MacroBenchmarks.h"
+#include "MicroBenchmarks.h"
+#include "SimulationChecks.h"
+
+int main(int argc, char* argv[])
+{
+    LOG_SET_WARNING();
+    CFG_INIT("Configurations.cfg");
+
+    bool quick = false;
+    std::string filter;
+    std::string output;
+    std::string revision = "unknown";
+    unsigned int ticks = 300;
+    unsigned int workers = JobSystem::GetDefaultNumberOfWorkers();
+    uint64_t seed = 42;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--quick") == 0)
+            quick = true;
+        else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            filter = argv[++i];
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+            ticks = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--workers") == 0 && hasValue)
+            workers = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+            output = argv[++i];
+        else if (std::strcmp(argv[i], "--revision") == 0 && hasValue)
+            revision = argv[++i];
+        else
+        {
+            LOG_E("Usage: " << argv[0] << " [--quick] [--filter SEGMENTS] "
+                << "[--ticks N] [--workers N] [--seed N] [--output FILE] "
+                << "[--revision TEXT]");
+            return 1;
+        }
+    }
+
+    if (ticks == 0)
+    {
+        LOG_E("The number of ticks must be greater than zero");
+        return 1;
+    }
+
+    // A zero seed is replaced by one from the clock, which would make every
+    // run simulate different worlds.
+    if (seed == 0)
+    {
+        LOG_E("The seed must be greater than zero");
+        return 1;
+    }
+
+    if (!SimulationChecks::Run())
+    {
+        LOG_E("Simulation checks failed, benchmarks are not run");
+        return 1;
+    }
+
+    BenchmarkSuite suite(quick ? 0.05 : 0.5, filter);
+
+    MicroBenchmarks::RunEntityManager(suite);
+    MicroBenchmarks::RunEntityFactory(suite);
+    MicroBenchmarks::RunQuadtree(suite);
+    MicroBenchmarks::RunVector(suite);
+    MicroBenchmarks::RunConfigParser(suite);
+
+    unsigned int worldSizes[] = {1000, 10000, 100000};
+
+    for (int level = 1; level <= 3; ++level)
+    {
+        for (auto entities : worldSizes)
+        {
+            if (quick && entities > 10000)
+                continue;
+
+            // Larger worlds run proportionally fewer ticks, so every world
+            // simulates about as many entities in total.
+            unsigned int worldTicks = std::max(1u,
+                ticks*worldSizes[0]/entities);
+
+            MacroBenchmarks::RunLevel(suite, level, entities, worldTicks,
+                workers, seed);
+        }
+    }
+
+    if (output.empty())
+    {
+        suite.WriteJson(std::cout, revision, seed);
+        return 0;
+    }
+
+    std::ofstream stream(output);
+
+    if (!stream.is_open())
+    {
+        LOG_E("Could not create file: " << output);
+        return 1;
+    }
+
+    suite.WriteJson(stream, revision, seed);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Benchmark.h"
+
+#include <iostream>
+
+#include "bandit/core/Allocations.h"
+
+BenchmarkSuite::BenchmarkSuite(double minimumTime, std::string filter) :
+    minimumTime(minimumTime), filter(filter)
+{
+}
+
+bool BenchmarkSuite::IsSelected(std::string name)
+{
+    if (filter.empty())
+        return true;
+
+    // Wrapping both in slashes only finds the filter where it starts and ends
+    // at segment boundaries, so level1/1000 leaves out level1/10000.
+    return (("/" + name + "/").find("/" + filter + "/") != std::string::npos);
+}
+
+void BenchmarkSuite::AddResult(const BenchmarkResult& result)
+{
+    results.push_back(result);
+
+    // Progress goes to the error stream, keeping the output plain JSON.
+    std::cerr << result.name;
+
+    for (auto& metric : result.metrics)
+        std::cerr << " " << metric.first << "=" << metric.second;
+
+    std::cerr << std::endl;
+}
+
+void BenchmarkSuite::WriteJson(std::ostream& stream, std::string revision,
+    uint64_t seed)
+{
+    stream << std::setprecision(6);
+    stream << "{\n  \"revision\": \"" << Escape(revision) << "\",\n";
+    stream << "  \"seed\": " << seed << ",\n";
+    stream << "  \"benchmarks\": [";
+
+    for (unsigned int i = 0; i < results.size(); ++i)
+    {
+        stream << (i == 0 ? "\n" : ",\n");
+        stream << "    {\"name\": \"" << Escape(results[i].name)
+            << "\", \"type\": \"" << results[i].type << "\"";
+
+        for (auto& metric : results[i].metrics)
+            stream << ", \"" << metric.first << "\": " << metric.second;
+
+        stream << "}";
+    }
+
+    stream << "\n  ]\n}\n";
+}
+
+unsigned long BenchmarkSuite::GetNumberOfAllocations()
+{
+    return Allocations::GetNumberOfAllocations();
+}
+
+std::string BenchmarkSuite::Escape(std::string text)
+{
+    std::string escaped;
+
+    for (auto character : text)
+    {
+        if (character == '"' || character == '\\')
+            escaped += '\\';
+
+        escaped += character;
+    }
+
+    return escaped;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+// Minimal benchmark harness writing its results as JSON.
+//
+// Micro benchmarks time a single operation over many iterations and report
+// the time and allocations per operation. Macro benchmarks run whole worlds
+// and report their own metrics. Allocations are the ones counted by the
+// engine, which the benchmark build compiles with BANDIT_COUNT_ALLOCATIONS to
+// replace the global operator new, so they include every allocation of the
+// measured code, the standard library's as well.
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct BenchmarkResult
+{
+    std::string name;
+
+    // Either "micro" or "macro".
+    std::string type;
+
+    // Pairs of metric name and value, in the order they are written.
+    std::vector<std::pair<std::string, double>> metrics;
+};
+
+class BenchmarkSuite
+{
+  public:
+    // Creates a suite timing each micro benchmark for at least the given
+    // time, in seconds, and running only the benchmarks whose name contains
+    // the filter as whole segments, the parts between slashes. An empty
+    // filter runs all benchmarks.
+    BenchmarkSuite(double minimumTime, std::string filter);
+
+    // Checks whether the benchmark with the given name must run.
+    bool IsSelected(std::string name);
+
+    // Times the operation, run in batches of growing size until a batch
+    // lasts the minimum time, and records its time and allocations per
+    // operation. Values returned by the operation are kept alive, so the
+    // compiler can't optimize the operation away.
+    template <typename Operation>
+    void Measure(std::string name, Operation operation);
+
+    // Records a result measured by the caller.
+    void AddResult(const BenchmarkResult& result);
+
+    // Writes all results, along with the revision and the seed of the macro
+    // benchmarks they were measured with.
+    void WriteJson(std::ostream& stream, std::string revision, uint64_t seed);
+
+    // Gets the number of allocations made since the program started.
+    static unsigned long GetNumberOfAllocations();
+
+    // Keeps a value alive as if it were used.
+    template <typename T>
+    static void KeepAlive(const T& value);
+
+  private:
+    static std::string Escape(std::string text);
+
+    double minimumTime;
+    std::string filter;
+    std::vector<BenchmarkResult> results;
+};
+
+template <typename Operation>
+void BenchmarkSuite::Measure(std::string name, Operation operation)
+{
+    if (!IsSelected(name))
+        return;
+
+    unsigned long iterations = 1;
+
+    while (true)
+    {
+        unsigned long allocations = GetNumberOfAllocations();
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned long i = 0; i < iterations; ++i)
+            KeepAlive(operation());
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        allocations = GetNumberOfAllocations() - allocations;
+
+        if (elapsed.count() >= minimumTime)
+        {
+            BenchmarkResult result;
+            result.name = name;
+            result.type = "micro";
+            result.metrics.push_back(std::make_pair("iterations", iterations));
+            result.metrics.push_back(std::make_pair("ns_per_op",
+                elapsed.count()*1e9/iterations));
+            result.metrics.push_back(std::make_pair("allocations_per_op",
+                static_cast<double>(allocations)/iterations));
+            AddResult(result);
+            return;
+        }
+
+        iterations *= 2;
+    }
+}
+
+template <typename T>
+void BenchmarkSuite::KeepAlive(const T& value)
+{
+#ifdef __GNUC__
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+#endif // BENCHMARK_H_
\ No newline at end of file
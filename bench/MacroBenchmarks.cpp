@@ -0,0 +1,224 @@
+#include "MacroBenchmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+
+#include "bandit/Engine.h"
+
+#include "poiesis/levels/Level1.h"
+#include "poiesis/levels/Level2.h"
+#include "poiesis/levels/Level3.h"
+
+namespace
+{
+    // Presentation system recording the time, entities and allocations of
+    // every frame. It is added before the level starts, so it is presented
+    // after the level systems.
+    class ProbeSystem : public System
+    {
+      public:
+        ProbeSystem() :
+            numberOfFrames(0), initialEntities(0), finalEntities(0),
+            sumOfEntities(0), initialAllocations(0), finalAllocations(0)
+        {
+            Presents();
+        }
+
+        std::string GetName() { return "ProbeSystem"; }
+
+        void Update(float)
+        {
+            auto now = std::chrono::steady_clock::now();
+            unsigned int entities = Engine::GetInstance().GetNumberOfEntities();
+
+            if (numberOfFrames == 0)
+            {
+                start = now;
+                initialEntities = entities;
+                initialAllocations = BenchmarkSuite::GetNumberOfAllocations();
+            }
+            else
+            {
+                sumOfEntities += entities;
+            }
+
+            end = now;
+            finalEntities = entities;
+            finalAllocations = BenchmarkSuite::GetNumberOfAllocations();
+            ++numberOfFrames;
+        }
+
+        // Ticks between the first and the last frames.
+        unsigned int GetNumberOfTicks()
+        {
+            return numberOfFrames > 0 ? numberOfFrames - 1 : 0;
+        }
+
+        double GetSeconds()
+        {
+            return std::chrono::duration<double>(end - start).count();
+        }
+
+        unsigned int numberOfFrames;
+        unsigned int initialEntities;
+        unsigned int finalEntities;
+        unsigned long sumOfEntities;
+        unsigned long initialAllocations;
+        unsigned long finalAllocations;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    std::string ToString(double value)
+    {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    }
+
+    bool StartsWith(const std::string& text, const std::string& prefix)
+    {
+        return text.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    // Scales the entity counts and bounds of the level so it holds about the
+    // given number of entities. Returns the entries changed, with their
+    // original values.
+    std::vector<std::pair<std::string, std::string>> ScaleLevel(int level,
+        unsigned int entities)
+    {
+        std::vector<std::pair<std::string, std::string>> counts, bounds, changed;
+        std::string prefix = "LEVEL_" + std::to_string(level) + "_";
+        double baseline = 0;
+
+        for (auto& entry : ConfigParser::GetInstance().GetEntries())
+        {
+            if (StartsWith(entry.first, prefix + "INITIAL_NUM_")
+                || StartsWith(entry.first, prefix + "NUM_"))
+            {
+                counts.push_back(entry);
+                baseline += std::atof(entry.second.c_str());
+            }
+            else if (entry.first == prefix + "MIN_X" || entry.first == prefix + "MAX_X"
+                || entry.first == prefix + "MIN_Y" || entry.first == prefix + "MAX_Y"
+                || entry.first == "LEVEL_MIN_X" || entry.first == "LEVEL_MAX_X"
+                || entry.first == "LEVEL_MIN_Y" || entry.first == "LEVEL_MAX_Y")
+            {
+                bounds.push_back(entry);
+            }
+        }
+
+        if (baseline == 0)
+        {
+            LOG_E("[MacroBenchmarks] Level " << level << " creates no entities");
+            exit(1);
+        }
+
+        double factor = entities/baseline;
+
+        // Bounds grow with the square root of the counts, keeping the density.
+        // The ones of the whole world never shrink, so scaled levels still fit.
+        for (auto& entry : bounds)
+        {
+            double scale = std::sqrt(factor);
+
+            if (!StartsWith(entry.first, prefix))
+                scale = std::max(scale, 1.0);
+
+            ConfigParser::GetInstance().Set(entry.first,
+                ToString(std::atof(entry.second.c_str())*scale));
+        }
+
+        for (auto& entry : counts)
+            ConfigParser::GetInstance().Set(entry.first,
+                ToString(std::round(std::atof(entry.second.c_str())*factor)));
+
+        changed.insert(changed.end(), counts.begin(), counts.end());
+        changed.insert(changed.end(), bounds.begin(), bounds.end());
+
+        return changed;
+    }
+}
+
+void MacroBenchmarks::RunLevel(BenchmarkSuite& suite, int level,
+    unsigned int entities, unsigned int ticks, unsigned int workers,
+    uint64_t seed)
+{
+    std::string name = "macro/level" + std::to_string(level) + "/"
+        + std::to_string(entities);
+
+    if (!suite.IsSelected(name))
+        return;
+
+    auto originalEntries = ScaleLevel(level, entities);
+    float timeStep = CFG_GETF("SIMULATION_TIME_STEP");
+    auto inputAdapter = std::make_shared<ScriptedInputAdapter>();
+    auto probeSystem = std::make_shared<ProbeSystem>();
+
+    // The level starts on the first tick, presented as the first frame
+    // timed, and the tick quitting is never presented, so one more tick runs
+    // than the ones timed.
+    inputAdapter->Schedule(ticks + 1, InputType::QuitButtonPress);
+
+    Engine::GetInstance().Initialize(
+        std::make_shared<NullSystemAdapter>(),
+        std::make_shared<VirtualTimerAdapter>(timeStep),
+        std::make_shared<NullGraphicsAdapter>(),
+        std::make_shared<NullAudioAdapter>(),
+        std::make_shared<NullAudioAdapter>(),
+        inputAdapter,
+        std::make_shared<EntityManager>(),
+        std::make_shared<LevelManager>(),
+        std::make_shared<SystemManager>(),
+        std::make_shared<JobSystem>(workers));
+
+    Engine::GetInstance().SetRandomSeed(seed);
+    Engine::GetInstance().SetTimeStep(timeStep);
+    Engine::GetInstance().SetMaxStepsPerFrame(1);
+    Engine::GetInstance().SetTargetFrameRate(0);
+    Engine::GetInstance().AddSystem(probeSystem);
+
+    if (level == 1)
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level1>());
+    else if (level == 2)
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level2>());
+    else
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level3>());
+
+    Engine::GetInstance().Run();
+    BANDIT_ENGINE_SHUTDOWN();
+
+    for (auto& entry : originalEntries)
+        ConfigParser::GetInstance().Set(entry.first, entry.second);
+
+    unsigned int measuredTicks = probeSystem->GetNumberOfTicks();
+    double seconds = probeSystem->GetSeconds();
+    double averageEntities = measuredTicks > 0
+        ? static_cast<double>(probeSystem->sumOfEntities)/measuredTicks : 0;
+    double allocations = probeSystem->finalAllocations
+        - probeSystem->initialAllocations;
+
+    BenchmarkResult result;
+    result.name = name;
+    result.type = "macro";
+    result.metrics.push_back(std::make_pair("entities", entities));
+    result.metrics.push_back(std::make_pair("initial_entities",
+        probeSystem->initialEntities));
+    result.metrics.push_back(std::make_pair("final_entities",
+        probeSystem->finalEntities));
+    result.metrics.push_back(std::make_pair("ticks", measuredTicks));
+    result.metrics.push_back(std::make_pair("workers", workers));
+    result.metrics.push_back(std::make_pair("seconds", seconds));
+    result.metrics.push_back(std::make_pair("ns_per_tick",
+        measuredTicks > 0 ? seconds*1e9/measuredTicks : 0));
+    result.metrics.push_back(std::make_pair("entities_per_second",
+        seconds > 0 ? averageEntities*measuredTicks/seconds : 0));
+    result.metrics.push_back(std::make_pair("allocations", allocations));
+    result.metrics.push_back(std::make_pair("allocations_per_tick",
+        measuredTicks > 0 ? allocations/measuredTicks : 0));
+    suite.AddResult(result);
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+// Macro benchmarks running the game levels headless, with their worlds scaled
+// to a given number of entities, for a fixed number of ticks.
+//
+// Entity counts of a level are scaled from its configuration, and so are its
+// bounds, so the density of the world stays the one the level was designed
+// with. Ticks are timed from the first frame presented after the level
+// started, so the cost of creating the world is left out.
+
+#ifndef MACRO_BENCHMARKS_H_
+#define MACRO_BENCHMARKS_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace MacroBenchmarks
+{
+    // Runs the level, scaled to about the given number of entities, for the
+    // given number of ticks, each a simulation step followed by a presented
+    // frame.
+    void RunLevel(BenchmarkSuite& suite, int level, unsigned int entities,
+        unsigned int ticks, unsigned int workers, uint64_t seed);
+}
+
+#endif // MACRO_BENCHMARKS_H_
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "MicroBenchmarks.h"
+
+#include <memory>
+#include <vector>
+
+#include "bandit/Engine.h"
+
+#include "poiesis/EntityFactory.h"
+#include "poiesis/Quadtree.h"
+#include "poiesis/components/EatableComponent.h"
+#include "poiesis/components/GrowthComponent.h"
+#include "poiesis/components/ParticleComponent.h"
+
+namespace
+{
+    // Number of entities in the entity manager benchmarks.
+    const unsigned int NUMBER_OF_ENTITIES = 10000;
+
+    // Number of objects in the quadtree benchmarks.
+    const unsigned int NUMBER_OF_OBJECTS = 1000;
+
+    // Area covered by quadtrees, the size of the default levels.
+    const Rectangle QUADTREE_AREA(-3000, -3000, 6000, 6000);
+
+    // Handle to the same key as the get_float benchmark, to compare both ways
+    // of reading a value.
+    CfgFloat simulationTimeStep("SIMULATION_TIME_STEP");
+}
+
+void MicroBenchmarks::RunEntityManager(BenchmarkSuite& suite)
+{
+    EntityManager entityManager;
+    std::vector<Entity> entities;
+    Random random(1);
+
+    // Every entity has a particle, half of them are eatable and a quarter of
+    // them grow, as a mix of the classes a level queries.
+    for (unsigned int i = 0; i < NUMBER_OF_ENTITIES; ++i)
+    {
+        Entity entity = entityManager.CreateEntity();
+
+        entityManager.AddComponent(
+            entityManager.CreateComponent<ParticleComponent>(1,
+                Vector(random.GenerateFloat(-3000, 3000),
+                    random.GenerateFloat(-3000, 3000))), entity);
+
+        if (i % 2 == 0)
+            entityManager.AddComponent(
+                entityManager.CreateComponent<EatableComponent>(), entity);
+
+        if (i % 4 == 0)
+            entityManager.AddComponent(
+                entityManager.CreateComponent<GrowthComponent>(), entity);
+
+        entities.push_back(entity);
+    }
+
+    unsigned int next = 0;
+
+    suite.Measure("micro/entity_manager/view", [&]()
+    {
+        return entityManager.View<ParticleComponent, EatableComponent>().size();
+    });
+
+    suite.Measure("micro/entity_manager/get", [&]()
+    {
+        next = (next + 1) % NUMBER_OF_ENTITIES;
+        return entityManager.Get<ParticleComponent>(entities[next])->GetPosition();
+    });
+
+    suite.Measure("micro/entity_manager/has", [&]()
+    {
+        next = (next + 1) % NUMBER_OF_ENTITIES;
+        return entityManager.Has<GrowthComponent>(entities[next]);
+    });
+
+    suite.Measure("micro/entity_manager/get_by_class_name", [&]()
+    {
+        next = (next + 1) % NUMBER_OF_ENTITIES;
+        return entityManager.GetSingleComponentOfClass(entities[next],
+            "ParticleComponent").get();
+    });
+
+    suite.Measure("micro/entity_manager/iterate_storage", [&]()
+    {
+        float sum = 0;
+
+        entityManager.GetStorage<ParticleComponent>().ForEach(
+            [&](ParticleComponent& particleComponent)
+            {
+                sum += particleComponent.GetPosition().GetX();
+            });
+
+        return sum;
+    });
+
+    suite.Measure("micro/entity_manager/create_delete", [&]()
+    {
+        Entity entity = entityManager.CreateEntity();
+
+        entityManager.AddComponent(
+            entityManager.CreateComponent<EatableComponent>(), entity);
+        entityManager.DeleteEntity(entity);
+
+        return entity;
+    });
+}
+
+void MicroBenchmarks::RunEntityFactory(BenchmarkSuite& suite)
+{
+    if (!suite.IsSelected("micro/entity_factory/create_delete_food")
+        && !suite.IsSelected("micro/entity_factory/create_delete_cell"))
+        return;
+
+    Engine::GetInstance().Initialize(
+        std::make_shared<NullSystemAdapter>(),
+        std::make_shared<VirtualTimerAdapter>(CFG_GETF("SIMULATION_TIME_STEP")),
+        std::make_shared<NullGraphicsAdapter>(),
+        std::make_shared<NullAudioAdapter>(),
+        std::make_shared<NullAudioAdapter>(),
+        std::make_shared<ScriptedInputAdapter>(),
+        std::make_shared<EntityManager>(),
+        std::make_shared<LevelManager>(),
+        std::make_shared<SystemManager>(),
+        std::make_shared<JobSystem>(1));
+
+    // Spawning is measured in the steady state of a running level, once
+    // storages, entity slots and the queries systems read have grown, so all
+    // of them are grown first by spawning and deleting many entities.
+    std::vector<Entity> entities;
+    Engine::GetInstance().View<ParticleComponent>();
+    Engine::GetInstance().View<SpriteComponent>();
+
+    for (unsigned int i = 0; i < NUMBER_OF_ENTITIES; ++i)
+    {
+        entities.push_back(EntityFactory::CreateFood(Vector(0, 0)));
+        entities.push_back(EntityFactory::CreateCell(Vector(0, 0)));
+    }
+
+    for (auto entity : entities)
+        Engine::GetInstance().DeleteEntity(entity);
+
+    suite.Measure("micro/entity_factory/create_delete_food", []()
+    {
+        Entity entity = EntityFactory::CreateFood(Vector(0, 0));
+        Engine::GetInstance().DeleteEntity(entity);
+        return entity;
+    });
+
+    suite.Measure("micro/entity_factory/create_delete_cell", []()
+    {
+        Entity entity = EntityFactory::CreateCell(Vector(0, 0));
+        Engine::GetInstance().DeleteEntity(entity);
+        return entity;
+    });
+
+    BANDIT_ENGINE_SHUTDOWN();
+}
+
+void MicroBenchmarks::RunQuadtree(BenchmarkSuite& suite)
+{
+    std::vector<Vector> positions;
+    Random random(2);
+
+    for (unsigned int i = 0; i < NUMBER_OF_OBJECTS; ++i)
+        positions.push_back(Vector(random.GenerateFloat(-3000, 3000),
+            random.GenerateFloat(-3000, 3000)));
+
+    suite.Measure("micro/quadtree/build_1000", [&]()
+    {
+        Quadtree<unsigned int> quadtree(QUADTREE_AREA);
+
+        for (unsigned int i = 0; i < positions.size(); ++i)
+            quadtree.Add(i, positions[i]);
+
+        return quadtree.Get(positions[0]).size();
+    });
+
+    Quadtree<unsigned int> quadtree(QUADTREE_AREA);
+    unsigned int next = 0;
+
+    for (unsigned int i = 0; i < positions.size(); ++i)
+        quadtree.Add(i, positions[i]);
+
+    suite.Measure("micro/quadtree/query_1000", [&]()
+    {
+        next = (next + 1) % NUMBER_OF_OBJECTS;
+        return quadtree.Get(positions[next]).size();
+    });
+}
+
+void MicroBenchmarks::RunVector(BenchmarkSuite& suite)
+{
+    Vector a(1, 2);
+    Vector b(0.5, -0.25);
+
+    suite.Measure("micro/vector/add_multiply", [&]()
+    {
+        a.Set(a + b*0.5);
+        return a;
+    });
+
+    suite.Measure("micro/vector/normalize", [&]()
+    {
+        Vector c = a + b;
+        c.Normalize();
+        return c;
+    });
+
+    suite.Measure("micro/vector/rotate", [&]()
+    {
+        b.Rotate(0.01);
+        return b;
+    });
+
+    suite.Measure("micro/vector/distance", [&]()
+    {
+        b.SetX(b.GetX() + 1);
+        return a.CalculateDistance(b);
+    });
+}
+
+void MicroBenchmarks::RunConfigParser(BenchmarkSuite& suite)
+{
+    suite.Measure("micro/config/get_float", []()
+    {
+        return CFG_GETF("SIMULATION_TIME_STEP");
+    });
+
+    suite.Measure("micro/config/get_integer", []()
+    {
+        return CFG_GETI("LEVEL_3_INITIAL_NUM_CELLS");
+    });
+
+    suite.Measure("micro/config/get_bool", []()
+    {
+        return CFG_GETB("DEBUG");
+    });
+
+    suite.Measure("micro/config/handle_float", []()
+    {
+        return simulationTimeStep.Get();
+    });
+}
\ No newline at end of file
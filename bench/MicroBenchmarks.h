@@ -0,0 +1,19 @@
+// Micro benchmarks of the engine building blocks most used every frame:
+// entity queries, entity spawning, quadtrees, vector math and configuration
+// lookups.
+
+#ifndef MICRO_BENCHMARKS_H_
+#define MICRO_BENCHMARKS_H_
+
+#include "Benchmark.h"
+
+namespace MicroBenchmarks
+{
+    void RunEntityManager(BenchmarkSuite& suite);
+    void RunEntityFactory(BenchmarkSuite& suite);
+    void RunQuadtree(BenchmarkSuite& suite);
+    void RunVector(BenchmarkSuite& suite);
+    void RunConfigParser(BenchmarkSuite& suite);
+}
+
+#endif // MICRO_BENCHMARKS_H_
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "SimulationChecks.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "bandit/Engine.h"
+
+#include "poiesis/EntityFactory.h"
+#include "poiesis/components/InfectionComponent.h"
+#include "poiesis/components/ParticleComponent.h"
+#include "poiesis/levels/Level1.h"
+#include "poiesis/systems/CollisionSystem.h"
+
+namespace
+{
+    // Seed of the runs compared by the determinism check.
+    const uint64_t DETERMINISM_SEED = 42;
+
+    // Ticks of the runs compared by the determinism check.
+    const unsigned int DETERMINISM_TICKS = 120;
+
+    // Workers of the threaded run compared by the determinism check.
+    const unsigned int DETERMINISM_WORKERS = 3;
+
+    // Food level 1 starts with in the determinism check, enough for the
+    // particles to span several jobs.
+    const char* DETERMINISM_FOOD = "500";
+
+    void InitializeEngine(std::shared_ptr<InputAdapter> inputAdapter,
+        unsigned int workers)
+    {
+        float timeStep = CFG_GETF("SIMULATION_TIME_STEP");
+
+        Engine::GetInstance().Initialize(
+            std::make_shared<NullSystemAdapter>(),
+            std::make_shared<VirtualTimerAdapter>(timeStep),
+            std::make_shared<NullGraphicsAdapter>(),
+            std::make_shared<NullAudioAdapter>(),
+            std::make_shared<NullAudioAdapter>(),
+            inputAdapter,
+            std::make_shared<EntityManager>(),
+            std::make_shared<LevelManager>(),
+            std::make_shared<SystemManager>(),
+            std::make_shared<JobSystem>(workers));
+    }
+
+    // Solves the collision beginning between a healthy cell and a bacterium
+    // overlapping it from the given side. Returns whether the cell got
+    // infected.
+    bool InfectsCell(float side)
+    {
+        InitializeEngine(std::make_shared<ScriptedInputAdapter>(), 0);
+
+        float distance = CFG_GETF("CELL_COLLIDER_RADIUS");
+        Entity cell = EntityFactory::CreateCell(Vector(0, 0));
+        EntityFactory::CreateBacterium(Vector(side*distance, 0));
+
+        CollisionSystem collisionSystem;
+        collisionSystem.Update(0);
+
+        bool infected = (Engine::GetInstance().Get<InfectionComponent>(cell)
+            ->GetInfectionType() != NoInfection);
+
+        BANDIT_ENGINE_SHUTDOWN();
+
+        return infected;
+    }
+
+    bool CheckInfection()
+    {
+        bool passed = true;
+
+        // Broad phases list pairs in an order of their own, such as from left
+        // to right, so the transmitter must infect from either side.
+        if (!InfectsCell(-1))
+        {
+            LOG_E("[SimulationChecks] Bacterium on the left of a cell did "
+                << "not infect it");
+            passed = false;
+        }
+
+        if (!InfectsCell(1))
+        {
+            LOG_E("[SimulationChecks] Bacterium on the right of a cell did "
+                << "not infect it");
+            passed = false;
+        }
+
+        return passed;
+    }
+
+    // Runs level 1 with the given number of workers and hashes the number of
+    // entities and the positions of their particles once it has finished.
+    uint64_t HashLevel(unsigned int workers)
+    {
+        auto inputAdapter = std::make_shared<ScriptedInputAdapter>();
+        inputAdapter->Schedule(DETERMINISM_TICKS, InputType::QuitButtonPress);
+
+        InitializeEngine(inputAdapter, workers);
+        Engine::GetInstance().SetRandomSeed(DETERMINISM_SEED);
+        Engine::GetInstance().SetTimeStep(CFG_GETF("SIMULATION_TIME_STEP"));
+        Engine::GetInstance().SetMaxStepsPerFrame(1);
+        Engine::GetInstance().SetTargetFrameRate(0);
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level1>());
+        Engine::GetInstance().Run();
+
+        // Hashed with FNV-1a, byte by byte.
+        uint64_t hash = 14695981039346656037ULL;
+        auto mix = [&hash](const void* data, unsigned int size)
+        {
+            for (unsigned int i = 0; i < size; ++i)
+                hash = (hash ^ static_cast<const unsigned char*>(data)[i])
+                    *1099511628211ULL;
+        };
+
+        unsigned int entities = Engine::GetInstance().GetNumberOfEntities();
+        mix(&entities, sizeof(entities));
+
+        for (auto entity : Engine::GetInstance().View<ParticleComponent>())
+        {
+            Vector position = Engine::GetInstance().Get<ParticleComponent>(
+                entity)->GetPosition();
+            float coordinates[] = {position.GetX(), position.GetY()};
+            mix(coordinates, sizeof(coordinates));
+        }
+
+        BANDIT_ENGINE_SHUTDOWN();
+
+        return hash;
+    }
+
+    bool CheckDeterminism()
+    {
+        // Particles are updated by jobs of a fixed number of slots, so the
+        // level is given several times more of them than a job takes.
+        std::string food = CFG_GETS("LEVEL_1_INITIAL_NUM_FOOD");
+        ConfigParser::GetInstance().Set("LEVEL_1_INITIAL_NUM_FOOD",
+            DETERMINISM_FOOD);
+
+        bool passed = (HashLevel(0) == HashLevel(DETERMINISM_WORKERS));
+
+        ConfigParser::GetInstance().Set("LEVEL_1_INITIAL_NUM_FOOD", food);
+
+        if (!passed)
+        {
+            LOG_E("[SimulationChecks] Level 1 ended differently with "
+                << DETERMINISM_WORKERS << " workers than with none");
+        }
+
+        return passed;
+    }
+}
+
+bool SimulationChecks::Run()
+{
+    bool passed = CheckInfection();
+    passed = CheckDeterminism() && passed;
+
+    return passed;
+}
\ No newline at end of file
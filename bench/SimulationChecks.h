@@ -0,0 +1,18 @@
+// Checks run before the benchmarks, making sure the simulation being timed
+// still behaves as the game expects.
+//
+// Each check sets up a tiny world with the same headless adapters as the
+// macro benchmarks, runs the system under check directly and looks at the
+// result. Timings of a simulation failing them would be meaningless, so the
+// suite stops when any check fails.
+
+#ifndef SIMULATION_CHECKS_H_
+#define SIMULATION_CHECKS_H_
+
+namespace SimulationChecks
+{
+    // Runs all checks, logging the ones failing. Returns whether all passed.
+    bool Run();
+}
+
+#endif // SIMULATION_CHECKS_H_
\ No newline at end of file
@@ -7,6 +7,9 @@
 #ifndef ENGINE_H_
 #define ENGINE_H_
 
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -14,8 +17,15 @@
 #include "bandit/adapters/AudioAdapter.h"
 #include "bandit/adapters/GraphicsAdapter.h"
 #include "bandit/adapters/InputAdapter.h"
+#include "bandit/adapters/RecordingInputAdapter.h"
+#include "bandit/adapters/ReplayInputAdapter.h"
 #include "bandit/adapters/SystemAdapter.h"
 #include "bandit/adapters/TimerAdapter.h"
+#include "bandit/adapters/headless/NullAudioAdapter.h"
+#include "bandit/adapters/headless/NullGraphicsAdapter.h"
+#include "bandit/adapters/headless/NullSystemAdapter.h"
+#include "bandit/adapters/headless/ScriptedInputAdapter.h"
+#include "bandit/adapters/headless/VirtualTimerAdapter.h"
 #include "bandit/adapters/sdl/SDLGraphicsAdapter.h"
 #include "bandit/adapters/sdl/SDLInputAdapter.h"
 #include "bandit/adapters/sdl/SDLMusicAdapter.h"
@@ -30,12 +40,17 @@
 #include "bandit/core/math/Rectangle.h"
 #include "bandit/core/math/Vector.h"
 #include "bandit/core/parser/ConfigParser.h"
+#include "bandit/core/thread/JobSystem.h"
+#include "bandit/core/time/FramePacer.h"
 #include "bandit/core/time/PeriodicTimer.h"
+#include "bandit/core/time/Profiler.h"
 #include "bandit/core/time/Timer.h"
 
 #include "bandit/entity/Component.h"
+#include "bandit/entity/ComponentType.h"
 #include "bandit/entity/Entity.h"
 #include "bandit/entity/EntityManager.h"
+#include "bandit/entity/Prefab.h"
 #include "bandit/entity/System.h"
 #include "bandit/entity/SystemManager.h"
 
@@ -51,7 +66,8 @@
         std::make_shared<SDLInputAdapter>(), \
         std::make_shared<EntityManager>(), \
         std::make_shared<LevelManager>(), \
-        std::make_shared<SystemManager>())
+        std::make_shared<SystemManager>(), \
+        std::make_shared<JobSystem>(JobSystem::GetDefaultNumberOfWorkers()))
 
 #define BANDIT_ENGINE_SHUTDOWN() \
     Engine::GetInstance().Shutdown()
@@ -66,6 +82,7 @@ class Engine
     std::shared_ptr<EntityManager> GetEntityManager();
     std::shared_ptr<SystemManager> GetSystemManager();
     std::shared_ptr<LevelManager> GetLevelManager();
+    std::shared_ptr<JobSystem> GetJobSystem();
 
     // Initializes engine adapters and managers.
     void Initialize(
@@ -77,7 +94,8 @@ class Engine
         std::shared_ptr<InputAdapter> inputAdapter,
         std::shared_ptr<EntityManager> entityManager,
         std::shared_ptr<LevelManager> levelManager,
-        std::shared_ptr<SystemManager> systemManager);
+        std::shared_ptr<SystemManager> systemManager,
+        std::shared_ptr<JobSystem> jobSystem);
 
     // Shutdown engine adapters and managers.
     void Shutdown();
@@ -88,33 +106,99 @@ class Engine
     void StopSoundEffect(std::string file);
 
     void CreateWindow(std::string title, int height, int width);
+
+    // Sets the seed every random stream is derived from. A seed of zero is
+    // replaced by one taken from the clock, which is logged so the run can be
+    // reproduced.
+    void SetRandomSeed(uint64_t seed);
+    uint64_t GetRandomSeed();
+
+    // Sets the fixed time step the simulation advances by, regardless of the
+    // time actually elapsed between frames.
+    void SetTimeStep(float timeStep);
+    float GetTimeStep();
+
+    // Sets the maximum number of simulation steps run in a single frame.
+    // Frames taking longer than that many steps slow the game down instead
+    // of running ever more steps to catch up.
+    void SetMaxStepsPerFrame(unsigned int maxStepsPerFrame);
+
+    // Sets the number of frames presented per second. Zero leaves frames
+    // uncapped.
+    void SetTargetFrameRate(float frameRate);
+
+    // Gets statistics of the latest frame times.
+    FrameStats GetFrameStats();
+
+    // Gets how far the current frame is between the previous simulation step
+    // and the last one, from 0 to 1, so presentation can interpolate between
+    // both.
+    float GetInterpolation();
+
+    // Records the session into a replay file: the random seed, the
+    // configuration, the time step and the inputs of every simulation step,
+    // so the session can be played back exactly. Must be called after
+    // setting the random seed and the time step.
+    void RecordReplay(std::string file);
+
+    // Plays back a replay file, restoring its random seed, configuration and
+    // time step and feeding its inputs instead of the live ones. Must be
+    // called before creating any level.
+    void PlayReplay(std::string file);
+
     void SetCurrentLevel(std::shared_ptr<Level> level);
     void SetNextLevel(std::shared_ptr<Level> level);
 
-    std::shared_ptr<Entity> CreateEntity();
-    void DeleteEntity(std::shared_ptr<Entity> entity);
+    Entity CreateEntity();
+    Entity Instantiate(const Prefab& prefab);
+    std::vector<Entity> Instantiate(const Prefab& prefab,
+        unsigned int numberOfEntities);
+    void DeleteEntity(Entity entity);
+    void DeleteEntityDeferred(Entity entity);
+    bool IsAlive(Entity entity);
+    bool IsDeleted(Entity entity);
     void DeleteEntitiesWithComponentsOfClass(std::string componentClass);
-    void DeleteComponentsOfClass(std::shared_ptr<Entity> entity,
+    void DeleteComponentsOfClass(Entity entity,
         std::string componentClass);
     void ClearEntities();
-    std::vector<std::shared_ptr<Entity>> GetAllEntitiesWithComponentOfClass(
+    const std::vector<Entity>& GetAllEntitiesWithComponentOfClass(
         std::string componentClass);
-    std::shared_ptr<Entity> GetEntityWithComponentOfClass(
+    Entity GetEntityWithComponentOfClass(
         std::string componentClass);
     unsigned int GetNumberOfEntities();
     bool HasEntityWithComponentOfClass(std::string componentClass);
 
     void AddComponent(std::shared_ptr<Component> component,
-        std::shared_ptr<Entity> entity);
+        Entity entity);
+    void AddComponentDeferred(std::shared_ptr<Component> component,
+        Entity entity);
+    void DeleteComponentsOfClassDeferred(Entity entity,
+        std::string componentClass);
     std::vector<std::shared_ptr<Component>> GetComponentsOfClass(
-        std::shared_ptr<Entity> entity, std::string componentClass);
+        Entity entity, std::string componentClass);
     std::shared_ptr<Component> GetSingleComponentOfClass(
-        std::shared_ptr<Entity> entity, std::string componentClass);
+        Entity entity, std::string componentClass);
     std::vector<std::shared_ptr<Component>> GetAllComponentsOfClass(
         std::string componentClass);
-    bool HasComponent(std::shared_ptr<Entity> entity,
+    bool HasComponent(Entity entity,
         std::string componentClass);
 
+    // Typed counterparts of the component queries above, which avoid string
+    // comparisons.
+    template <typename T>
+    std::shared_ptr<T> Get(Entity entity);
+    template <typename T>
+    std::vector<std::shared_ptr<T>> GetComponents(
+        Entity entity);
+    template <typename T>
+    bool Has(Entity entity);
+    template <typename... T>
+    const std::vector<Entity>& View();
+    template <typename T, typename... Args>
+    std::shared_ptr<T> CreateComponent(Args&&... args);
+    template <typename T>
+    ComponentStorage<T>& GetStorage();
+
     void AddSystem(std::shared_ptr<System> system);
     void DeleteSystem(std::string name);
     void ClearSystems();
@@ -127,13 +211,13 @@ class Engine
 
   private:
     // Singleton pattern.
-    Engine() {};
+    Engine() : timeStep(1/30.0f), maxStepsPerFrame(5), interpolation(0) {};
     Engine(const Engine&) = delete;
     void operator=(const Engine&) = delete;
 
-    // Calculates the amount of time the engine can sleep in this frame in
-    // order to maintain a constant frame rate.
-    float CalculateSleepTime(float currentFrameRate);
+    // Processes inputs and advances the simulation by one time step. Returns
+    // false when the game must stop.
+    bool Step();
 
     std::shared_ptr<SystemAdapter> systemAdapter;
     std::shared_ptr<TimerAdapter> timerAdapter;
@@ -144,6 +228,50 @@ class Engine
     std::shared_ptr<EntityManager> entityManager;
     std::shared_ptr<LevelManager> levelManager;
     std::shared_ptr<SystemManager> systemManager;
+    std::shared_ptr<JobSystem> jobSystem;
+    std::shared_ptr<FramePacer> framePacer;
+
+    float timeStep;
+    unsigned int maxStepsPerFrame;
+    float interpolation;
 };
 
+template <typename T>
+std::shared_ptr<T> Engine::Get(Entity entity)
+{
+    return entityManager->Get<T>(entity);
+}
+
+template <typename T>
+std::vector<std::shared_ptr<T>> Engine::GetComponents(
+    Entity entity)
+{
+    return entityManager->GetComponents<T>(entity);
+}
+
+template <typename T>
+bool Engine::Has(Entity entity)
+{
+    return entityManager->Has<T>(entity);
+}
+
+template <typename... T>
+const std::vector<Entity>& Engine::View()
+{
+    return entityManager->View<T...>();
+}
+
+template <typename T, typename... Args>
+std::shared_ptr<T> Engine::CreateComponent(Args&&... args)
+{
+    return entityManager->CreateComponent<T>(std::forward<Args>(args)...);
+}
+
+
+template <typename T>
+ComponentStorage<T>& Engine::GetStorage()
+{
+    return entityManager->GetStorage<T>();
+}
+
 #endif // ENGINE_H_
\ No newline at end of file
@@ -3,6 +3,9 @@
 #ifndef INPUT_ADAPTER_H_
 #define INPUT_ADAPTER_H_
 
+#include <utility>
+#include <vector>
+
 // All supported types of input.
 namespace InputType
 {
@@ -99,6 +102,10 @@ class InputAdapter
     // Checks whether the input type (with an optional button specifier)
     // occurred in the meanwhile.
     virtual bool CheckInputOccurred(InputType::Type inputType, int button = 0) = 0;
+
+    // Gets the inputs that occurred in the meanwhile, each one with its
+    // button specifier, in the order they happened.
+    virtual const std::vector<std::pair<InputType::Type, int>>& GetOccurredInputs() = 0;
 };
 
 #endif // INPUT_ADAPTER_H_
\ No newline at end of file
@@ -0,0 +1,31 @@
+// Input adapter recording the inputs of another adapter into a replay file,
+// frame by frame, as they are processed.
+
+#ifndef RECORDING_INPUT_ADAPTER_H_
+#define RECORDING_INPUT_ADAPTER_H_
+
+#include <memory>
+#include <string>
+
+#include "bandit/adapters/InputAdapter.h"
+#include "bandit/adapters/ReplayFile.h"
+
+class RecordingInputAdapter : public InputAdapter
+{
+  public:
+    RecordingInputAdapter(std::shared_ptr<InputAdapter> adapter,
+        std::string file, const ReplayHeader& header);
+
+    int GetMouseX();
+    int GetMouseY();
+    void ProcessInputs();
+    bool CheckInputOccurred(InputType::Type inputType, int button = 0);
+    const std::vector<std::pair<InputType::Type, int>>& GetOccurredInputs();
+
+  private:
+    std::shared_ptr<InputAdapter> adapter;
+    ReplayFile replayFile;
+    ReplayFrame frame;
+};
+
+#endif // RECORDING_INPUT_ADAPTER_H_
\ No newline at end of file
@@ -0,0 +1,78 @@
+// Replay file, holding everything needed to run a game session again exactly
+// as it was recorded: the random seed, the configuration, the time step the
+// simulation was advanced with and the inputs of each frame.
+//
+// Files start with a header, followed by one record per frame. Integers are
+// stored as variable-length quantities and mouse positions as the difference
+// from the previous frame, so a frame with no inputs and a still mouse takes
+// three bytes. Frames are flushed as they are written, so recordings of
+// sessions that crashed can still be replayed up to the crash.
+
+#ifndef REPLAY_FILE_H_
+#define REPLAY_FILE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bandit/adapters/InputAdapter.h"
+#include "bandit/core/Log.h"
+
+// Session data written once, before the frames.
+struct ReplayHeader
+{
+    uint64_t seed;
+    float timeStep;
+    std::vector<std::pair<std::string, std::string>> configuration;
+};
+
+// Inputs of a single frame.
+struct ReplayFrame
+{
+    int mouseX;
+    int mouseY;
+    std::vector<std::pair<InputType::Type, int>> inputs;
+};
+
+class ReplayFile
+{
+  public:
+    ReplayFile();
+    ~ReplayFile();
+
+    // Creates a file, replacing any existing one, and writes its header.
+    void Create(std::string file, const ReplayHeader& header);
+
+    // Opens an existing file and reads its header.
+    void Open(std::string file, ReplayHeader& header);
+
+    void Close();
+
+    void WriteFrame(const ReplayFrame& frame);
+
+    // Reads the next frame. Returns false when there are no frames left.
+    bool ReadFrame(ReplayFrame& frame);
+
+  private:
+    void WriteInteger(uint64_t value);
+    void WriteSignedInteger(int64_t value);
+    void WriteString(const std::string& value);
+    bool ReadInteger(uint64_t& value);
+    bool ReadSignedInteger(int64_t& value);
+    bool ReadString(std::string& value);
+
+    // Identifies replay files and their format version.
+    static const char MAGIC[4];
+    static const unsigned int VERSION = 1;
+
+    std::fstream stream;
+
+    // Mouse position of the last frame written or read.
+    int mouseX;
+    int mouseY;
+};
+
+#endif // REPLAY_FILE_H_
\ No newline at end of file
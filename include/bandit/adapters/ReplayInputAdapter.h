@@ -0,0 +1,44 @@
+// Input adapter feeding back the inputs recorded into a replay file, one frame
+// of the file per processing.
+//
+// The live adapter is still processed, so the window keeps responding and
+// quitting it stops the replay. Once the recorded frames run out, a quit is
+// reported as well.
+
+#ifndef REPLAY_INPUT_ADAPTER_H_
+#define REPLAY_INPUT_ADAPTER_H_
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "bandit/adapters/InputAdapter.h"
+#include "bandit/adapters/ReplayFile.h"
+
+class ReplayInputAdapter : public InputAdapter
+{
+  public:
+    ReplayInputAdapter(std::shared_ptr<InputAdapter> adapter,
+        std::string file);
+
+    // Gets the header of the replay file, with the session the frames were
+    // recorded in.
+    const ReplayHeader& GetHeader();
+
+    int GetMouseX();
+    int GetMouseY();
+    void ProcessInputs();
+    bool CheckInputOccurred(InputType::Type inputType, int button = 0);
+    const std::vector<std::pair<InputType::Type, int>>& GetOccurredInputs();
+
+  private:
+    std::shared_ptr<InputAdapter> adapter;
+    ReplayFile replayFile;
+    ReplayHeader header;
+    ReplayFrame frame;
+
+    // Number of frames fed back so far.
+    unsigned int numberOfFrames;
+};
+
+#endif // REPLAY_INPUT_ADAPTER_H_
\ No newline at end of file
@@ -8,6 +8,10 @@ class TimerAdapter
   public:
     virtual ~TimerAdapter() {}
 
+    // Gets the time of a monotonic clock, in seconds, as precisely as the
+    // platform allows.
+    virtual double GetTime() = 0;
+
     // Gets the elapsed time since the last invocation of this method, in
     // seconds.
     virtual float GetElapsedTime() = 0;
@@ -0,0 +1,25 @@
+// Implementation of AudioAdapter interface playing nothing, for running the
+// engine with no audio device.
+
+#ifndef NULL_AUDIO_ADAPTER_H_
+#define NULL_AUDIO_ADAPTER_H_
+
+#include <string>
+#include <unordered_set>
+
+#include "bandit/adapters/AudioAdapter.h"
+
+class NullAudioAdapter : public AudioAdapter
+{
+  public:
+    void Load(std::string file);
+    void Unload(std::string file);
+    bool IsLoaded(std::string file);
+    void Play(std::string file, int repetitions = 0);
+    void Stop(std::string file);
+
+  private:
+    std::unordered_set<std::string> audios;
+};
+
+#endif // NULL_AUDIO_ADAPTER_H_
\ No newline at end of file
@@ -0,0 +1,40 @@
+// Implementation of GraphicsAdapter interface drawing nothing, for running the
+// engine with no display. Loaded images and fonts are still tracked, so
+// callers see the same state they would with a display.
+
+#ifndef NULL_GRAPHICS_ADAPTER_H_
+#define NULL_GRAPHICS_ADAPTER_H_
+
+#include <string>
+#include <unordered_set>
+
+#include "bandit/adapters/GraphicsAdapter.h"
+
+class NullGraphicsAdapter : public GraphicsAdapter
+{
+  public:
+    NullGraphicsAdapter();
+    void CreateWindow(std::string title, int width, int height);
+    void DestroyWindow();
+    void LoadImage(std::string file);
+    void UnloadImage(std::string file);
+    bool IsLoaded(std::string file);
+    void LoadFont(std::string fontFile, int size);
+    void UnloadFont(std::string fontFile);
+    bool IsFontLoaded(std::string fontFile);
+    void InitRendering();
+    void RenderImage(std::string file, int x, int y, float rotation, float scale = 1, int currentFrame = 0, int numFrames = 1);
+    void RenderCenteredImage(std::string file, int x, int y, float rotation, float scale = 1, int currentFrame = 0, int numFrames = 1);
+    void Write(std::string text, std::string fontFile, int x, int y);
+    void FinishRendering();
+
+    // Gets the number of images and texts that would have been drawn.
+    unsigned long GetNumberOfRenderings();
+
+  private:
+    std::unordered_set<std::string> images;
+    std::unordered_set<std::string> fonts;
+    unsigned long numberOfRenderings;
+};
+
+#endif // NULL_GRAPHICS_ADAPTER_H_
\ No newline at end of file
@@ -0,0 +1,16 @@
+// Implementation of SystemAdapter interface with no subsystems to initialize,
+// for running the engine with no display or audio device.
+
+#ifndef NULL_SYSTEM_ADAPTER_H_
+#define NULL_SYSTEM_ADAPTER_H_
+
+#include "bandit/adapters/SystemAdapter.h"
+
+class NullSystemAdapter : public SystemAdapter
+{
+  public:
+    void Initialize();
+    void Shutdown();
+};
+
+#endif // NULL_SYSTEM_ADAPTER_H_
\ No newline at end of file
@@ -0,0 +1,49 @@
+// Implementation of InputAdapter interface feeding inputs scheduled ahead of
+// time, for driving the engine with no input device.
+//
+// Inputs are scheduled by tick, where each processing of the inputs is one
+// tick, starting from zero. The mouse stays where it was last moved to.
+
+#ifndef SCRIPTED_INPUT_ADAPTER_H_
+#define SCRIPTED_INPUT_ADAPTER_H_
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "bandit/adapters/InputAdapter.h"
+
+class ScriptedInputAdapter : public InputAdapter
+{
+  public:
+    ScriptedInputAdapter();
+
+    // Schedules an input to occur at the given tick.
+    void Schedule(unsigned int tick, InputType::Type inputType, int button = 0);
+
+    // Schedules the mouse to move to the given position at the given tick.
+    void ScheduleMouse(unsigned int tick, int x, int y);
+
+    // Gets the number of times inputs have been processed.
+    unsigned int GetTick();
+
+    int GetMouseX();
+    int GetMouseY();
+    void ProcessInputs();
+    bool CheckInputOccurred(InputType::Type inputType, int button = 0);
+    const std::vector<std::pair<InputType::Type, int>>& GetOccurredInputs();
+
+  private:
+    std::multimap<unsigned int, std::pair<InputType::Type, int>> inputs;
+    std::map<unsigned int, std::pair<int, int>> mousePositions;
+
+    // Inputs of the current tick.
+    std::vector<std::pair<InputType::Type, int>> occurredInputs;
+
+    unsigned int tick;
+    int mouseX;
+    int mouseY;
+};
+
+#endif // SCRIPTED_INPUT_ADAPTER_H_
\ No newline at end of file
@@ -0,0 +1,30 @@
+// Implementation of TimerAdapter interface with a virtual clock, for running
+// the engine as fast as possible while it still sees time passing steadily.
+//
+// The clock never follows the wall clock. It advances by a fixed tick each
+// time it is read, and by the whole duration of each sleep, which returns
+// immediately. With frames uncapped, the engine reads the clock once per
+// frame, so every frame lasts exactly one tick.
+
+#ifndef VIRTUAL_TIMER_ADAPTER_H_
+#define VIRTUAL_TIMER_ADAPTER_H_
+
+#include "bandit/adapters/TimerAdapter.h"
+
+class VirtualTimerAdapter : public TimerAdapter
+{
+  public:
+    explicit VirtualTimerAdapter(double tick);
+    double GetTime();
+    float GetElapsedTime();
+    void Sleep(float seconds);
+
+  private:
+    double tick;
+    double time;
+
+    // Stores the time of the last calling of GetElapsedTime.
+    double previousTime;
+};
+
+#endif // VIRTUAL_TIMER_ADAPTER_H_
\ No newline at end of file
@@ -20,6 +20,7 @@ class SDLInputAdapter : public InputAdapter
     int GetMouseY();
     void ProcessInputs();
     bool CheckInputOccurred(InputType::Type inputType, int button = 0);
+    const std::vector<std::pair<InputType::Type, int>>& GetOccurredInputs();
 
   private:
     // Registers that a type of input occurred.
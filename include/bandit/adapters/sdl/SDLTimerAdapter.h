@@ -3,8 +3,14 @@
 #ifndef SDL_TIMER_ADAPTER_H_
 #define SDL_TIMER_ADAPTER_H_
 
+#include <cerrno>
+#include <ctime>
 #include <iostream>
 
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
 #include <SDL.h>
 
 #include "bandit/adapters/TimerAdapter.h"
@@ -14,12 +20,19 @@ class SDLTimerAdapter : public TimerAdapter
   public:
     SDLTimerAdapter();
     ~SDLTimerAdapter();
+    double GetTime();
     float GetElapsedTime();
+
+    // Sleeps with nanosecond resolution where POSIX clocks are available,
+    // and millisecond resolution otherwise.
     void Sleep(float seconds);
 
   private:
-    // Stores the ticks counting for the last calling of GetElapsedTime.
-    unsigned int previousTicks;
+    // Stores the time of the last calling of GetElapsedTime.
+    double previousTime;
+
+    // Seconds per tick of the performance counter.
+    double counterPeriod;
 };
 
 #endif // SDL_TIMER_ADAPTER_H_
\ No newline at end of file
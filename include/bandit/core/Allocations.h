@@ -0,0 +1,25 @@
+// Counting of the allocations made by the program.
+//
+// Counting is opt-in: when the program is built with BANDIT_COUNT_ALLOCATIONS
+// defined, as the benchmark suite is, the engine replaces the global operator
+// new, and its array form, with ones allocating with malloc and counting each
+// call, so the count includes every allocation made through them, the
+// standard library's as well. Code expected not to allocate, such as spawning
+// entities once their storages have grown, can then be checked by comparing
+// the count before and after. Other builds keep the standard allocator and
+// count nothing.
+
+#ifndef ALLOCATIONS_H_
+#define ALLOCATIONS_H_
+
+namespace Allocations
+{
+    // Checks whether this build counts allocations.
+    bool IsCounting();
+
+    // Gets the number of allocations made since the program started, or 0
+    // when this build does not count them.
+    unsigned long GetNumberOfAllocations();
+}
+
+#endif // ALLOCATIONS_H_
\ No newline at end of file
@@ -3,13 +3,34 @@
 // Logs can be generated in four different levels: debug, info, warning and
 // error. A log level is set to configure the minimum level that will be
 // displayed on screen.
+//
+// Levels below LOG_MIN_LEVEL are removed at compile time, costing nothing, not
+// even the level check. Release builds remove debug logs unless LOG_MIN_LEVEL
+// is defined otherwise, from 0 (debug) to 3 (error).
+//
+// Messages are formatted by the thread logging them into fixed-size records,
+// with no allocations, and queued. A thread of its own writes the queued
+// records out in batches, so logging never waits for the output. When the
+// queue is full, debug and info logs are dropped and counted, while warnings
+// and errors wait for room. Errors are written out before logging returns, so
+// they are never lost when the program exits right after.
 
 #ifndef LOG_H_
 #define LOG_H_
 
 #include <iostream>
+#include <ostream>
+#include <streambuf>
 #include <string>
 
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
 // Configures to display logs with level higher or equal to the given one.
 #define LOG_SET_DEBUG() Log::SetLevel(Log::Debug)
 #define LOG_SET_INFO() Log::SetLevel(Log::Info)
@@ -19,11 +40,10 @@
 // Outputs a log message if it's level is high enough.
 #define LOG(level, message) \
     do { \
-        if (level >= Log::GetLevel()) { \
-            Log::GetStream() \
-            << Log::GetPrefix(level) \
-            << message \
-            << Log::GetSufix(); \
+        if (level >= LOG_MIN_LEVEL && level >= Log::GetLevel()) { \
+            LogMessage logMessage(level); \
+            logMessage.GetStream() << message; \
+            Log::Write(logMessage.GetRecord()); \
         } \
     } while (false)
 
@@ -39,6 +59,8 @@
 // Outputs error log message.
 #define LOG_E(message) LOG(Log::Error, message)
 
+struct LogRecord;
+
 class Log
 {
   public:
@@ -58,6 +80,12 @@ class Log
     // Gets the stream where messages will be displayed.
     static std::ostream& GetStream();
 
+    // Queues a record to be written out.
+    static void Write(const LogRecord& record);
+
+    // Waits until all records queued so far are written out.
+    static void Flush();
+
     // Maps log levels to strings for printing purposes.
     static std::string GetLevelString(LogLevel level);
 
@@ -70,9 +98,38 @@ class Log
     // Formats a sufix for the log message.
     static std::string GetSufix();
 
+    // Longest message a record holds, in characters.
+    static const unsigned int MAX_MESSAGE_LENGTH = 240;
+
   private:
     // Current log level.
     static LogLevel level;
 };
 
+// Log message formatted and waiting to be written out.
+struct LogRecord
+{
+    Log::LogLevel level;
+
+    // Whether the message was longer than the record holds.
+    bool truncated;
+
+    unsigned int length;
+    char text[Log::MAX_MESSAGE_LENGTH];
+};
+
+// Formats a log message into a record, truncating messages too long for it.
+class LogMessage : private std::streambuf
+{
+  public:
+    explicit LogMessage(Log::LogLevel level);
+
+    std::ostream& GetStream();
+    const LogRecord& GetRecord();
+
+  private:
+    LogRecord record;
+    std::ostream stream;
+};
+
 #endif // LOG_H_
\ No newline at end of file
@@ -0,0 +1,130 @@
+// First-in first-out queue stored in a circular array, which many threads can
+// push items into and a single thread pops items from, without locks.
+//
+// Unlike RingBuffer, the capacity is fixed, so pushing fails when the buffer
+// is full. Each slot carries a sequence number telling whether it is free to
+// be written or holds an item ready to be read: producers claim slots by
+// advancing the shared tail and publish them by updating their sequence, so
+// the consumer never reads an item still being copied.
+
+#ifndef MPSC_RING_BUFFER_H_
+#define MPSC_RING_BUFFER_H_
+
+#include <atomic>
+#include <memory>
+
+template <typename T>
+class MpscRingBuffer
+{
+  public:
+    // Creates a buffer able to hold the given number of items, rounded up to
+    // a power of two.
+    explicit MpscRingBuffer(unsigned int capacity);
+
+    // Adds an item after the last one. Returns false if the buffer is full.
+    // Safe to call from any number of threads at the same time.
+    bool Push(const T& item);
+
+    // Removes the first item. Returns false if the buffer is empty or the
+    // first item is still being pushed. Must only be called by one thread.
+    bool Pop(T& item);
+
+    // Gets the number of items pushed so far, including the ones still being
+    // copied.
+    unsigned long GetNumberOfPushes();
+
+    unsigned int GetCapacity();
+
+  private:
+    struct Slot
+    {
+        std::atomic<unsigned long> sequence;
+        T item;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    unsigned int mask;
+
+    std::atomic<unsigned long> tail;
+    unsigned long head;
+};
+
+template <typename T>
+MpscRingBuffer<T>::MpscRingBuffer(unsigned int capacity) :
+    tail(0), head(0)
+{
+    unsigned int powerOfTwo = 1;
+
+    while (powerOfTwo < capacity)
+        powerOfTwo *= 2;
+
+    slots.reset(new Slot[powerOfTwo]);
+    mask = powerOfTwo - 1;
+
+    for (unsigned int i = 0; i < powerOfTwo; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::Push(const T& item)
+{
+    unsigned long position = tail.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true)
+    {
+        slot = &slots[position & mask];
+        unsigned long sequence = slot->sequence.load(std::memory_order_acquire);
+        long difference = static_cast<long>(sequence - position);
+
+        // The slot is free for this position, unless another producer claims
+        // it first.
+        if (difference == 0)
+        {
+            if (tail.compare_exchange_weak(position, position + 1,
+                std::memory_order_relaxed))
+                break;
+        }
+        // The slot still holds the item pushed a lap earlier.
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->item = item;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::Pop(T& item)
+{
+    Slot& slot = slots[head & mask];
+
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+        return false;
+
+    item = slot.item;
+    slot.sequence.store(head + mask + 1, std::memory_order_release);
+    ++head;
+    return true;
+}
+
+template <typename T>
+unsigned long MpscRingBuffer<T>::GetNumberOfPushes()
+{
+    return tail.load(std::memory_order_acquire);
+}
+
+template <typename T>
+unsigned int MpscRingBuffer<T>::GetCapacity()
+{
+    return mask + 1;
+}
+
+#endif // MPSC_RING_BUFFER_H_
\ No newline at end of file
@@ -1,19 +1,52 @@
 // Random number generation methods.
+//
+// Numbers are drawn from xoshiro128** generators, each of them an independent
+// stream derived from a single global seed, so a run can be reproduced by
+// setting the same seed again. Generators hold their own state and are cheap
+// to create, so they can be used by several threads at the same time as long
+// as each one uses its own generator.
+//
+// Systems updated by other threads, or in parallel with other systems, should
+// keep streams named after them, which don't depend on the thread running
+// them. Default constructed generators branch off the stream of the calling
+// thread, and are meant for code running in the main thread.
 
 #ifndef RANDOM_H_
 #define RANDOM_H_
 
-#include <ctime>
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <string>
 
 #include "bandit/core/Log.h"
 
 class Random
 {
   public:
+    // Creates a stream branching off the stream of the calling thread.
     Random();
 
-    // Generates random integer from 0 to RAND_MAX (at least 32767).
+    // Creates the stream with the given name or ID, and optionally one of
+    // its substreams, such as one per frame or per job.
+    explicit Random(const std::string& stream, uint64_t substream = 0);
+    explicit Random(uint64_t stream, uint64_t substream = 0);
+
+    // Sets the seed every stream is derived from. Streams created before
+    // keep their state, except for the ones of the threads.
+    static void SetSeed(uint64_t seed);
+    static uint64_t GetSeed();
+
+    // Gets the ID of the stream with the given name.
+    static uint64_t GetStreamId(const std::string& stream);
+
+    // Gets the stream of the calling thread.
+    static Random& GetThreadInstance();
+
+    // Generates 32 random bits.
+    uint32_t GenerateBits();
+
+    // Generates random integer from 0 to 2^31 - 1.
     int GenerateInt();
 
     // Generates random integer from minimum to maximum values, not inclusive.
@@ -26,8 +59,28 @@ class Random
     // inclusive.
     float GenerateFloat(float min, float max);
 
+    // Fills an array with random real numbers from minimum to maximum values,
+    // not inclusive.
+    void GenerateFloats(float* values, unsigned int count, float min,
+        float max);
+
   private:
-    void SeedRandomNumberGenerator();
+    // Fills the state from a 64-bit value, using splitmix64 as recommended by
+    // the authors of xoshiro.
+    void Seed(uint64_t value);
+
+    static uint64_t MixStream(uint64_t stream, uint64_t substream);
+
+    uint32_t state[4];
+
+    static std::atomic<uint64_t> seed;
+
+    // Increased each time the seed is set, so threads know their streams are
+    // out of date.
+    static std::atomic<unsigned int> seedVersion;
+
+    // Number of threads that created their streams.
+    static std::atomic<unsigned int> numberOfThreads;
 };
 
 #endif // RANDOM_H_
\ No newline at end of file
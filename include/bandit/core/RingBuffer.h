@@ -0,0 +1,116 @@
+// First-in first-out queue stored in a circular array.
+//
+// Items are copied into a single array that wraps around, so once the buffer
+// has grown to the largest number of items queued at the same time, pushing
+// and popping items makes no calls to the global allocator. The buffer grows
+// instead of dropping items when full.
+
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+
+#include <vector>
+
+template <typename T>
+class RingBuffer
+{
+  public:
+    // Creates a buffer able to hold the given number of items, rounded up to
+    // a power of two, before growing.
+    explicit RingBuffer(unsigned int capacity = 64);
+
+    // Adds an item after the last one, growing the buffer if necessary.
+    void Push(const T& item);
+
+    // Removes the first item. Returns false if the buffer is empty.
+    bool Pop(T& item);
+
+    // Removes all items, keeping the capacity.
+    void Clear();
+
+    unsigned int GetSize();
+    unsigned int GetCapacity();
+    bool IsEmpty();
+
+  private:
+    // Doubles the capacity, moving the items to the start of the array.
+    void Grow();
+
+    std::vector<T> items;
+
+    // Index of the first item and number of items.
+    unsigned int head;
+    unsigned int size;
+};
+
+template <typename T>
+RingBuffer<T>::RingBuffer(unsigned int capacity) :
+    head(0), size(0)
+{
+    unsigned int powerOfTwo = 1;
+
+    while (powerOfTwo < capacity)
+        powerOfTwo *= 2;
+
+    items.resize(powerOfTwo);
+}
+
+template <typename T>
+void RingBuffer<T>::Push(const T& item)
+{
+    if (size == items.size())
+        Grow();
+
+    items[(head + size) & (items.size() - 1)] = item;
+    ++size;
+}
+
+template <typename T>
+bool RingBuffer<T>::Pop(T& item)
+{
+    if (size == 0)
+        return false;
+
+    item = items[head];
+    head = (head + 1) & (items.size() - 1);
+    --size;
+    return true;
+}
+
+template <typename T>
+void RingBuffer<T>::Clear()
+{
+    head = 0;
+    size = 0;
+}
+
+template <typename T>
+unsigned int RingBuffer<T>::GetSize()
+{
+    return size;
+}
+
+template <typename T>
+unsigned int RingBuffer<T>::GetCapacity()
+{
+    return items.size();
+}
+
+template <typename T>
+bool RingBuffer<T>::IsEmpty()
+{
+    return (size == 0);
+}
+
+template <typename T>
+void RingBuffer<T>::Grow()
+{
+    std::vector<T> grownItems(items.size()*2);
+
+    for (unsigned int i = 0; i < size; ++i)
+        grownItems[i] = items[(head + i) & (items.size() - 1)];
+
+    items.swap(grownItems);
+    head = 0;
+}
+
+#endif // RING_BUFFER_H_
\ No newline at end of file
@@ -19,13 +19,26 @@
 // 
 // # Background image for level 1
 // BACKGROUND = /resources/img/ocean.jpg
+//
+// Values read often, such as the ones read for every entity on every frame,
+// are better read through handles (CfgInt, CfgFloat, CfgBool, CfgString and
+// CfgPath, the counterpart of CFG_GETP) than by key. Handles convert their value once, when the configuration is
+// parsed or their key is set, so reading them costs a single load, and a
+// missing key or malformed value is reported as soon as the configuration is
+// parsed rather than on first use.
 
 #ifndef CONFIG_PARSER_H_
 #define CONFIG_PARSER_H_
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <unordered_map>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "bandit/adapters/File.h"
 #include "bandit/core/Log.h"
@@ -70,6 +83,8 @@
 #define CFG_PRINT() \
     ConfigParser::GetInstance().Print();
 
+class BaseConfigHandle;
+
 class ConfigParser : public Parser
 {
   public:
@@ -86,6 +101,9 @@ class ConfigParser : public Parser
     // the path.
     std::string GetWithPath(std::string key);
 
+    // Prepends the path to a value, exiting when no path has been set.
+    std::string PrependPath(std::string value);
+
     // Gets single configuration value for a given key, automatically converting
     // to an integer value.
     int GetAsInteger(std::string key);
@@ -102,13 +120,38 @@ class ConfigParser : public Parser
     // to a boolean value.
     bool GetAsBool(std::string key);
 
+    // Gets all configuration key, value pairs, sorted by key.
+    std::vector<std::pair<std::string, std::string>> GetEntries();
+
+    // Sets the value of a key, whether it already exists or not.
+    void Set(std::string key, std::string value);
+
+    // Gets a number changed every time the configuration is parsed or a key
+    // set, so values derived from the configuration can tell when to derive
+    // them again.
+    unsigned int GetRevision();
+
     // Prints configuration key, value pairs
     void Print();
 
+    // Registers a handle, resolving it right away if the configuration has
+    // already been parsed.
+    void Register(BaseConfigHandle* handle);
+
+    // Converts the value of a key, exiting when it is malformed.
+    static void Convert(const std::string& key, const std::string& value,
+        int& result);
+    static void Convert(const std::string& key, const std::string& value,
+        float& result);
+    static void Convert(const std::string& key, const std::string& value,
+        bool& result);
+    static void Convert(const std::string& key, const std::string& value,
+        std::string& result);
+
   private:
     // Singleton pattern using the approach suggested at
     // http://stackoverflow.com/questions/1008019/c-singleton-design-pattern
-    ConfigParser() {};
+    ConfigParser() : parsed(false), revision(0) {};
     ConfigParser(const ConfigParser&) = delete;
     void operator=(const ConfigParser&) = delete;
 
@@ -137,11 +180,89 @@ class ConfigParser : public Parser
     // Gets single configuration value for a given key.
     std::string operator[](std::string key);
 
+    // Converts the value of the handle key into the handle.
+    void Resolve(BaseConfigHandle* handle);
+
     // Map to hold configuration entries.
     std::unordered_map<std::string, std::string> configurationMap;
 
+    // Handles registered so far and whether the configuration has been
+    // parsed, after which handles are resolved as soon as they register.
+    std::vector<BaseConfigHandle*> handles;
+    bool parsed;
+
+    // Number of times the configuration has been parsed or a key set.
+    unsigned int revision;
+
     // Path for file handling.
     std::string path;
 };
 
+// Handle to the value of a configuration key. Handles register themselves
+// when created and must live as long as the program, so they are meant to be
+// static members of the classes reading them.
+class BaseConfigHandle
+{
+  public:
+    explicit BaseConfigHandle(const char* key) : key(key) {}
+    virtual ~BaseConfigHandle() {}
+
+    const char* GetKey() const { return key; }
+
+    // Converts and stores the value of the key.
+    virtual void Resolve(const std::string& value) = 0;
+
+  private:
+    const char* key;
+};
+
+template <typename T>
+class ConfigHandle : public BaseConfigHandle
+{
+  public:
+    explicit ConfigHandle(const char* key);
+
+    // Gets the value of the key when the configuration was last parsed or the
+    // key last set.
+    T Get() const { return value; }
+
+    void Resolve(const std::string& value);
+
+  private:
+    T value;
+};
+
+typedef ConfigHandle<int> CfgInt;
+typedef ConfigHandle<float> CfgFloat;
+typedef ConfigHandle<bool> CfgBool;
+typedef ConfigHandle<std::string> CfgString;
+
+// Handle to the value of a configuration key with the path prepended, as
+// read by CFG_GETP. It is resolved again whenever the path is set.
+class CfgPath : public BaseConfigHandle
+{
+  public:
+    explicit CfgPath(const char* key);
+
+    std::string Get() const { return value; }
+
+    void Resolve(const std::string& value);
+
+  private:
+    std::string value;
+};
+
+template <typename T>
+ConfigHandle<T>::ConfigHandle(const char* key) :
+    BaseConfigHandle(key), value()
+{
+    ConfigParser::GetInstance().Register(this);
+}
+
+template <typename T>
+void ConfigHandle<T>::Resolve(const std::string& value)
+{
+    ConfigParser::Convert(GetKey(), value, this->value);
+}
+
 #endif // CONFIG_PARSER_H_
\ No newline at end of file
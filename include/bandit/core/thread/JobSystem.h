@@ -0,0 +1,182 @@
+// Work-stealing job system spreading work over all hardware threads.
+//
+// Each worker thread owns a queue of jobs. Workers run the most recent jobs of
+// their own queue first and, once it is empty, steal the oldest jobs from the
+// other queues. Jobs submitted by other threads go to a queue of their own,
+// which every worker steals from. Threads waiting for jobs to finish run
+// pending jobs meanwhile, so jobs may submit and wait for other jobs without
+// blocking workers, and a job system without workers still runs every job in
+// the waiting thread.
+
+#ifndef JOB_SYSTEM_H_
+#define JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bandit/core/Log.h"
+
+// Set of jobs that are waited for together.
+class JobGroup
+{
+  public:
+    JobGroup() : numberOfPendingJobs(0) {}
+
+  private:
+    friend class JobSystem;
+
+    JobGroup(const JobGroup&) = delete;
+    void operator=(const JobGroup&) = delete;
+
+    std::atomic<unsigned int> numberOfPendingJobs;
+};
+
+// Tasks with dependencies between them, run by JobSystem::Run. Tasks only
+// depend on tasks added before them, so graphs never have cycles. A graph can
+// be run again as many times as needed.
+class TaskGraph
+{
+  public:
+    // Adds a task and returns its index in the graph.
+    unsigned int AddTask(std::function<void()> function);
+
+    // Makes a task start only after another one, added before it, finished.
+    void AddDependency(unsigned int task, unsigned int dependency);
+
+    unsigned int GetNumberOfTasks();
+    void Clear();
+
+  private:
+    friend class JobSystem;
+
+    struct Task
+    {
+        std::function<void()> function;
+
+        // Tasks that depend on this one.
+        std::vector<unsigned int> successors;
+
+        unsigned int numberOfDependencies;
+    };
+
+    std::vector<Task> tasks;
+};
+
+class JobSystem
+{
+  public:
+    // Starts the given number of worker threads.
+    explicit JobSystem(unsigned int numberOfWorkers);
+
+    // Waits for every job submitted and stops the workers.
+    ~JobSystem();
+
+    // Submits a job to be run by any thread as part of a group.
+    void Run(JobGroup& group, std::function<void()> job);
+
+    // Blocks until every job of the group has finished, running pending jobs
+    // meanwhile.
+    void Wait(JobGroup& group);
+
+    // Runs a task graph and blocks until all of its tasks have finished.
+    void Run(TaskGraph& graph);
+
+    // Splits the range [0, size) into chunks of grainSize indices and calls
+    // function(first, last) for each chunk, with last not inclusive. Chunks
+    // run at the same time in any order, and the call blocks until all of them
+    // have finished. The chunks are the same whatever the number of workers,
+    // and run one after another when there are none.
+    template <typename Function>
+    void ParallelFor(unsigned int size, unsigned int grainSize,
+        Function function);
+
+    // Gets the number of threads running jobs, counting the calling one.
+    unsigned int GetNumberOfThreads();
+
+    // Gets the number of workers that fully uses the hardware threads,
+    // leaving one for the thread that submits jobs.
+    static unsigned int GetDefaultNumberOfWorkers();
+
+  private:
+    JobSystem(const JobSystem&) = delete;
+    void operator=(const JobSystem&) = delete;
+
+    struct Job
+    {
+        std::function<void()> function;
+        JobGroup* group;
+    };
+
+    struct JobQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // Gets the queue owned by the calling thread. The first queue belongs to
+    // all threads other than the workers.
+    unsigned int GetQueueIndex();
+
+    // Takes a job from a queue, newest first when the queue is owned by the
+    // calling thread and oldest first otherwise.
+    bool PopJob(unsigned int queueIndex, bool owned, Job& job);
+
+    // Takes a job from the queue of the calling thread or steals one from the
+    // other queues.
+    bool FindJob(Job& job);
+
+    void RunJob(Job& job);
+    void RunWorker(unsigned int queueIndex);
+
+    // Runs a task of a graph and submits the successors it has unblocked.
+    void RunTask(TaskGraph& graph, unsigned int task,
+        std::atomic<unsigned int>* numberOfPendingDependencies,
+        JobGroup& group);
+
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::vector<std::thread> workers;
+
+    // Number of jobs in all queues, used to put idle workers to sleep.
+    std::atomic<unsigned int> numberOfQueuedJobs;
+    bool stopped;
+    std::mutex sleepMutex;
+    std::condition_variable jobAvailable;
+};
+
+template <typename Function>
+void JobSystem::ParallelFor(unsigned int size, unsigned int grainSize,
+    Function function)
+{
+    if (grainSize == 0)
+        grainSize = 1;
+
+    // Callers may key work by chunk, such as random substreams, so chunks
+    // are kept even without workers.
+    if (size <= grainSize || workers.empty())
+    {
+        for (unsigned int first = 0; first < size; first += grainSize)
+            function(first, (size - first > grainSize) ? first + grainSize : size);
+
+        return;
+    }
+
+    JobGroup group;
+
+    for (unsigned int first = grainSize; first < size; first += grainSize)
+    {
+        unsigned int last = (size - first > grainSize) ? first + grainSize : size;
+        Run(group, [&function, first, last]() { function(first, last); });
+    }
+
+    // The calling thread takes the first chunk instead of just waiting.
+    function(0, grainSize);
+    Wait(group);
+}
+
+#endif // JOB_SYSTEM_H_
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Paces frames to a target frame rate and keeps statistics of frame times.
+//
+// Frames are scheduled at fixed deadlines rather than by sleeping a fixed
+// amount after each frame, so errors don't accumulate. The pacer sleeps until
+// shortly before the deadline, since sleeping may overshoot it, and spins
+// through the rest. Frames running late start the schedule over instead of
+// rushing to catch up.
+
+#ifndef FRAME_PACER_H_
+#define FRAME_PACER_H_
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bandit/adapters/TimerAdapter.h"
+
+// Statistics of the latest frame times, in seconds.
+struct FrameStats
+{
+    float minimum;
+    float average;
+    float percentile99;
+};
+
+class FramePacer
+{
+  public:
+    explicit FramePacer(std::shared_ptr<TimerAdapter> timerAdapter);
+
+    // Sets the number of frames per second to pace to. Zero leaves frames
+    // uncapped.
+    void SetTargetFrameRate(float frameRate);
+    float GetTargetFrameRate();
+
+    // Starts pacing from now on.
+    void Start();
+
+    // Marks the beginning of a frame. Returns the time elapsed since the
+    // beginning of the previous frame, in seconds.
+    float BeginFrame();
+
+    // Waits until the next frame is due.
+    void EndFrame();
+
+    // Gets statistics of the latest frame times.
+    FrameStats GetStats();
+
+  private:
+    // Time left before a deadline when the pacer stops sleeping and starts
+    // spinning, in seconds.
+    static const float SPIN_DURATION;
+
+    // Number of latest frame times kept for statistics.
+    static const unsigned int NUMBER_OF_SAMPLES = 120;
+
+    std::shared_ptr<TimerAdapter> timerAdapter;
+    float framePeriod;
+
+    double frameStart;
+    double deadline;
+
+    // Latest frame times, in a circular buffer.
+    std::vector<float> frameTimes;
+    unsigned int nextSample;
+};
+
+#endif // FRAME_PACER_H_
\ No newline at end of file
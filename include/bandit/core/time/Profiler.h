@@ -0,0 +1,187 @@
+// Times zones of code, such as system updates and engine phases, keeping
+// statistics of the latest durations of each zone and, optionally, a trace of
+// every zone that can be opened in Chrome's trace viewer.
+//
+// Zones are timed by scope with PROFILE_ZONE. Each thread records its zones
+// into a buffer of its own, with no locks, and the main thread collects all
+// buffers once per frame. Zones finishing while a buffer is full are dropped.
+// Zone names must outlive the profiler, so they are either string literals or
+// names interned by the profiler. While the profiler is disabled, zones cost a
+// single check.
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bandit/core/Log.h"
+
+#define PROFILE_CONCATENATE_(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_(a, b)
+
+// Times the rest of the enclosing scope as a zone with the given name.
+#define PROFILE_ZONE(name) \
+    ProfileZone PROFILE_CONCATENATE(profileZone, __LINE__)(name)
+
+// Statistics of the latest durations of a zone, in seconds.
+struct ZoneStats
+{
+    const char* name;
+    float average;
+    float percentile95;
+    float maximum;
+};
+
+class Profiler
+{
+  public:
+    static Profiler& GetInstance();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // Gets a copy of the name that lives as long as the profiler. Interning
+    // the same name again returns the same copy.
+    const char* Intern(const std::string& name);
+
+    // Gets the time elapsed since the profiler was created, in nanoseconds.
+    uint64_t GetTime();
+
+    // Records a zone of the calling thread, with its start and end times.
+    void Record(const char* name, uint64_t start, uint64_t end);
+
+    // Collects the zones recorded by all threads so far. Meant to be called
+    // once per frame by the main thread.
+    void Collect();
+
+    // Gets statistics of the zones collected, from the slowest on average to
+    // the fastest.
+    std::vector<ZoneStats> GetZoneStats();
+
+    // Gets the number of zones dropped because their buffer was full.
+    unsigned long GetNumberOfDroppedZones();
+
+    // Starts keeping every zone collected for the trace, up to the given
+    // number of zones.
+    void StartTrace(unsigned int maxZones);
+
+    // Writes the trace kept so far to a file in Chrome's trace event format.
+    void WriteTrace(std::string file);
+
+  private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    struct Zone
+    {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    // Zones of a single thread, in a circular array of fixed capacity. The
+    // thread pushes zones and the main thread pops them at the same time, so
+    // each index is only written by one of them.
+    class Buffer
+    {
+      public:
+        Buffer();
+
+        // Adds a zone. Returns false if the buffer is full.
+        bool Push(const Zone& zone);
+
+        // Removes the oldest zone. Returns false if the buffer is empty.
+        bool Pop(Zone& zone);
+
+      private:
+        static const unsigned int CAPACITY = 4096;
+
+        std::vector<Zone> zones;
+        std::atomic<unsigned int> head;
+        std::atomic<unsigned int> tail;
+    };
+
+    // Latest durations of a zone, in a circular array.
+    struct Samples
+    {
+        Samples() : next(0) {}
+
+        std::vector<float> durations;
+        unsigned int next;
+    };
+
+    // Zone kept for the trace, along with the thread it was recorded by.
+    struct TraceZone
+    {
+        Zone zone;
+        unsigned int thread;
+    };
+
+    // Number of latest durations kept per zone for statistics.
+    static const unsigned int NUMBER_OF_SAMPLES = 120;
+
+    // Gets the buffer of the calling thread, creating it on first use.
+    Buffer& GetBuffer();
+
+    std::atomic<bool> enabled;
+    std::chrono::steady_clock::time_point epoch;
+    std::atomic<unsigned long> numberOfDroppedZones;
+
+    // Buffers of all threads that ever recorded a zone, in the order they did.
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::mutex buffersMutex;
+
+    std::set<std::string> names;
+    std::mutex namesMutex;
+
+    std::unordered_map<const char*, Samples> samples;
+
+    std::vector<TraceZone> trace;
+    unsigned int maxTraceZones;
+};
+
+// Times its own lifetime as a zone.
+class ProfileZone
+{
+  public:
+    explicit ProfileZone(const char* name);
+    ~ProfileZone();
+
+  private:
+    const char* name;
+    uint64_t start;
+    bool active;
+};
+
+inline bool Profiler::IsEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+inline ProfileZone::ProfileZone(const char* name) :
+    name(name), start(0), active(Profiler::GetInstance().IsEnabled())
+{
+    if (active)
+        start = Profiler::GetInstance().GetTime();
+}
+
+inline ProfileZone::~ProfileZone()
+{
+    if (active)
+        Profiler::GetInstance().Record(name, start,
+            Profiler::GetInstance().GetTime());
+}
+
+#endif // PROFILER_H_
\ No newline at end of file
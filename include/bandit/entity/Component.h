@@ -15,6 +15,11 @@ class Component
 
     // Allows components to be identified.
     virtual std::string GetComponentClass() = 0;
+
+    // Called once the component is constructed inside the storage of its
+    // class by EntityManager::CreateComponent, unlike prototypes and other
+    // components living elsewhere.
+    virtual void OnStored() {}
 };
 
 #endif // COMPONENT_H_
\ No newline at end of file
@@ -0,0 +1,342 @@
+// Contiguous storage for components of a single class.
+//
+// Components are constructed in place inside fixed-size chunks of memory, so
+// iterating over all components of a class is a linear scan instead of
+// chasing one heap pointer per component. Chunks are never moved, which keeps
+// pointers held by systems valid, and slots released by destroyed components
+// are reused by the next ones created.
+//
+// Components never move, so chunks are not compacted: released slots stay as
+// holes until reused. Iterating tests every slot of the chunks holding at
+// least one component and skips empty chunks at once, so after many
+// components are destroyed it still costs the slots of the chunks left partly
+// used, up to the peak number of components.
+//
+// Components are handed out as shared pointers, as any other component, and
+// their slot is released when the last reference is dropped. The control
+// blocks of these shared pointers are pooled by the storage as well, so once
+// the storage has grown to the number of components alive at the same time,
+// creating and destroying components makes no calls to the global allocator.
+// Each component keeps its storage alive, so a storage never outlives its
+// components.
+
+#ifndef COMPONENT_STORAGE_H_
+#define COMPONENT_STORAGE_H_
+
+#include <bitset>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class BaseComponentStorage
+{
+  public:
+    virtual ~BaseComponentStorage() {}
+
+    // Gets the number of components currently alive in the storage.
+    virtual unsigned int GetSize() = 0;
+
+    // Gets the number of components the storage can hold without allocating a
+    // new chunk.
+    virtual unsigned int GetCapacity() = 0;
+
+    // Gets the number of components created since the storage was created.
+    virtual unsigned int GetNumberOfCreations() = 0;
+
+    // Gets the number of times the storage requested memory from the global
+    // allocator.
+    virtual unsigned int GetNumberOfAllocations() = 0;
+};
+
+template <typename T>
+class ComponentStorage : public BaseComponentStorage,
+    public std::enable_shared_from_this<ComponentStorage<T>>
+{
+  public:
+    // Number of components held by a single chunk.
+    static const unsigned int CHUNK_SIZE = 256;
+
+    ComponentStorage();
+
+    // Constructs a component in the first free slot, forwarding the arguments
+    // to its constructor, and lets it know through OnStored.
+    template <typename... Args>
+    std::shared_ptr<T> Create(Args&&... args);
+
+    // Calls the function for each component alive, in memory order.
+    template <typename Function>
+    void ForEach(Function function);
+
+    // Calls the function for each component alive in the slots from first to
+    // last, not inclusive. Disjoint ranges can be processed at the same time.
+    template <typename Function>
+    void ForEach(unsigned int firstSlot, unsigned int lastSlot,
+        Function function);
+
+    // Gets the number of slots ever used, alive or not, which bounds the slot
+    // ranges given to ForEach.
+    unsigned int GetNumberOfSlots();
+
+    unsigned int GetSize();
+    unsigned int GetCapacity();
+    unsigned int GetNumberOfCreations();
+    unsigned int GetNumberOfAllocations();
+
+  private:
+    struct Chunk
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type
+            slots[CHUNK_SIZE];
+
+        // Flags which slots hold a constructed component.
+        std::bitset<CHUNK_SIZE> used;
+    };
+
+    // Allocator of shared pointer control blocks, which draws memory from the
+    // storage. Each control block holds a copy of it, keeping the storage
+    // alive until the control block itself is deallocated.
+    template <typename U>
+    class ControlBlockAllocator
+    {
+      public:
+        typedef U value_type;
+
+        template <typename V>
+        struct rebind
+        {
+            typedef ControlBlockAllocator<V> other;
+        };
+
+        ControlBlockAllocator(std::shared_ptr<ComponentStorage<T>> storage) :
+            storage(storage)
+        {
+        }
+
+        template <typename V>
+        ControlBlockAllocator(const ControlBlockAllocator<V>& other) :
+            storage(other.storage)
+        {
+        }
+
+        U* allocate(std::size_t n)
+        {
+            return static_cast<U*>(storage->AllocateBlock(n*sizeof(U)));
+        }
+
+        void deallocate(U* block, std::size_t n)
+        {
+            storage->DeallocateBlock(block, n*sizeof(U));
+        }
+
+        template <typename V>
+        bool operator==(const ControlBlockAllocator<V>& other) const
+        {
+            return (storage == other.storage);
+        }
+
+        template <typename V>
+        bool operator!=(const ControlBlockAllocator<V>& other) const
+        {
+            return (storage != other.storage);
+        }
+
+        std::shared_ptr<ComponentStorage<T>> storage;
+    };
+
+    // Gets the memory of a slot given its index in the storage.
+    T* GetSlot(unsigned int slot);
+
+    // Destructs the component in a slot and makes it available again.
+    void Destroy(unsigned int slot);
+
+    // Gets memory for a control block, reusing released blocks. All control
+    // blocks of a storage have the same size, which is only known once the
+    // first one is allocated.
+    void* AllocateBlock(std::size_t size);
+    void DeallocateBlock(void* block, std::size_t size);
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+
+    // Indices of released slots, reused before growing the storage.
+    std::vector<unsigned int> freeSlots;
+
+    // Number of slots ever handed out, including released ones.
+    unsigned int highWaterMark;
+
+    // Number of components alive.
+    unsigned int size;
+
+    // Memory for control blocks, allocated CHUNK_SIZE blocks at a time, and
+    // the blocks available for reuse.
+    std::vector<std::unique_ptr<char[]>> blockChunks;
+    std::vector<void*> freeBlocks;
+    std::size_t blockSize;
+
+    unsigned int numberOfCreations;
+    unsigned int numberOfAllocations;
+};
+
+template <typename T>
+ComponentStorage<T>::ComponentStorage() :
+    highWaterMark(0), size(0), blockSize(0), numberOfCreations(0),
+    numberOfAllocations(0)
+{
+}
+
+template <typename T>
+template <typename... Args>
+std::shared_ptr<T> ComponentStorage<T>::Create(Args&&... args)
+{
+    unsigned int slot;
+
+    if (freeSlots.empty())
+    {
+        if (highWaterMark == chunks.size()*CHUNK_SIZE)
+        {
+            chunks.push_back(std::unique_ptr<Chunk>(new Chunk()));
+            ++numberOfAllocations;
+        }
+
+        slot = highWaterMark;
+        ++highWaterMark;
+    }
+    else
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    T* component = new (GetSlot(slot)) T(std::forward<Args>(args)...);
+    chunks[slot/CHUNK_SIZE]->used.set(slot%CHUNK_SIZE);
+    ++size;
+    ++numberOfCreations;
+    component->OnStored();
+
+    // The deleter doesn't need to keep the storage alive, since the allocator
+    // stored along with it in the control block already does.
+    ComponentStorage<T>* storage = this;
+    return std::shared_ptr<T>(component,
+        [storage, slot](T*) { storage->Destroy(slot); },
+        ControlBlockAllocator<T>(this->shared_from_this()));
+}
+
+template <typename T>
+template <typename Function>
+void ComponentStorage<T>::ForEach(Function function)
+{
+    ForEach(0, highWaterMark, function);
+}
+
+template <typename T>
+template <typename Function>
+void ComponentStorage<T>::ForEach(unsigned int firstSlot,
+    unsigned int lastSlot, Function function)
+{
+    unsigned int slot = firstSlot;
+
+    while (slot < lastSlot)
+    {
+        const Chunk& chunk = *chunks[slot/CHUNK_SIZE];
+
+        // Chunks left empty are skipped without testing each slot.
+        if (chunk.used.none())
+        {
+            slot = (slot/CHUNK_SIZE + 1)*CHUNK_SIZE;
+            continue;
+        }
+
+        if (chunk.used.test(slot%CHUNK_SIZE))
+            function(*GetSlot(slot));
+
+        ++slot;
+    }
+}
+
+template <typename T>
+unsigned int ComponentStorage<T>::GetNumberOfSlots()
+{
+    return highWaterMark;
+}
+
+template <typename T>
+unsigned int ComponentStorage<T>::GetSize()
+{
+    return size;
+}
+
+template <typename T>
+unsigned int ComponentStorage<T>::GetCapacity()
+{
+    return chunks.size()*CHUNK_SIZE;
+}
+
+template <typename T>
+unsigned int ComponentStorage<T>::GetNumberOfCreations()
+{
+    return numberOfCreations;
+}
+
+template <typename T>
+unsigned int ComponentStorage<T>::GetNumberOfAllocations()
+{
+    return numberOfAllocations;
+}
+
+template <typename T>
+T* ComponentStorage<T>::GetSlot(unsigned int slot)
+{
+    return reinterpret_cast<T*>(&chunks[slot/CHUNK_SIZE]->slots[slot%CHUNK_SIZE]);
+}
+
+template <typename T>
+void ComponentStorage<T>::Destroy(unsigned int slot)
+{
+    GetSlot(slot)->~T();
+    chunks[slot/CHUNK_SIZE]->used.reset(slot%CHUNK_SIZE);
+    freeSlots.push_back(slot);
+    --size;
+}
+
+template <typename T>
+void* ComponentStorage<T>::AllocateBlock(std::size_t size)
+{
+    const std::size_t alignment = alignof(std::max_align_t);
+
+    if (blockSize == 0)
+        blockSize = (size + alignment - 1)/alignment*alignment;
+
+    // Blocks of any other size are not expected, but are still served.
+    if (size > blockSize)
+    {
+        ++numberOfAllocations;
+        return ::operator new(size);
+    }
+
+    if (freeBlocks.empty())
+    {
+        blockChunks.push_back(
+            std::unique_ptr<char[]>(new char[blockSize*CHUNK_SIZE]));
+        ++numberOfAllocations;
+
+        for (unsigned int i = CHUNK_SIZE; i > 0; --i)
+            freeBlocks.push_back(blockChunks.back().get() + (i - 1)*blockSize);
+    }
+
+    void* block = freeBlocks.back();
+    freeBlocks.pop_back();
+    return block;
+}
+
+template <typename T>
+void ComponentStorage<T>::DeallocateBlock(void* block, std::size_t size)
+{
+    if (size > blockSize)
+        ::operator delete(block);
+    else
+        freeBlocks.push_back(block);
+}
+
+#endif // COMPONENT_STORAGE_H_
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Assigns an unique integer ID to each component class, allowing component
+// queries to be answered with integer and bitmask operations instead of
+// comparing the strings returned by Component::GetComponentClass.
+//
+// IDs are handed out in registration order, starting from zero, and are only
+// valid during the current execution.
+
+#ifndef COMPONENT_TYPE_H_
+#define COMPONENT_TYPE_H_
+
+#include <bitset>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "bandit/core/Log.h"
+#include "bandit/entity/Component.h"
+
+// Maximum number of component classes that can be registered.
+#define MAX_COMPONENT_TYPES 64
+
+// Set of component classes, where the bit at position ID is set when the
+// component class with such ID belongs to the set.
+typedef std::bitset<MAX_COMPONENT_TYPES> ComponentMask;
+
+class ComponentType
+{
+  public:
+    // Gets the ID of a component class known at compile time. The registry is
+    // only consulted in the first call for each class.
+    template <typename T>
+    static unsigned int GetId();
+
+    // Gets the ID of the dynamic class of a component, registering its class
+    // name so it can be found by FindId.
+    static unsigned int GetId(Component& component);
+
+    // Finds the ID of a component class given its name. Returns false when no
+    // component of this class has been registered, which means no entity can
+    // possibly have it.
+    static bool FindId(std::string componentClass, unsigned int& id);
+
+    // Builds the mask containing all the given component classes.
+    template <typename... T>
+    static ComponentMask GetMask();
+
+  private:
+    // Gets the ID of a C++ type, assigning a new one if necessary.
+    static unsigned int Register(std::type_index type);
+
+    // Maps C++ types to their IDs.
+    static std::unordered_map<std::type_index, unsigned int>& GetTypeIds();
+
+    // Maps component class names to their IDs.
+    static std::unordered_map<std::string, unsigned int>& GetNameIds();
+
+    // Holds which IDs have their class names registered.
+    static ComponentMask& GetNamedTypes();
+
+    // Guards the registry, which may be used by systems updated at the same
+    // time.
+    static std::mutex& GetMutex();
+};
+
+template <typename T>
+unsigned int ComponentType::GetId()
+{
+    static const unsigned int id = Register(std::type_index(typeid(T)));
+    return id;
+}
+
+template <typename... T>
+ComponentMask ComponentType::GetMask()
+{
+    ComponentMask mask;
+    unsigned int ids[] = { GetId<T>()... };
+
+    for (auto id : ids)
+        mask.set(id);
+
+    return mask;
+}
+
+#endif // COMPONENT_TYPE_H_
\ No newline at end of file
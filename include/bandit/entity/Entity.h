@@ -1,26 +1,47 @@
-// Entity is an object with an unique ID number. This allows us to identify any
-// system and get its components.
+// Entity is a lightweight handle identifying an object in the game. This allows
+// us to identify any entity and get its components.
+//
+// A handle is made of a slot index and a generation. Slots are recycled when
+// entities are deleted, and the generation of the slot is increased every time
+// that happens, so handles to deleted entities can be detected as stale by the
+// EntityManager instead of referring to a new entity in the same slot.
 
 #ifndef ENTITY_H_
 #define ENTITY_H_
 
 #include <limits>
 
-#include "bandit/core/Log.h"
-
 class Entity
 {
   public:
+    // Slot index of handles not referring to any entity.
+    static const unsigned int INVALID_INDEX =
+        std::numeric_limits<unsigned int>::max();
+
+    // Creates an invalid handle.
     Entity();
-    virtual ~Entity() {}
-    unsigned int GetId();
 
-  private:
-    unsigned int id;
+    Entity(unsigned int index, unsigned int generation);
+
+    // Gets the slot index of the entity. Indices are recycled, so two entities
+    // that never coexisted may have the same ID.
+    unsigned int GetId() const;
 
-    // Tracks the lowest unassigned ID in order to properly generate a new ID
-    // when creating a new entity.
-    static unsigned int lowestUnassignedId;
+    // Gets how many times the slot had been recycled when the entity was
+    // created.
+    unsigned int GetGeneration() const;
+
+    // Checks whether the handle has been assigned an entity at all. Use
+    // EntityManager::IsAlive to check whether the entity still exists.
+    bool IsValid() const;
+    explicit operator bool() const;
+
+    bool operator==(const Entity& other) const;
+    bool operator!=(const Entity& other) const;
+
+  private:
+    unsigned int index;
+    unsigned int generation;
 };
 
 #endif // ENTITY_H_
\ No newline at end of file
@@ -3,45 +3,60 @@
 #ifndef ENTITY_MANAGER_H_
 #define ENTITY_MANAGER_H_
 
-#include <unordered_map>
-#include <map>
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "bandit/core/Log.h"
 #include "bandit/entity/Component.h"
+#include "bandit/entity/ComponentStorage.h"
+#include "bandit/entity/ComponentType.h"
 #include "bandit/entity/Entity.h"
 
 class EntityManager
 {
   public:
+    EntityManager();
+
     // Creates a new entity.
-    std::shared_ptr<Entity> CreateEntity();
+    Entity CreateEntity();
 
     // Clears everything from entity manager.
     void Clear();
 
-    // Deletes an entity from the management.
-    void DeleteEntity(std::shared_ptr<Entity> entity);
+    // Deletes an entity from the management, releasing its slot to be
+    // recycled by new entities. Deleting a stale handle does nothing.
+    void DeleteEntity(Entity entity);
+
+    // Checks whether the handle refers to an entity that has not been deleted.
+    bool IsAlive(Entity entity);
+
+    // Checks whether an entity has been deleted or scheduled for deletion by
+    // DeleteEntityDeferred, in which case it is still alive until the next
+    // call to ApplyDeferredCommands.
+    bool IsDeleted(Entity entity);
 
     void DeleteEntitiesWithComponentsOfClass(std::string componentClass);
 
     // Adds a new component to an existing entity.
     void AddComponent(std::shared_ptr<Component> component,
-        std::shared_ptr<Entity> entity);
+        Entity entity);
 
     // Gets all components of the given class from an entity.
     std::vector<std::shared_ptr<Component>> GetComponentsOfClass(
-        std::shared_ptr<Entity> entity, std::string componentClass);
+        Entity entity, std::string componentClass);
 
     // Gets all entities that has a specific component class attached to it.
-    std::vector<std::shared_ptr<Entity>> GetAllEntitiesWithComponentOfClass(
+    // The result is cached, as the ones returned by View.
+    const std::vector<Entity>& GetAllEntitiesWithComponentOfClass(
         std::string componentClass);
 
     // Gets a single component that has a specific component class attached to
     // it.
-    std::shared_ptr<Entity> GetEntityWithComponentOfClass(
+    Entity GetEntityWithComponentOfClass(
         std::string componentClass);
 
     // Checks whether at least one entity has a component of the given class.
@@ -49,36 +64,283 @@ class EntityManager
 
     // Gets a single component of a given class from an entity.
     std::shared_ptr<Component> GetSingleComponentOfClass(
-        std::shared_ptr<Entity> entity, std::string componentClass);
+        Entity entity, std::string componentClass);
 
     // Gets all components from all entities that matches the given class.
     std::vector<std::shared_ptr<Component>> GetAllComponentsOfClass(
         std::string componentClass);
 
     // Checks whether an entity has at least one component of the given class.
-    bool HasComponent(std::shared_ptr<Entity> entity,
+    bool HasComponent(Entity entity,
         std::string componentClass);
 
     // Gets the number of entities currently managed.
     unsigned int GetNumberOfEntities();
 
-    void DeleteComponentsOfClass(std::shared_ptr<Entity> entity,
+    // Gets the number of components created through CreateComponent and the
+    // number of times their storages requested memory from the global
+    // allocator, which stops growing once storages hold enough components.
+    unsigned int GetNumberOfPooledComponents();
+    unsigned int GetNumberOfComponentAllocations();
+
+    void DeleteComponentsOfClass(Entity entity,
         std::string componentClass);
 
+    // Deferred counterparts of DeleteEntity, AddComponent and
+    // DeleteComponentsOfClass. They are meant to be used by systems while
+    // iterating over entities, and are applied in the order they were
+    // requested when ApplyDeferredCommands is called.
+    void DeleteEntityDeferred(Entity entity);
+    void AddComponentDeferred(std::shared_ptr<Component> component,
+        Entity entity);
+    void DeleteComponentsOfClassDeferred(Entity entity,
+        std::string componentClass);
+
+    // Applies all deferred commands. Deleted entities are removed from cached
+    // queries in a single pass, no matter how many of them there are.
+    void ApplyDeferredCommands();
+
+    // Entities losing a component, through DeleteComponentsOfClass or
+    // DeleteEntity, are not erased from the cached queries right away.
+    // Queries are only marked, and swept in a single pass the next time they
+    // are read, before an entity slot is reused, or once deferred commands
+    // are applied. Swapping a component, as when a sprite is replaced by
+    // another, therefore leaves queries untouched, and many removals in a row
+    // cost a single pass per query.
+
+    // Gets a single component of class T from an entity.
+    template <typename T>
+    std::shared_ptr<T> Get(Entity entity);
+
+    // Gets all components of class T from an entity.
+    template <typename T>
+    std::vector<std::shared_ptr<T>> GetComponents(
+        Entity entity);
+
+    // Checks whether an entity has at least one component of class T.
+    template <typename T>
+    bool Has(Entity entity);
+
+    // Gets all entities that have at least one component of each of the given
+    // classes, in creation order. The result is cached and kept up to date as
+    // entities and components change, so the reference must be copied before
+    // iterating over it while adding or deleting entities or components.
+    template <typename... T>
+    const std::vector<Entity>& View();
+
+    // Creates a component of class T inside the contiguous storage of its
+    // class. The component still needs to be added to an entity.
+    template <typename T, typename... Args>
+    std::shared_ptr<T> CreateComponent(Args&&... args);
+
+    // Gets the storage holding all components of class T created with
+    // CreateComponent, allowing systems to iterate over them linearly.
+    template <typename T>
+    ComponentStorage<T>& GetStorage();
+
   private:
-    void DeleteEntityComponents(std::shared_ptr<Entity> entity);
-    void DeleteEntityFromContainer(std::shared_ptr<Entity> entity);
-    bool HasEntity(std::shared_ptr<Entity> entity);
+    // Components attached to a single entity.
+    struct EntityComponents
+    {
+        // Classes of all attached components.
+        ComponentMask mask;
+
+        // Attached components and their class IDs, in insertion order.
+        std::vector<std::shared_ptr<Component>> components;
+        std::vector<unsigned int> types;
+    };
+
+    // Gets the components attached to an entity, or nullptr if it has none.
+    EntityComponents* FindComponents(Entity entity);
+
+    // Gets a single component with the given class ID from an entity, exiting
+    // when there is none.
+    std::shared_ptr<Component> GetSingleComponentOfType(
+        Entity entity, unsigned int type);
+
+    // Entities whose components contain a mask, sorted by creation order.
+    struct Query
+    {
+        Query() : dirty(false) {}
+
+        ComponentMask mask;
+        std::vector<Entity> entities;
+
+        // Whether some of the entities may no longer match the mask and must
+        // be swept before the query is read.
+        bool dirty;
+    };
+
+    // Gets the cached query for a mask, creating it on first use.
+    const std::vector<Entity>& GetQuery(ComponentMask mask);
+
+    // Updates cached queries when the mask of an entity changes.
+    void UpdateQueries(Entity entity, ComponentMask oldMask,
+        ComponentMask newMask);
+
+    // Inserts an entity into a query, keeping it sorted, unless a removal not
+    // swept yet left it there.
+    void InsertIntoQuery(Query& query, Entity entity);
+
+    // Marks a query as holding an entity that no longer matches it.
+    void RemoveFromQuery(Query& query, Entity entity);
+
+    // Removes the entities no longer alive or no longer matching the mask
+    // from a query.
+    void SweepQuery(Query& query);
+
+    // Sweeps every query marked by RemoveFromQuery.
+    void SweepDirtyQueries();
+
+    // Sweeps every query, removing entities no longer alive whether or not
+    // the query was marked.
+    void RemoveDeletedEntitiesFromQueries();
+
+    // Change to entities requested by one of the deferred methods.
+    struct Command
+    {
+        enum Type
+        {
+            DeleteEntityCommand,
+            AddComponentCommand,
+            DeleteComponentsCommand,
+        };
+
+        Type type;
+        Entity entity;
+        std::shared_ptr<Component> component;
+        std::string componentClass;
+    };
+
+    // Entity slot, indexed by entity ID and recycled once its entity is
+    // deleted.
+    struct EntitySlot
+    {
+        EntitySlot() :
+            generation(0), alive(false), deletionPending(false),
+            creationOrder(0), position(0)
+        {
+        }
 
-    // All entities in the game.
-    std::vector<std::shared_ptr<Entity>> entities;
+        // Generation of the entity currently or last held by the slot.
+        unsigned int generation;
+        bool alive;
+        bool deletionPending;
 
-    // Stores all components attached to a given entity.
-    std::unordered_map<unsigned int, std::vector<std::shared_ptr<Component>>>
-        componentsByEntity;
+        // Position of the entity among all entities ever created, used to
+        // keep queries sorted.
+        unsigned long long creationOrder;
 
-    // Stores all entities that have a given component type.
-    std::multimap<std::string, std::shared_ptr<Entity>> componentToEntities;
+        // Index of the entity in the entities container.
+        unsigned int position;
+
+        // Stores all components attached to the entity.
+        EntityComponents components;
+    };
+
+    // Releases the slot of an alive entity, deleting its components and
+    // invalidating all handles to it. Cached queries are not updated.
+    void ReleaseSlot(Entity entity);
+
+    // Deletes an entity from the entities container by moving the last entity
+    // to its position.
+    void DeleteEntityFromContainer(Entity entity);
+
+    // All entities in the game, in no particular order.
+    std::vector<Entity> entities;
+
+    // Stores contiguous component storages indexed by component class ID.
+    std::vector<std::shared_ptr<BaseComponentStorage>> storages;
+
+    // All entity slots ever used and the IDs of the ones available for reuse.
+    std::vector<EntitySlot> slots;
+    std::vector<unsigned int> freeSlots;
+
+    // Creation order of the next entity.
+    unsigned long long nextCreationOrder;
+
+    // Queries created so far. They are never destroyed, so references to
+    // their entities remain valid.
+    std::vector<std::unique_ptr<Query>> queries;
+
+    // Whether any query has been marked by RemoveFromQuery since the last
+    // sweep. Swept entities are found by their slots, so dirty queries must be
+    // swept before a released slot is reused.
+    bool queriesDirty;
+
+    // Guard what systems updated at the same time may change: queries and
+    // storages created on first use and deferred commands.
+    std::mutex queriesMutex;
+    std::mutex storagesMutex;
+    std::mutex commandsMutex;
+
+    // Commands waiting for ApplyDeferredCommands and the ones being applied,
+    // kept as members so their memory is reused every frame.
+    std::vector<Command> commands;
+    std::vector<Command> pendingCommands;
 };
 
+template <typename T>
+std::shared_ptr<T> EntityManager::Get(Entity entity)
+{
+    return std::static_pointer_cast<T>(
+        GetSingleComponentOfType(entity, ComponentType::GetId<T>()));
+}
+
+template <typename T>
+std::vector<std::shared_ptr<T>> EntityManager::GetComponents(
+    Entity entity)
+{
+    std::vector<std::shared_ptr<T>> componentsArray;
+    unsigned int type = ComponentType::GetId<T>();
+    EntityComponents* entityComponents = FindComponents(entity);
+
+    if (!entityComponents || !entityComponents->mask.test(type))
+        return componentsArray;
+
+    for (unsigned int i = 0; i < entityComponents->types.size(); ++i)
+    {
+        if (entityComponents->types[i] == type)
+            componentsArray.push_back(std::static_pointer_cast<T>(
+                entityComponents->components[i]));
+    }
+
+    return componentsArray;
+}
+
+template <typename T>
+bool EntityManager::Has(Entity entity)
+{
+    EntityComponents* entityComponents = FindComponents(entity);
+    return (entityComponents &&
+        entityComponents->mask.test(ComponentType::GetId<T>()));
+}
+
+template <typename... T>
+const std::vector<Entity>& EntityManager::View()
+{
+    return GetQuery(ComponentType::GetMask<T...>());
+}
+
+template <typename T, typename... Args>
+std::shared_ptr<T> EntityManager::CreateComponent(Args&&... args)
+{
+    return GetStorage<T>().Create(std::forward<Args>(args)...);
+}
+
+template <typename T>
+ComponentStorage<T>& EntityManager::GetStorage()
+{
+    unsigned int type = ComponentType::GetId<T>();
+    std::lock_guard<std::mutex> lock(storagesMutex);
+
+    if (type >= storages.size())
+        storages.resize(type + 1);
+
+    if (!storages[type])
+        storages[type] = std::make_shared<ComponentStorage<T>>();
+
+    return *std::static_pointer_cast<ComponentStorage<T>>(storages[type]);
+}
+
 #endif // ENTITY_MANAGER_H_
\ No newline at end of file
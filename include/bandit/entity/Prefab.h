@@ -0,0 +1,51 @@
+// Prefab is a blueprint of an entity, made of prototype components with all
+// their properties already resolved. Instantiating a prefab creates an entity
+// with a copy of each prototype, which avoids parsing configurations and
+// building components one by one every time a similar entity is created.
+
+#ifndef PREFAB_H_
+#define PREFAB_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "bandit/entity/Component.h"
+#include "bandit/entity/Entity.h"
+#include "bandit/entity/EntityManager.h"
+
+class Prefab
+{
+  public:
+    // Adds a prototype component. Every instance of the prefab receives its
+    // own copy of it, in the order prototypes were added.
+    template <typename T>
+    void AddComponent(const T& prototype);
+
+    // Creates an entity with copies of all prototypes.
+    Entity Instantiate(EntityManager& entityManager) const;
+
+    // Creates many entities at once with copies of all prototypes.
+    std::vector<Entity> Instantiate(EntityManager& entityManager,
+        unsigned int numberOfEntities) const;
+
+  private:
+    // Functions copying each prototype into a new component.
+    std::vector<std::function<std::shared_ptr<Component>(EntityManager&)>>
+        cloners;
+};
+
+template <typename T>
+void Prefab::AddComponent(const T& prototype)
+{
+    // Prototypes are kept outside component storages, so systems iterating
+    // over storages never see them.
+    std::shared_ptr<T> copy = std::make_shared<T>(prototype);
+
+    cloners.push_back([copy](EntityManager& entityManager)
+        {
+            return entityManager.CreateComponent<T>(*copy);
+        });
+}
+
+#endif // PREFAB_H_
\ No newline at end of file
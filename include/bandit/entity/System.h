@@ -1,5 +1,17 @@
-// Systems processes entities with specific components and give life to the
-// game.
+// Systems processes entities and components and give life to the game.
+//
+// Systems may declare which component classes they read and write, so that
+// the system manager can update systems with no conflicting accesses at the
+// same time. A system declaring its accesses must only change components
+// through them: creating or deleting entities, adding or removing components
+// and talking to the adapters are only allowed through the deferred methods of
+// the entity manager. Systems that declare nothing are exclusive, meaning they
+// are updated alone, in the main thread, and are free to do all of the above.
+//
+// Systems either advance the simulation, once per simulation step with the
+// fixed time step, or present it, once per frame with the time actually
+// elapsed. Presentation systems, such as the ones rendering the game, must not
+// change the simulation, so it advances the same however often it is presented.
 
 #ifndef SYSTEM_H_
 #define SYSTEM_H_
@@ -7,12 +19,13 @@
 #include <memory>
 #include <string>
 
+#include "bandit/entity/ComponentType.h"
 #include "bandit/entity/EntityManager.h"
 
 class System
 {
   public:
-    System() {}
+    System() : exclusive(true), presentation(false) {}
     virtual ~System() {}
 
     // Gets human-readable system name.
@@ -20,6 +33,67 @@ class System
 
     // Processes entities and components.
     virtual void Update(float dt) = 0;
+
+    // Gets the component classes read and written by the system.
+    const ComponentMask& GetReadMask() { return readMask; }
+    const ComponentMask& GetWriteMask() { return writeMask; }
+
+    // Checks whether the system must be updated alone.
+    bool IsExclusive() { return exclusive; }
+
+    // Checks whether the system presents the simulation instead of advancing
+    // it.
+    bool IsPresentation() { return presentation; }
+
+    // Checks whether the two systems must not be updated at the same time,
+    // which happens when any of them is exclusive or writes a component class
+    // the other one reads or writes.
+    bool ConflictsWith(System& other);
+
+  protected:
+    // Declares component classes read by the system. Meant to be called by
+    // the constructor of the system.
+    template <typename... T>
+    void Reads();
+
+    // Declares component classes read and written by the system. Meant to be
+    // called by the constructor of the system.
+    template <typename... T>
+    void Writes();
+
+    // Declares the system as a presentation one. Meant to be called by the
+    // constructor of the system.
+    void Presents() { presentation = true; }
+
+  private:
+    ComponentMask readMask;
+    ComponentMask writeMask;
+    bool exclusive;
+    bool presentation;
 };
 
+inline bool System::ConflictsWith(System& other)
+{
+    if (exclusive || other.exclusive)
+        return true;
+
+    return ((writeMask & (other.readMask | other.writeMask)).any()
+        || (other.writeMask & readMask).any());
+}
+
+template <typename... T>
+void System::Reads()
+{
+    readMask |= ComponentType::GetMask<T...>();
+    exclusive = false;
+}
+
+template <typename... T>
+void System::Writes()
+{
+    writeMask |= ComponentType::GetMask<T...>();
+    readMask |= ComponentType::GetMask<T...>();
+    exclusive = false;
+}
+
 #endif // SYSTEM_H_
\ No newline at end of file
@@ -1,24 +1,67 @@
 // Manages systems update.
+//
+// Systems are updated in stages. Each system goes to the stage right after
+// the last stage holding an earlier added system it conflicts with, so
+// conflicting systems are always updated in the order they were added, while
+// the systems of a stage are updated at the same time by the job system.
+// Stages are computed again only when systems are added or deleted.
+//
+// Simulation and presentation systems are staged and updated separately, the
+// former by Simulate and the latter by Present. Each system update is timed by
+// the profiler as a zone named after the system.
 
 #ifndef SYSTEM_MANAGER_H_
 #define SYSTEM_MANAGER_H_
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "bandit/core/Log.h"
+#include "bandit/core/thread/JobSystem.h"
+#include "bandit/core/time/Profiler.h"
 #include "bandit/entity/System.h"
 
 class SystemManager
 {
   public:
+    SystemManager();
+
+    // Sets the job system updating systems at the same time. Without one,
+    // systems are updated one after another.
+    void SetJobSystem(std::shared_ptr<JobSystem> jobSystem);
+
     void AddSystem(std::shared_ptr<System> system);
     void DeleteSystem(std::string name);
-    void Update(float dt);
     void Clear();
 
+    // Updates the simulation systems by one simulation step.
+    void Simulate(float dt);
+
+    // Updates the presentation systems by one frame.
+    void Present(float dt);
+
   private:
+    // Groups systems into stages of systems that don't conflict.
+    void BuildStages();
+    void BuildStages(bool presentation,
+        std::vector<std::vector<System*>>& stages);
+
+    void Update(std::vector<std::vector<System*>>& stages, float dt);
+    void UpdateSystem(System* system, const char* zoneName, float dt);
+
     std::vector<std::shared_ptr<System>> systems;
+
+    // Systems of each stage, in the order they were added.
+    std::vector<std::vector<System*>> simulationStages;
+    std::vector<std::vector<System*>> presentationStages;
+    bool stagesOutdated;
+
+    // Profiler zone names of the staged systems, interned as stages are built.
+    std::unordered_map<System*, const char*> zoneNames;
+
+    std::shared_ptr<JobSystem> jobSystem;
 };
 
 #endif // SYSTEM_MANAGER_H_
\ No newline at end of file
@@ -0,0 +1,85 @@
+// Broad phase of collision detection, which finds pairs of entities whose
+// bounding boxes overlap and may therefore collide.
+//
+// Broad phases are kept from one frame to the next. Each frame, entities are
+// updated with their bounding circles between calls to BeginUpdate and
+// RemoveStaleEntities, and the latter drops the entities that were not
+// updated. Implementations are notified of each insertion, movement and
+// removal, so they can keep their structures up to date incrementally.
+
+#ifndef BROAD_PHASE_H_
+#define BROAD_PHASE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bandit/Engine.h"
+
+class BroadPhase
+{
+  public:
+    BroadPhase();
+    virtual ~BroadPhase() {}
+
+    // Creates the broad phase with the given name: "grid", "sweep_and_prune"
+    // or "quadtree".
+    static std::unique_ptr<BroadPhase> Create(std::string name);
+
+    // Gets human-readable broad phase name.
+    virtual std::string GetName() = 0;
+
+    // Starts a new round of updates.
+    void BeginUpdate();
+
+    // Inserts an entity or moves it, given the circle bounding it.
+    void Update(Entity entity, Vector position, float radius);
+
+    // Removes every entity not updated since the last call to BeginUpdate.
+    void RemoveStaleEntities();
+
+    void Remove(Entity entity);
+    void Clear();
+
+    // Gets the pairs of entities whose bounding boxes overlap, each of them
+    // listed once.
+    virtual void GetPairs(std::vector<std::pair<Entity, Entity>>& pairs) = 0;
+
+    unsigned int GetNumberOfEntities();
+
+  protected:
+    struct Proxy
+    {
+        Entity entity;
+
+        // Bounding box of the entity.
+        float minX, minY, maxX, maxY;
+
+        // Position in insertedProxies, valid while the entity is inserted.
+        unsigned int position;
+        bool inserted;
+
+        unsigned long long lastUpdate;
+    };
+
+    // Called after an entity is inserted or its bounding box changes, and
+    // before an entity is removed, given its ID.
+    virtual void OnInsert(unsigned int id) = 0;
+    virtual void OnMove(unsigned int id) = 0;
+    virtual void OnRemove(unsigned int id) = 0;
+
+    // Called after all entities are removed at once.
+    virtual void OnClear() = 0;
+
+    static bool Overlap(const Proxy& proxy1, const Proxy& proxy2);
+
+    // Entities indexed by entity ID, and the IDs of the inserted ones.
+    std::vector<Proxy> proxies;
+    std::vector<unsigned int> insertedProxies;
+
+  private:
+    unsigned long long currentUpdate;
+};
+
+#endif // BROAD_PHASE_H_
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Contacts kept between frames, which tells collisions that just began apart
+// from the ones that were already going on and finds the ones that ended.
+//
+// Contacts are keyed by the pair of entity handles, regardless of their order,
+// so a pair reported by the broad phase in a different order in the next
+// frame is still recognized.
+
+#ifndef CONTACT_CACHE_H_
+#define CONTACT_CACHE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "bandit/core/RingBuffer.h"
+
+#include "poiesis/NarrowPhase.h"
+
+// Stage of a collision between two entities.
+enum CollisionEventType
+{
+    // The entities started overlapping this frame.
+    CollisionBegin,
+
+    // The entities were already overlapping in the previous frame.
+    CollisionStay,
+
+    // The entities overlapped in the previous frame but not anymore. The
+    // contact is the last one found, and any of the entities may have been
+    // deleted since then.
+    CollisionEnd,
+};
+
+struct CollisionEvent
+{
+    CollisionEventType type;
+    Contact contact;
+};
+
+class ContactCache
+{
+  public:
+    ContactCache();
+
+    // Replaces the cached contacts with the ones found this frame, queuing an
+    // event for each one, in order, followed by an end event for each contact
+    // not found anymore.
+    void Update(const std::vector<Contact>& contacts,
+        RingBuffer<CollisionEvent>& events);
+
+  private:
+    struct CachedContact
+    {
+        Contact contact;
+
+        // Last frame in which the contact was found.
+        unsigned int frame;
+    };
+
+    // Gets the key of a pair of entities, which is the same in both orders.
+    static uint64_t GetKey(Entity entity1, Entity entity2);
+
+    std::unordered_map<uint64_t, CachedContact> cachedContacts;
+
+    // Number of calls to Update.
+    unsigned int frame;
+};
+
+#endif // CONTACT_CACHE_H_
\ No newline at end of file
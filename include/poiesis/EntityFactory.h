@@ -1,10 +1,18 @@
 // Creates default entities to be used in the game.
+//
+// Most entities are instantiated from prefabs, which are built from the
+// configurations the first time they are needed and again whenever the
+// configurations change.
+//
+// Creating entities is not thread-safe, so the factory must only be used
+// outside system updates or by exclusive systems, which run alone.
 
 #ifndef ENTITY_FACTORY_H_
 #define ENTITY_FACTORY_H_
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "bandit/Engine.h"
 #include "poiesis/components/AIComponent.h"
@@ -30,47 +38,71 @@ class EntityFactory
 {
   public:
     // Creates background: a single immovable sprite.
-    static std::shared_ptr<Entity> CreateBackground();
+    static Entity CreateBackground();
 
     // Creates cell: a sprite than can move with user input.
-    static std::shared_ptr<Entity> CreateCell(Vector position);
+    static Entity CreateCell(Vector position);
+    static std::vector<Entity> CreateCells(
+        const std::vector<Vector>& positions);
 
     // Creates player: a cell that is followed by the camera.
-    static std::shared_ptr<Entity> CreatePlayer();
+    static Entity CreatePlayer();
 
-    static std::shared_ptr<Entity> CreateLevel3Cell(Vector position);
-    static std::shared_ptr<Entity> CreateLevel3Player();
+    static Entity CreateLevel3Cell(Vector position);
+    static std::vector<Entity> CreateLevel3Cells(
+        const std::vector<Vector>& positions);
+    static Entity CreateLevel3Player();
 
     // Creates food: a sprite that can move with user input.
-    static std::shared_ptr<Entity> CreateFood(Vector position);
+    static Entity CreateFood(Vector position);
+    static std::vector<Entity> CreateFood(
+        const std::vector<Vector>& positions);
 
-    static std::shared_ptr<Entity> CreateCellParticle(Vector position);
+    static Entity CreateCellParticle(Vector position);
 
-    static std::shared_ptr<Entity> CreateVirus(Vector position);
+    static Entity CreateVirus(Vector position);
+    static std::vector<Entity> CreateViruses(
+        const std::vector<Vector>& positions);
 
     // Creates camera: a position for rendering images.
-    static std::shared_ptr<Entity> CreateCamera(float height = 1);
+    static Entity CreateCamera(float height = 1);
 
     // Creates slow area: a region which reduces entities speed.
-    static std::shared_ptr<Entity> CreateSlowArea(Vector position);
+    static Entity CreateSlowArea(Vector position);
 
     // Creates fast area: a region which increases entities speed.
-    static std::shared_ptr<Entity> CreateFastArea(Vector position);
+    static Entity CreateFastArea(Vector position);
 
     // Creates vitamin area: a region which increases entities growth.
-    static std::shared_ptr<Entity> CreateVitaminArea(Vector position);
+    static Entity CreateVitaminArea(Vector position);
 
     // Creates acid area: a region which decreases entities growth.
-    static std::shared_ptr<Entity> CreateAcidArea(Vector position);
+    static Entity CreateAcidArea(Vector position);
 
     // Creates button: a region which an sprite and responds to clicks.
-    static std::shared_ptr<Entity> CreateButton(std::string image,
+    static Entity CreateButton(std::string image,
         Rectangle rectangle, std::function<void()> callback);
 
-    static std::shared_ptr<Entity> CreateBacterium(Vector position);
+    static Entity CreateBacterium(Vector position);
 
   private:
-    static std::shared_ptr<Entity> CreateCellWithoutSprite(Vector position);
+    static Entity CreateCellWithoutSprite(Vector position);
+
+    // Instantiates a prefab, placing its particle at the given positions.
+    static Entity InstantiateAt(const Prefab& prefab, Vector position);
+    static std::vector<Entity> InstantiateAt(const Prefab& prefab,
+        const std::vector<Vector>& positions);
+
+    static const Prefab& GetCellPrefab();
+    static const Prefab& GetLevel3CellPrefab();
+    static const Prefab& GetFoodPrefab();
+    static const Prefab& GetCellParticlePrefab();
+    static const Prefab& GetVirusPrefab();
+    static const Prefab& GetSlowAreaPrefab();
+    static const Prefab& GetFastAreaPrefab();
+    static const Prefab& GetVitaminAreaPrefab();
+    static const Prefab& GetAcidAreaPrefab();
+    static const Prefab& GetBacteriumPrefab(int type);
 };
 
 #endif // ENTITY_FACTORY_H_
\ No newline at end of file
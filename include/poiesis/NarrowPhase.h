@@ -0,0 +1,75 @@
+// Narrow phase of collision detection, which tests the pairs found by the
+// broad phase for actual overlap of their bounding circles.
+//
+// Circles are gathered from the pairs into packed arrays, four pairs at a
+// time, so they can be tested with SIMD instructions when available. Squared
+// distances are compared, and the square root is only taken for the pairs
+// that turn out to overlap.
+
+#ifndef NARROW_PHASE_H_
+#define NARROW_PHASE_H_
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "bandit/Engine.h"
+
+// Overlap between the bounding circles of two entities.
+struct Contact
+{
+    Entity entity1;
+    Entity entity2;
+
+    // Unit vector pointing from the first entity to the second one, or the
+    // zero vector when both are at the same position.
+    Vector normal;
+
+    // Depth by which the circles overlap.
+    float penetration;
+};
+
+class NarrowPhase
+{
+  public:
+    // Sets the bounding circle of an entity, which is used by every following
+    // call to FindContacts.
+    void SetCircle(Entity entity, Vector position, float radius);
+
+    // Lists the pairs whose circles overlap, in the order they were given.
+    // Chunks of grainSize pairs are tested by different jobs.
+    void FindContacts(const std::vector<std::pair<Entity, Entity>>& pairs,
+        unsigned int grainSize, std::vector<Contact>& contacts);
+
+    // Finds the contact between two circles. Returns false if they don't
+    // overlap.
+    static bool CreateContact(Entity entity1, Vector position1, float radius1,
+        Entity entity2, Vector position2, float radius2, Contact& contact);
+
+  private:
+    // Number of pairs tested at once.
+    static const unsigned int BLOCK_SIZE = 4;
+
+    // Gathers the circles of the pairs from first to last, not inclusive,
+    // into the packed arrays and tests them.
+    void TestPairs(const std::vector<std::pair<Entity, Entity>>& pairs,
+        unsigned int first, unsigned int last);
+
+    // Circles indexed by entity ID.
+    std::vector<float> circlesX;
+    std::vector<float> circlesY;
+    std::vector<float> circlesRadius;
+
+    // Circles of each pair, padded to a whole number of blocks.
+    std::vector<float> x1, y1, x2, y2, radiusSums;
+
+    // Whether each pair overlaps. Chars are used instead of bools so that
+    // jobs can write them at the same time.
+    std::vector<char> overlapping;
+};
+
+#endif // NARROW_PHASE_H_
\ No newline at end of file
@@ -0,0 +1,122 @@
+// Structure of arrays holding the state of particles.
+//
+// Each property of the particles is kept in its own array, and particle
+// components read and write their properties through their index in the
+// store, so the integrator advances several particles at once with SIMD
+// instructions with nothing to copy in or out. The AVX2 kernel is compiled for
+// its target alone and only chosen when the CPU running the game supports it,
+// falling back to a scalar loop otherwise.
+//
+// Particles created inside the component storage, the ones the particle
+// system moves, live in the integrated store. Any other particle, such as the
+// prototypes of prefabs, lives in the detached store, which is never
+// integrated. Static bodies and released indices stay in the arrays, masked
+// out of the integration.
+//
+// Disjoint ranges of indices can be integrated by different jobs at the same
+// time. Creating and destroying particles is not thread-safe, the same as
+// creating and destroying components. Each particle keeps its store alive, so
+// a store never outlives its particles.
+
+#ifndef PARTICLE_STORE_H_
+#define PARTICLE_STORE_H_
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "bandit/Engine.h"
+
+class ParticleStore
+{
+  public:
+    ParticleStore();
+
+    // Gets the store of the particles integrated by the particle system.
+    static const std::shared_ptr<ParticleStore>& GetIntegratedStore();
+
+    // Gets the store of the particles no system moves.
+    static const std::shared_ptr<ParticleStore>& GetDetachedStore();
+
+    // Gets the name of the integrator kernel in use.
+    std::string GetKernelName();
+
+    // Makes room for a new particle, reusing released indices, and returns
+    // its index. The particle is a static body until its properties are set.
+    unsigned int Create();
+
+    // Releases the index of a particle. Once every particle is released, the
+    // store starts over from the first index, so runs creating the same
+    // particles in the same order lay them out the same way.
+    void Destroy(unsigned int index);
+
+    // Copies all properties of a particle of any store into the given index.
+    void Copy(unsigned int index, ParticleStore& source,
+        unsigned int sourceIndex);
+
+    // Gets the number of indices ever used, released or not, which bounds
+    // the ranges given to Integrate.
+    unsigned int GetNumberOfSlots();
+
+    // Draws the random forces added to the particles from first to last, not
+    // inclusive, by the next integration, with each coordinate between
+    // -magnitude and magnitude.
+    void GenerateRandomForces(unsigned int first, unsigned int last,
+        Random& random, float magnitude);
+
+    // Integrates the dynamic bodies from first to last, not inclusive, saving
+    // their previous state and clearing the forces applied to them.
+    void Integrate(unsigned int first, unsigned int last, float dt);
+
+  private:
+    friend class ParticleComponent;
+
+    typedef void (*Kernel)(ParticleStore& store, unsigned int first,
+        unsigned int last, float dt);
+
+    static void IntegrateScalar(ParticleStore& store, unsigned int first,
+        unsigned int last, float dt);
+    static void IntegrateAvx2(ParticleStore& store, unsigned int first,
+        unsigned int last, float dt);
+
+    // Keeps an angle between -pi and pi.
+    static float WrapAngle(float angle);
+
+    Kernel kernel;
+    std::string kernelName;
+
+    std::vector<float> positionsX, positionsY;
+    std::vector<float> velocitiesX, velocitiesY;
+    std::vector<float> accelerationsX, accelerationsY;
+    std::vector<float> forcesX, forcesY;
+    std::vector<float> randomForcesX, randomForcesY;
+
+    // Inverse masses are preferred since immovable particles have 0 inverse
+    // mass (or infinite mass), and acceleration is the force multiplied by
+    // the inverse mass.
+    std::vector<float> inverseMasses;
+
+    // Damping factors simulating velocity decay.
+    std::vector<float> dampings;
+
+    std::vector<float> angles;
+    std::vector<float> angularVelocities;
+
+    // Position and angle of the previous simulation step, and 1 once the
+    // particle has been integrated at least once.
+    std::vector<float> previousPositionsX, previousPositionsY;
+    std::vector<float> previousAngles;
+    std::vector<float> hasPreviousStates;
+
+    // 1 for dynamic bodies and 0 for static bodies and released indices,
+    // masking the integration.
+    std::vector<float> dynamics;
+
+    // Indices of released particles, reused before growing the arrays.
+    std::vector<unsigned int> freeIndices;
+
+    // Number of particles not released.
+    unsigned int size;
+};
+
+#endif // PARTICLE_STORE_H_
@@ -0,0 +1,41 @@
+// Quad-tree broad phase, rebuilding the tree from scratch on every call to
+// GetPairs. Entities are only paired with the ones in the same leaf as their
+// center.
+
+#ifndef QUADTREE_BROAD_PHASE_H_
+#define QUADTREE_BROAD_PHASE_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "poiesis/BroadPhase.h"
+#include "poiesis/Quadtree.h"
+
+class QuadtreeBroadPhase : public BroadPhase
+{
+  public:
+    // Creates a broad phase covering the given area.
+    explicit QuadtreeBroadPhase(Rectangle area);
+
+    std::string GetName();
+    void GetPairs(std::vector<std::pair<Entity, Entity>>& pairs);
+
+  protected:
+    void OnInsert(unsigned int id);
+    void OnMove(unsigned int id);
+    void OnRemove(unsigned int id);
+    void OnClear();
+
+  private:
+    // Gets the center of the bounding box of an entity.
+    Vector GetCenter(unsigned int id);
+
+    Rectangle area;
+
+    // Pairs of entity IDs found in the same leaf, each pair possibly found
+    // twice.
+    std::vector<std::pair<unsigned int, unsigned int>> idPairs;
+};
+
+#endif // QUADTREE_BROAD_PHASE_H_
\ No newline at end of file
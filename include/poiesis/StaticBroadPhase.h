@@ -0,0 +1,66 @@
+// Broad phase holding static bodies, which never move.
+//
+// Entities are bucketed into the cells of a uniform grid stored as a single
+// sorted array, built all at once. The grid is only built again when static
+// bodies are inserted, moved or removed, so updating it with the same bodies
+// every frame costs a comparison per body. Moving bodies are tested against
+// it with Query instead of being inserted.
+
+#ifndef STATIC_BROAD_PHASE_H_
+#define STATIC_BROAD_PHASE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "poiesis/BroadPhase.h"
+
+class StaticBroadPhase : public BroadPhase
+{
+  public:
+    explicit StaticBroadPhase(float cellSize);
+
+    std::string GetName();
+
+    // Gets the pairs of static bodies whose bounding boxes overlap.
+    void GetPairs(std::vector<std::pair<Entity, Entity>>& pairs);
+
+    // Adds a pair for each static body whose bounding box overlaps the circle
+    // bounding the given entity, which is listed first.
+    void Query(Entity entity, Vector position, float radius,
+        std::vector<std::pair<Entity, Entity>>& pairs);
+
+  protected:
+    void OnInsert(unsigned int id);
+    void OnMove(unsigned int id);
+    void OnRemove(unsigned int id);
+    void OnClear();
+
+  private:
+    int GetCellCoordinate(float coordinate);
+    static long long GetCellKey(int x, int y);
+
+    // Lists the static bodies overlapping the box, reporting each one in the
+    // cell holding the top left corner of the overlap.
+    void Query(Entity entity, float minX, float minY, float maxX, float maxY,
+        std::vector<std::pair<Entity, Entity>>& pairs);
+
+    void Build();
+
+    float cellSize;
+
+    // Whether the grid is out of date with the inserted bodies.
+    bool outdated;
+
+    // IDs of the bodies overlapping each cell, cell after cell, and the range
+    // of each cell in that array.
+    std::vector<unsigned int> cellProxies;
+    std::unordered_map<long long, std::pair<unsigned int, unsigned int>> cellRanges;
+
+    // Pairs of cell key and ID, sorted to build the grid.
+    std::vector<std::pair<long long, unsigned int>> entries;
+};
+
+#endif // STATIC_BROAD_PHASE_H_
\ No newline at end of file
@@ -0,0 +1,69 @@
+// Sort and sweep broad phase.
+//
+// The ends of the bounding boxes along the X axis are kept sorted from one
+// frame to the next. Since entities barely move between frames, the list is
+// nearly sorted already and insertion sort puts it back in order in close to
+// linear time. Sweeping the list then finds the boxes overlapping along X,
+// which are checked along Y.
+
+#ifndef SWEEP_AND_PRUNE_H_
+#define SWEEP_AND_PRUNE_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "poiesis/BroadPhase.h"
+
+class SweepAndPrune : public BroadPhase
+{
+  public:
+    SweepAndPrune();
+
+    std::string GetName();
+    void GetPairs(std::vector<std::pair<Entity, Entity>>& pairs);
+
+  protected:
+    void OnInsert(unsigned int id);
+    void OnMove(unsigned int id);
+    void OnRemove(unsigned int id);
+    void OnClear();
+
+  private:
+    struct Endpoint
+    {
+        float value;
+        unsigned int id;
+
+        // Insertion of the entity the endpoint was created for, telling
+        // endpoints of removed entities apart from the ones of entities
+        // inserted again with the same ID.
+        unsigned int insertion;
+
+        bool isMin;
+    };
+
+    // Checks whether an endpoint goes before another one. Starts go before
+    // ends at the same value, so touching boxes overlap as in the other
+    // broad phases.
+    static bool IsBefore(const Endpoint& endpoint1,
+        const Endpoint& endpoint2);
+
+    bool IsValid(const Endpoint& endpoint);
+
+    // Endpoints along the X axis, sorted by value.
+    std::vector<Endpoint> endpoints;
+
+    // Number of insertions of each entity ID.
+    std::vector<unsigned int> insertions;
+
+    // Whether endpoints of removed entities are still listed.
+    bool hasRemovedEndpoints;
+
+    // Entities whose start was swept but not their end, and the position of
+    // each of them in this list, indexed by entity ID.
+    std::vector<unsigned int> activeProxies;
+    std::vector<unsigned int> activePositions;
+};
+
+#endif // SWEEP_AND_PRUNE_H_
\ No newline at end of file
@@ -0,0 +1,83 @@
+// Uniform grid broad phase.
+//
+// The plane is split into square cells and each entity is listed in every
+// cell overlapped by the box bounding it. Cells are created the first time an
+// entity reaches them and are kept afterwards, so once entities have spread
+// over the level, updating the grid makes no allocations. Moving an entity
+// only touches the cells when the range of cells it overlaps changes. Cells
+// currently holding entities are listed apart, so finding pairs costs the
+// occupied cells rather than every cell ever reached.
+
+#ifndef UNIFORM_GRID_H_
+#define UNIFORM_GRID_H_
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "poiesis/BroadPhase.h"
+
+class UniformGrid : public BroadPhase
+{
+  public:
+    explicit UniformGrid(float cellSize);
+
+    std::string GetName();
+
+    // Lists each pair in the cell holding the top left corner of the overlap
+    // of their bounding boxes.
+    void GetPairs(std::vector<std::pair<Entity, Entity>>& pairs);
+
+  protected:
+    void OnInsert(unsigned int id);
+    void OnMove(unsigned int id);
+    void OnRemove(unsigned int id);
+    void OnClear();
+
+  private:
+    // Range of cells overlapped by an entity.
+    struct CellRange
+    {
+        int firstX, firstY, lastX, lastY;
+    };
+
+    struct Cell
+    {
+        int x, y;
+
+        // IDs of the entities overlapping the cell.
+        std::vector<unsigned int> proxies;
+
+        // Position of the cell in the occupied cells, valid while it holds
+        // any entity.
+        unsigned int occupiedPosition;
+    };
+
+    int GetCellCoordinate(float coordinate);
+    CellRange GetCellRange(unsigned int id);
+
+    // Gets the index of a cell, creating it if necessary.
+    unsigned int GetCell(int x, int y);
+
+    void InsertIntoCells(unsigned int id);
+    void RemoveFromCells(unsigned int id);
+
+    // Adds or removes a cell from the occupied cells.
+    void MarkOccupied(unsigned int index);
+    void MarkEmpty(unsigned int index);
+
+    float cellSize;
+
+    // Cells overlapped by each entity, indexed by entity ID.
+    std::vector<CellRange> ranges;
+
+    std::vector<Cell> cells;
+    std::unordered_map<long long, unsigned int> cellIndices;
+
+    // Indices of the cells holding at least one entity.
+    std::vector<unsigned int> occupiedCells;
+};
+
+#endif // UNIFORM_GRID_H_
@@ -19,12 +19,23 @@ class CameraComponent : public Component
     float GetHeight();
     void SetHeight(float height);
 
+    // Saves the current position as the one of the previous simulation step.
+    void SavePreviousPosition();
+
+    // Gets the position between the previous simulation step and the current
+    // one, given how far between both it is, from 0 to 1.
+    Vector GetInterpolatedPosition(float interpolation);
+
   private:
     // Holds the camera center point in 2D.
     Vector position;
 
     // Holds the camera height from the game's 2D plane.
     float height;
+
+    // Holds the camera center point of the previous simulation step.
+    Vector previousPosition;
+    bool hasPreviousPosition;
 };
 
 #endif // CAMERA_COMPONENT_H_
\ No newline at end of file
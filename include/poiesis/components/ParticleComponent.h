@@ -1,20 +1,48 @@
 // Stores particle properties, such as position, velocity and acceleration.
+//
+// The properties live in a particle store, which the component reads and
+// writes through its index, so the particle system integrates them in place.
 
 #ifndef PARTICLE_COMPONENT_H_
 #define PARTICLE_COMPONENT_H_
 
+#include <cmath>
+#include <memory>
 #include <string>
 
 #include "bandit/Engine.h"
 
+#include "poiesis/ParticleStore.h"
+
+// How a particle is moved by the particle system.
+enum BodyType
+{
+    // Never moves. Static bodies are neither integrated nor moved by
+    // collisions.
+    StaticBody,
+
+    // Moved by the forces applied to it.
+    DynamicBody,
+};
+
 class ParticleComponent : public Component
 {
   public:
     ParticleComponent(float inverseMass = 0, Vector position = Vector(0, 0),
         Vector velocity = Vector(0, 0), Vector acceleration = Vector(0, 0),
         float damping = 1, float angle = 0, float angularVelocity = 0);
+
+    // Copies hold their own particle, with the same properties.
+    ParticleComponent(const ParticleComponent& other);
+    ParticleComponent& operator=(const ParticleComponent& other);
+
+    ~ParticleComponent();
+
     std::string GetComponentClass();
 
+    // Moves the particle to the integrated store.
+    void OnStored();
+
     float GetInverseMass();
 
     Vector GetPosition();
@@ -38,33 +66,23 @@ class ParticleComponent : public Component
     float GetAngularVelocity();
     void SetAngularVelocity(float angularVelocity);
 
-  private:
-    // Holds the inverse mass of a particle, which provides inertial
-    // properties. Inverse mass is preferred since immovable particles have 0
-    // inverse mass (or infinite mass). Also, acceleration can be calculated
-    // by multiplying the inverse mass with the applied force.
-    float inverseMass;
-
-    // Holds the linear position of a particle in the world.
-    Vector position;
-
-    // Holds the linear velocity of a particle in the world.
-    Vector velocity;
+    BodyType GetBodyType();
+    void SetBodyType(BodyType bodyType);
 
-    // Holds the acceleration of a particle, such as the gravity acceleration.
-    Vector acceleration;
+    // Gets the position and angle between the previous simulation step and
+    // the current one, given how far between both they are, from 0 to 1.
+    // Static bodies and bodies with no previous step yet are where they are.
+    Vector GetInterpolatedPosition(float interpolation);
+    float GetInterpolatedAngle(float interpolation);
 
-    // Holds the damping factor to simulate velocity decay.
-    float damping;
-
-    // Holds the force applied to the particle in the current instant.
-    Vector force;
-
-    // Holds the angle of a particle in the world.
-    float angle;
+  private:
+    // Holds the store of the particle and its index there. Particles created
+    // inside the component storage are integrated by the particle system,
+    // the others are detached.
+    std::shared_ptr<ParticleStore> store;
+    unsigned int index;
 
-    // Holds the angular velocity of a particle in the world.
-    float angularVelocity;
+    BodyType bodyType;
 };
 
 #endif // PARTICLE_COMPONENT_H_
\ No newline at end of file
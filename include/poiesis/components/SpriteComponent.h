@@ -3,6 +3,7 @@
 #ifndef SPRITE_COMPONENT_H_
 #define SPRITE_COMPONENT_H_
 
+#include <memory>
 #include <string>
 
 #include "bandit/Engine.h"
@@ -55,9 +56,15 @@ class SpriteComponent : public Component
     bool GetMultipleFiles();
     void SetMultipleFiles(bool multipleFiles);
 
+    // Starts the animation at a random frame and time into it, so sprites
+    // sharing an animation don't play in lockstep.
+    void RandomizeAnimation();
+
   private:
-    // Holds the file containing the image to be displayed.
-    std::string filename;
+    // Holds the file containing the image to be displayed. Copies of the
+    // component, such as the instances of a prefab, share it, so spawning an
+    // entity does not allocate a copy of the name.
+    std::shared_ptr<const std::string> filename;
 
     // Holds the position relative to the entity to render the sprite.
     Vector position;
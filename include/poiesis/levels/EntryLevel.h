@@ -30,7 +30,7 @@ class EntryLevel : public Level
     bool PreloadImage(std::string filename);
 
   private:
-    std::shared_ptr<Entity> loading;
+    Entity loading;
     bool canCreateStartButton;
 };
 
@@ -54,8 +54,8 @@ class Level1 : public Level
     bool finished;
     bool paused;
 
-    std::shared_ptr<Entity> pauseMenuExitButton;
-    std::shared_ptr<Entity> pauseMenuButton;
+    Entity pauseMenuExitButton;
+    Entity pauseMenuButton;
 };
 
 #endif // LEVEL_1_H_
\ No newline at end of file
@@ -55,8 +55,8 @@ class Level2 : public Level
     bool finished;
     bool paused;
 
-    std::shared_ptr<Entity> pauseMenuExitButton;
-    std::shared_ptr<Entity> pauseMenuButton;
+    Entity pauseMenuExitButton;
+    Entity pauseMenuButton;
 };
 
 #endif // LEVEL_2_H_
\ No newline at end of file
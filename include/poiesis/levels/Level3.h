@@ -54,8 +54,8 @@ class Level3 : public Level
     bool win;
     bool paused;
 
-    std::shared_ptr<Entity> pauseMenuExitButton;
-    std::shared_ptr<Entity> pauseMenuButton;
+    Entity pauseMenuExitButton;
+    Entity pauseMenuButton;
 };
 
 #endif // LEVEL_3_H_
\ No newline at end of file
@@ -14,23 +14,31 @@
 class AISystem : public System
 {
   public:
+    AISystem();
+
     std::string GetName();
     void Update(float dt);
-    Vector PursueComponent(std::shared_ptr<Entity> entity,
+    Vector PursueComponent(Entity entity,
         std::string componentClass);
-    Vector FleeFromComponent(std::shared_ptr<Entity> entity,
+    Vector FleeFromComponent(Entity entity,
         std::string componentClass);
     Vector CalculateAttractionForce(Vector entityPosition,
         Vector attractionPosition);
     Vector CalculateRepulsionForce(Vector entityPosition,
         Vector repulsionPosition);
-    Vector GetEntityPosition(std::shared_ptr<Entity> entity);
-    std::shared_ptr<Entity> GetClosestEntity(
-        std::shared_ptr<Entity> referenceEntity,
-        std::vector<std::shared_ptr<Entity>> entities);
+    Vector GetEntityPosition(Entity entity);
+    Entity GetClosestEntity(
+        Entity referenceEntity,
+        const std::vector<Entity>& entities);
 
   private:
+    // Range the force driving AI entities towards their targets is drawn
+    // from.
+    static CfgFloat aiMinDrivingForce;
+    static CfgFloat aiMaxDrivingForce;
+
     float accumulatedTime;
+    Random random;
 };
 
 #endif // AI_SYSTEM_H_
\ No newline at end of file
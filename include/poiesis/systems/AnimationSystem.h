@@ -10,8 +10,16 @@
 class AnimationSystem : public System
 {
   public:
+    AnimationSystem();
+
     std::string GetName();
     void Update(float dt);
+    void UpdateSprite(std::shared_ptr<SpriteComponent> spriteComponent,
+        float dt);
+
+  private:
+    // Number of entities animated by each job.
+    static CfgInt animationGrainSize;
 };
 
 #endif // ANIMATION_SYSTEM_H_
\ No newline at end of file
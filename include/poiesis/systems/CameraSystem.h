@@ -12,8 +12,14 @@
 class CameraSystem : public System
 {
   public:
+    CameraSystem();
+
     std::string GetName();
     void Update(float dt);
+
+  private:
+    // Farthest the camera lags behind the entity it follows.
+    static CfgFloat cameraMaxDistance;
 };
 
 #endif // CAMERA_SYSTEM_H_
\ No newline at end of file
@@ -7,13 +7,18 @@
 
 #include "bandit/Engine.h"
 
+#include "poiesis/BroadPhase.h"
+#include "poiesis/ContactCache.h"
 #include "poiesis/EntityFactory.h"
-#include "poiesis/Quadtree.h"
+#include "poiesis/NarrowPhase.h"
+#include "poiesis/StaticBroadPhase.h"
 
 #include "poiesis/components/CameraComponent.h"
+#include "poiesis/components/CellParticleComponent.h"
 #include "poiesis/components/ColliderComponent.h"
 #include "poiesis/components/CombatComponent.h"
 #include "poiesis/components/ComplexityComponent.h"
+#include "poiesis/components/EatableComponent.h"
 #include "poiesis/components/GrowthComponent.h"
 #include "poiesis/components/InfectionComponent.h"
 #include "poiesis/components/ParticleComponent.h"
@@ -33,34 +38,145 @@ class CollisionSystem : public System
     void DisableComplexity();
     void Update(float dt);
     void CheckCollisions();
-    bool IsColliding(std::shared_ptr<Entity> entity1,
-        std::shared_ptr<Entity> entity2);
-    void SolveCollision(std::shared_ptr<Entity> entity1,
-        std::shared_ptr<Entity> entity2);
-    void CollideBodies(std::shared_ptr<Entity> entity1,
-        std::shared_ptr<Entity> entity2);
-    void CombatEntities(std::shared_ptr<Entity> entity1,
-        std::shared_ptr<Entity> entity2);
-    bool ReproduceEntities(std::shared_ptr<Entity> entity1,
-        std::shared_ptr<Entity> entity2);
-    void IncorporateEntity(std::shared_ptr<Entity> eaterEntity,
-        std::shared_ptr<Entity> eatableEntity);
-    void EatEntity(std::shared_ptr<Entity> eaterEntity,
-        std::shared_ptr<Entity> eatableEntity);
-    void DestroyEntity(std::shared_ptr<Entity> entity);
-    void SlowEntity(std::shared_ptr<Entity> slowingEntity,
-        std::shared_ptr<Entity> movingEntity);
-    void VitaminateEntity(std::shared_ptr<Entity> vitamineEntity,
-        std::shared_ptr<Entity> growingEntity);
-    void EmitParticles(std::shared_ptr<Entity> entity);
-    bool TransmitInfection(std::shared_ptr<Entity> transmitterEntity,
-        std::shared_ptr<Entity> receiverEntity);
+    bool UpdateContact(Contact& contact);
+    void SolveCollision(const Contact& contact,
+        bool beginning);
+    void CollideBodies(const Contact& contact);
+    void CombatEntities(Entity entity1,
+        Entity entity2, const Contact& contact);
+    bool ReproduceEntities(Entity entity1,
+        Entity entity2);
+    void IncorporateEntity(Entity eaterEntity,
+        Entity eatableEntity);
+    void EatEntity(Entity eaterEntity,
+        Entity eatableEntity);
+    void DestroyEntity(Entity entity);
+    void SlowEntity(Entity slowingEntity,
+        Entity movingEntity);
+    void VitaminateEntity(Entity vitamineEntity,
+        Entity growingEntity);
+    void EmitParticles(Entity entity);
+    bool TransmitInfection(Entity transmitterEntity,
+        Entity receiverEntity);
 
   private:
+    // Entities farther from the camera than the maximum distance are not
+    // tested, and contacts are found by jobs of the grain size.
+    static CfgFloat collisionMaxDistance;
+    static CfgInt collisionGrainSize;
+
+    // Farthest cells reproduce from each other, and force of the particles
+    // complex cells emit.
+    static CfgFloat reproductionDistanceMax;
+    static CfgFloat complexityParticleEmitForce;
+
+    // Sounds played and sprites given to cells when they eat or get
+    // infected.
+    static CfgPath eatSoundEffect;
+    static CfgPath frozenSoundEffect;
+    static CfgPath impulsesSoundEffect;
+    static CfgPath cellFrozenImage;
+    static CfgFloat cellFrozenScale;
+    static CfgPath cellErracticImage;
+    static CfgFloat cellErracticRotationSpeed;
+    static CfgFloat cellErracticScale;
+    static CfgPath cellCannotEatImage;
+    static CfgFloat cellCannotEatScale;
+
+    // Roles an entity plays when colliding, one for each component class
+    // that matters when solving collisions.
+    enum Role
+    {
+        ReproductionRole = 1 << 0,
+        ComplexityRole = 1 << 1,
+        InfectionRole = 1 << 2,
+        CellParticleRole = 1 << 3,
+        GrowthRole = 1 << 4,
+        EatableRole = 1 << 5,
+        CombatRole = 1 << 6,
+        SlowingRole = 1 << 7,
+        ParticleRole = 1 << 8,
+        VitaminRole = 1 << 9,
+    };
+
+    static const unsigned int NUMBER_OF_ROLE_SETS = 1 << 10;
+
+    // Final outcome of a collision.
+    enum Action
+    {
+        IncorporateAction,
+        EatAction,
+        CombatAction,
+        SlowAction,
+        VitaminateAction,
+        IgnoreAction,
+        BounceAction,
+    };
+
+    // How to solve a collision between entities with two given sets of
+    // roles. Reproduction and infection are tried first and, when they
+    // succeed, the action is skipped. Particles are emitted and infections
+    // transmitted, from whichever entity carries them, only when the
+    // collision begins, while reproduction and the action are tried in every
+    // frame the entities overlap, since area effects are applied at a rate
+    // per frame.
+    struct CollisionHandler
+    {
+        bool reproduce;
+        bool emitParticles;
+        bool transmitInfection;
+        Action action;
+
+        // Whether the action takes the entities in reverse order.
+        bool swapped;
+    };
+
+    // Gets the roles of an entity.
+    unsigned int GetRoles(Entity entity);
+
+    // Gets the index of a set of roles in the handler table, adding the set
+    // to the table if necessary.
+    unsigned int GetRoleSetIndex(unsigned int roles);
+
+    static CollisionHandler CreateHandler(unsigned int roles1,
+        unsigned int roles2);
+
     bool reproductionEnabled;
     bool complexityEnabled;
-    std::vector<std::shared_ptr<Entity>> collidableEntities;
-    std::vector<unsigned int> deletedEntities;
+
+    // Broad phase kept between frames, chosen by COLLISION_BROAD_PHASE.
+    std::unique_ptr<BroadPhase> broadPhase;
+
+    // Broad phase holding static bodies, and the other entities updated in
+    // the broad phase this frame.
+    StaticBroadPhase staticBroadPhase;
+    std::vector<Entity> movingEntities;
+
+    NarrowPhase narrowPhase;
+
+    // Pairs of entities that may collide and the ones actually colliding
+    // before solving any collision.
+    std::vector<std::pair<Entity, Entity>> pairs;
+    std::vector<Contact> contacts;
+
+    // Contacts found in the previous frame and collision events waiting to
+    // be solved.
+    ContactCache contactCache;
+    RingBuffer<CollisionEvent> events;
+
+    // Whether each entity was moved by a collision this frame, indexed by
+    // entity ID.
+    std::vector<char> movedEntities;
+
+    // Handlers for each pair of role sets seen so far, the index of each role
+    // set in the table and the role set at each index.
+    std::vector<CollisionHandler> handlers;
+    std::vector<int> roleSetIndices;
+    std::vector<unsigned int> roleSets;
+
+    // Index of the role set of each entity in the broad phase this frame,
+    // indexed by entity ID.
+    std::vector<unsigned int> entityRoleSets;
 };
 
 #endif // COLLISION_SYSTEM_H_
\ No newline at end of file
@@ -11,6 +11,8 @@
 class CombatPowerSystem : public System
 {
   public:
+    CombatPowerSystem();
+
     std::string GetName();
     void Update(float dt);
 };
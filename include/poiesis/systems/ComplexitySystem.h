@@ -15,17 +15,28 @@
 class ComplexitySystem : public System
 {
   public:
+    ComplexitySystem();
     std::string GetName();
     void Update(float dt);
     void ConsumeEnergy(std::shared_ptr<GrowthComponent> growthComponent);
-    void AdjustComplexityParticleDistance(std::shared_ptr<Entity> entity,
+    void AdjustComplexityParticleDistance(Entity entity,
         std::shared_ptr<GrowthComponent> growthComponent);
-    bool KillEntityWithoutEnergy(std::shared_ptr<Entity> entity,
+    bool KillEntityWithoutEnergy(Entity entity,
         std::shared_ptr<GrowthComponent> growthComponent);
-    void EmitParticle(std::shared_ptr<Entity> entity);
+    void EmitParticle(Entity entity);
 
   private:
+    // How often complex cells may lose energy and how likely they are to,
+    // the energy beyond which they die and below which they emit a particle,
+    // and the force the particle is emitted with.
+    static CfgFloat complexityEnergyConsumingPeriod;
+    static CfgFloat complexityEnergyConsumingChance;
+    static CfgInt complexityMaximumEnergy;
+    static CfgInt complexityMinimumEnergy;
+    static CfgFloat complexityParticleEmitForce;
+
     Timer timer;
+    Random random;
 };
 
 #endif // COMPLEXITY_SYSTEM_H_
\ No newline at end of file
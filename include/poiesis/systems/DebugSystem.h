@@ -3,10 +3,14 @@
 #ifndef DEBUG_SYSTEM_H_
 #define DEBUG_SYSTEM_H_
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "bandit/Engine.h"
+#include "bandit/core/Allocations.h"
 
 #include "poiesis/components/CombatComponent.h"
 #include "poiesis/components/ComplexityComponent.h"
@@ -24,11 +28,25 @@ class DebugSystem : public System
     void GenerateFPSMessage();
     void GenerateEngineMessage();
     void GeneratePlayerMessage();
+    void GenerateProfilerMessage();
 
   private:
+    // Font, size and position of the debug messages, and number of profiler
+    // zones listed.
+    static CfgPath fontFile;
+    static CfgInt debugMessageSize;
+    static CfgInt debugMessageX;
+    static CfgInt debugMessageY;
+    static CfgInt debugProfilerZones;
+
     PeriodicTimer timer;
     float currentTime;
     float currentFps;
+
+    // Allocations counted when the last frame started and during it.
+    unsigned long numberOfAllocations;
+    unsigned long frameAllocations;
+
     std::vector<std::string> messages;
 };
 
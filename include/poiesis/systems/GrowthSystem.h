@@ -12,19 +12,21 @@
 class GrowthSystem : public System
 {
   public:
+    GrowthSystem();
+
     std::string GetName();
     void Update(float dt);
     void ConsumeEnergy(std::shared_ptr<GrowthComponent> growthComponent);
     void UpdateGrowthPower(std::shared_ptr<GrowthComponent> growthComponent);
     int CalculateGrowthDelta(std::shared_ptr<GrowthComponent> growthComponent);
-    void GrowOrShrink(std::shared_ptr<Entity> entity,
+    void GrowOrShrink(Entity entity,
         std::shared_ptr<GrowthComponent> growthComponent);
-    void Grow(std::shared_ptr<Entity> entity,
+    void Grow(Entity entity,
         std::shared_ptr<GrowthComponent> growthComponent);
-    void Shrink(std::shared_ptr<Entity> entity,
+    void Shrink(Entity entity,
         std::shared_ptr<GrowthComponent> growthComponent);
     void SaturateLevel(std::shared_ptr<GrowthComponent> growthComponent); // This should be moved to Math
-    bool KillSmallEntity(std::shared_ptr<Entity> entity,
+    bool KillSmallEntity(Entity entity,
         std::shared_ptr<GrowthComponent> growthComponent);
     void UpdateCollisionRadius(
         std::shared_ptr<GrowthComponent> growthComponent,
@@ -36,7 +38,26 @@ class GrowthSystem : public System
         std::shared_ptr<GrowthComponent> growthComponent);
 
   private:
+    // How often cells may lose energy and how likely they are to, the
+    // energy levels and the growth power each one adds, and the growth power
+    // and level limits.
+    static CfgFloat growthEnergyConsumingPeriod;
+    static CfgFloat growthEnergyConsumingChance;
+    static CfgInt growthEnergyLevelFastShrink;
+    static CfgInt growthEnergyLevelShrink;
+    static CfgInt growthEnergyLevelStagnation;
+    static CfgInt growthEnergyLevelGrow;
+    static CfgInt growthDeltaFastShrink;
+    static CfgInt growthDeltaShrink;
+    static CfgInt growthDeltaStagnation;
+    static CfgInt growthDeltaGrow;
+    static CfgInt growthDeltaFastGrow;
+    static CfgInt growthUpperThreshold;
+    static CfgInt growthLowerThreshold;
+    static CfgInt growthLevelLimit;
+
     Timer timer;
+    Random random;
 };
 
 #endif // GROWTH_SYSTEM_H_
\ No newline at end of file
@@ -11,12 +11,27 @@
 class InfectionSystem : public System
 {
   public:
+    InfectionSystem();
     void SetLevel3(bool isLevel3);
     std::string GetName();
     void Update(float dt);
 
   private:
+    // Force of the impulses of infected cells.
+    static CfgFloat infectionImpulsesForce;
+
+    // Sprites given back to cells once their temporary infection ends.
+    static CfgPath cellAnimation;
+    static CfgFloat cellAnimationScale;
+    static CfgInt cellAnimationNumFrames;
+    static CfgFloat cellAnimationFrameDuration;
+    static CfgPath reproductionMaturingAnimation;
+    static CfgFloat reproductionMaturingRotationSpeed;
+    static CfgFloat reproductionMaturingScale;
+    static CfgInt reproductionMaturingNumFrames;
+
     bool isLevel3;
+    Random random;
 };
 
 #endif // INFECTION_SYSTEM_H_
\ No newline at end of file
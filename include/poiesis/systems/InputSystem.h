@@ -26,6 +26,13 @@ class InputSystem : public System
     bool ProcessParticleForceInput();
 
   private:
+    // Size of the window, whose center shows the camera, and period and
+    // magnitude of the force the mouse applies to moveable entities.
+    static CfgInt windowWidth;
+    static CfgInt windowHeight;
+    static CfgFloat inputPeriod;
+    static CfgFloat inputForceMagnitude;
+
     Vector impulse;
     Vector impulseBegin;
     Vector impulseEnd;
@@ -3,18 +3,34 @@
 #ifndef PARTICLE_SYSTEM_H_
 #define PARTICLE_SYSTEM_H_
 
+#include <memory>
+
 #include "bandit/Engine.h"
 
+#include "poiesis/ParticleStore.h"
+
 #include "poiesis/components/ParticleComponent.h"
 
 class ParticleSystem : public System
 {
   public:
+    ParticleSystem();
+
     std::string GetName();
     void Update(float dt);
-    void UpdateParticleProperties(
-        std::shared_ptr<ParticleComponent> particleComponent, float dt);
-    Vector GenerateRandomForce();
+
+  private:
+    // Magnitude of the random force pushing every dynamic body, and number
+    // of particles integrated by each job.
+    static CfgFloat particleRandomForceMag;
+    static CfgInt particleGrainSize;
+
+    // Store of the particles created inside the component storage.
+    std::shared_ptr<ParticleStore> store;
+
+    // Stream random forces are drawn from, split by update and range.
+    uint64_t randomStream;
+    uint64_t numberOfUpdates;
 };
 
 #endif // PARTICLE_SYSTEM_H_
\ No newline at end of file
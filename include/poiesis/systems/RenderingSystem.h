@@ -16,17 +16,26 @@
 class RenderingSystem : public System
 {
   public:
+    RenderingSystem();
     std::string GetName();
     void Update(float dt);
     Vector CalculateScreenOffset();
     Vector CalculateCameraOffset();
     float GetCameraHeight();
-    void RenderParticle(std::shared_ptr<Entity> entity, Vector cameraPosition,
+    void RenderParticle(Entity entity, Vector cameraPosition,
         float cameraHeight);
-    void RenderGUI(std::shared_ptr<Entity> entity);
-    void RenderSprite(std::shared_ptr<Entity> entity,
+    void RenderGUI(Entity entity);
+    void RenderSprite(Entity entity,
         std::shared_ptr<SpriteComponent> spriteComponent, Vector position,
         float height = 1);
+
+  private:
+    // Size of the window, whose center shows the camera, and distance from
+    // the camera beyond which entities are not rendered, relative to its
+    // height.
+    static CfgInt windowWidth;
+    static CfgInt windowHeight;
+    static CfgFloat renderingMaxDistance;
 };
 
 #endif // RENDERING_SYSTEM_H_
\ No newline at end of file
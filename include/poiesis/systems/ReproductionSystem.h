@@ -13,12 +13,21 @@
 class ReproductionSystem : public System
 {
   public:
+    ReproductionSystem();
+
     std::string GetName();
     void Update(float dt);
     void ConsumeEnergy(std::shared_ptr<GrowthComponent> growthComponent);
 
   private:
+    // How often cells may lose energy and how likely they are to, and the
+    // energy at which level 3 cells reproduce.
+    static CfgFloat reproductionEnergyConsumingPeriod;
+    static CfgFloat reproductionEnergyConsumingChance;
+    static CfgInt level3MaxEnergy;
+
     Timer timer;
+    Random random;
 };
 
 #endif // REPRODUCTION_SYSTEM_H_
\ No newline at end of file
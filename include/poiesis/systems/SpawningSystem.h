@@ -37,6 +37,12 @@ class SpawningSystem : public System
     void SpawnVirus();
 
   private:
+    // Bounds of level 1 new entities are spawned within.
+    static CfgFloat level1MinX;
+    static CfgFloat level1MaxX;
+    static CfgFloat level1MinY;
+    static CfgFloat level1MaxY;
+
     SpawningType spawningType;
     float spawningChance;
     PeriodicTimer timer;
@@ -31,6 +31,11 @@ std::shared_ptr<LevelManager> Engine::GetLevelManager()
     return levelManager;
 }
 
+std::shared_ptr<JobSystem> Engine::GetJobSystem()
+{
+    return jobSystem;
+}
+
 void Engine::Initialize(
     std::shared_ptr<SystemAdapter> systemAdapter,
     std::shared_ptr<TimerAdapter> timerAdapter,
@@ -40,7 +45,8 @@ void Engine::Initialize(
     std::shared_ptr<InputAdapter> inputAdapter,
     std::shared_ptr<EntityManager> entityManager,
     std::shared_ptr<LevelManager> levelManager,
-    std::shared_ptr<SystemManager> systemManager)
+    std::shared_ptr<SystemManager> systemManager,
+    std::shared_ptr<JobSystem> jobSystem)
 {
     LOG_D("[Engine] Initializing engine");
     this->systemAdapter = systemAdapter;
@@ -52,6 +58,10 @@ void Engine::Initialize(
     this->entityManager = entityManager;
     this->levelManager = levelManager;
     this->systemManager = systemManager;
+    this->jobSystem = jobSystem;
+
+    systemManager->SetJobSystem(jobSystem);
+    framePacer = std::make_shared<FramePacer>(timerAdapter);
 
     systemAdapter->Initialize();
 }
@@ -121,6 +131,98 @@ void Engine::CreateWindow(std::string title, int height, int width)
     graphicsAdapter->CreateWindow(title, height, width);
 }
 
+void Engine::SetRandomSeed(uint64_t seed)
+{
+    if (seed == 0)
+    {
+        seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        LOG_I("[Engine] Random seed: " << seed);
+    }
+
+    Random::SetSeed(seed);
+}
+
+uint64_t Engine::GetRandomSeed()
+{
+    return Random::GetSeed();
+}
+
+void Engine::SetTimeStep(float timeStep)
+{
+    if (timeStep <= 0)
+    {
+        LOG_E("[Engine] Time step must be positive.");
+        exit(1);
+    }
+
+    this->timeStep = timeStep;
+}
+
+float Engine::GetTimeStep()
+{
+    return timeStep;
+}
+
+void Engine::SetMaxStepsPerFrame(unsigned int maxStepsPerFrame)
+{
+    if (maxStepsPerFrame == 0)
+    {
+        LOG_E("[Engine] Maximum number of steps per frame must be positive.");
+        exit(1);
+    }
+
+    this->maxStepsPerFrame = maxStepsPerFrame;
+}
+
+void Engine::SetTargetFrameRate(float frameRate)
+{
+    framePacer->SetTargetFrameRate(frameRate);
+}
+
+FrameStats Engine::GetFrameStats()
+{
+    return framePacer->GetStats();
+}
+
+float Engine::GetInterpolation()
+{
+    return interpolation;
+}
+
+void Engine::RecordReplay(std::string file)
+{
+    ReplayHeader header;
+    header.seed = Random::GetSeed();
+    header.timeStep = timeStep;
+    header.configuration = ConfigParser::GetInstance().GetEntries();
+
+    inputAdapter = std::make_shared<RecordingInputAdapter>(inputAdapter, file,
+        header);
+
+    LOG_I("[Engine] Recording replay " << file);
+}
+
+void Engine::PlayReplay(std::string file)
+{
+    auto replayInputAdapter = std::make_shared<ReplayInputAdapter>(
+        inputAdapter, file);
+    const ReplayHeader& header = replayInputAdapter->GetHeader();
+
+    // Special keys, such as the resources path, depend on the machine the
+    // replay was recorded on rather than on the session.
+    for (auto& entry : header.configuration)
+    {
+        if (entry.first.empty() || entry.first[0] != '$')
+            ConfigParser::GetInstance().Set(entry.first, entry.second);
+    }
+
+    SetRandomSeed(header.seed);
+    SetTimeStep(header.timeStep);
+    inputAdapter = replayInputAdapter;
+
+    LOG_I("[Engine] Playing replay " << file << " with seed " << header.seed);
+}
+
 void Engine::SetCurrentLevel(std::shared_ptr<Level> level)
 {
     levelManager->SetCurrentLevel(level);
@@ -131,22 +233,48 @@ void Engine::SetNextLevel(std::shared_ptr<Level> level)
     levelManager->SetNextLevel(level);
 }
 
-std::shared_ptr<Entity> Engine::CreateEntity()
+Entity Engine::CreateEntity()
 {
     return entityManager->CreateEntity();
 }
 
-void Engine::DeleteEntity(std::shared_ptr<Entity> entity)
+Entity Engine::Instantiate(const Prefab& prefab)
+{
+    return prefab.Instantiate(*entityManager);
+}
+
+std::vector<Entity> Engine::Instantiate(const Prefab& prefab,
+    unsigned int numberOfEntities)
+{
+    return prefab.Instantiate(*entityManager, numberOfEntities);
+}
+
+void Engine::DeleteEntity(Entity entity)
 {
     entityManager->DeleteEntity(entity);
 }
 
+void Engine::DeleteEntityDeferred(Entity entity)
+{
+    entityManager->DeleteEntityDeferred(entity);
+}
+
+bool Engine::IsAlive(Entity entity)
+{
+    return entityManager->IsAlive(entity);
+}
+
+bool Engine::IsDeleted(Entity entity)
+{
+    return entityManager->IsDeleted(entity);
+}
+
 void Engine::DeleteEntitiesWithComponentsOfClass(std::string componentClass)
 {
     entityManager->DeleteEntitiesWithComponentsOfClass(componentClass);
 }
 
-void Engine::DeleteComponentsOfClass(std::shared_ptr<Entity> entity,
+void Engine::DeleteComponentsOfClass(Entity entity,
     std::string componentClass)
 {
     entityManager->DeleteComponentsOfClass(entity, componentClass);
@@ -157,13 +285,13 @@ void Engine::ClearEntities()
     entityManager->Clear();
 }
 
-std::vector<std::shared_ptr<Entity>> Engine::GetAllEntitiesWithComponentOfClass(
+const std::vector<Entity>& Engine::GetAllEntitiesWithComponentOfClass(
     std::string componentClass)
 {
     return entityManager->GetAllEntitiesWithComponentOfClass(componentClass);
 }
 
-std::shared_ptr<Entity> Engine::GetEntityWithComponentOfClass(
+Entity Engine::GetEntityWithComponentOfClass(
     std::string componentClass)
 {
     return entityManager->GetEntityWithComponentOfClass(componentClass);
@@ -180,19 +308,31 @@ bool Engine::HasEntityWithComponentOfClass(std::string componentClass)
 }
 
 void Engine::AddComponent(std::shared_ptr<Component> component,
-    std::shared_ptr<Entity> entity)
+    Entity entity)
 {
     entityManager->AddComponent(component, entity);
 }
 
+void Engine::AddComponentDeferred(std::shared_ptr<Component> component,
+    Entity entity)
+{
+    entityManager->AddComponentDeferred(component, entity);
+}
+
+void Engine::DeleteComponentsOfClassDeferred(Entity entity,
+    std::string componentClass)
+{
+    entityManager->DeleteComponentsOfClassDeferred(entity, componentClass);
+}
+
 std::vector<std::shared_ptr<Component>> Engine::GetComponentsOfClass(
-    std::shared_ptr<Entity> entity, std::string componentClass)
+    Entity entity, std::string componentClass)
 {
     return entityManager->GetComponentsOfClass(entity, componentClass);
 }
 
 std::shared_ptr<Component> Engine::GetSingleComponentOfClass(
-    std::shared_ptr<Entity> entity, std::string componentClass)
+    Entity entity, std::string componentClass)
 {
     return entityManager->GetSingleComponentOfClass(entity, componentClass);
 }
@@ -203,7 +343,7 @@ std::vector<std::shared_ptr<Component>> Engine::GetAllComponentsOfClass(
     return entityManager->GetAllComponentsOfClass(componentClass);
 }
 
-bool Engine::HasComponent(std::shared_ptr<Entity> entity,
+bool Engine::HasComponent(Entity entity,
     std::string componentClass)
 {
     return entityManager->HasComponent(entity, componentClass);
@@ -236,59 +376,94 @@ Vector Engine::GetMousePosition()
     return Vector(mouseX, mouseY);
 }
 
-float Engine::CalculateSleepTime(float currentFrameRate)
+bool Engine::Step()
 {
-    static const float DESIRED_FRAME_RATE = 30;
-    static const float DECREASE_FACTOR = 5;
-    static const float INCREASE_FACTOR = 0.001;
-    static float sleepDuration = 1/DESIRED_FRAME_RATE;
+    PROFILE_ZONE("Step");
+
+    {
+        PROFILE_ZONE("Input");
+        inputAdapter->ProcessInputs();
+    }
 
-    // AIMD control law:
-    // Additive when increasing sleep duration (hence, reducing frame rate).
-    // This is important to get better PC performance by returning control to
-    // the CPU.
-    // Multiplicative when decreasing sleep duration (hence, increasing frame
-    // rate) to quickly recover from frame rate drop.
-    if (currentFrameRate < DESIRED_FRAME_RATE)
-        sleepDuration /= DECREASE_FACTOR;
-    else if (currentFrameRate > DESIRED_FRAME_RATE)
-        sleepDuration += INCREASE_FACTOR;
+    if (inputAdapter->CheckInputOccurred(InputType::QuitButtonPress))
+    {
+        LOG_I("[Engine] Quit requested");
+        return false;
+    }
+
+    {
+        PROFILE_ZONE("Simulate");
+        systemManager->Simulate(timeStep);
+    }
+
+    // Entity changes deferred by systems are applied once all of them
+    // have been updated.
+    {
+        PROFILE_ZONE("DeferredCommands");
+        entityManager->ApplyDeferredCommands();
+    }
+
+    {
+        PROFILE_ZONE("LevelUpdate");
+        levelManager->Update();
+    }
+
+    if (levelManager->HasFinished())
+    {
+        LOG_I("[Engine] Finished game");
+        return false;
+    }
 
-    return sleepDuration;
+    return true;
 }
 
 void Engine::Run()
 {
     float dt;
-    float currentFrameRate;
-    float sleepDuration;
+    float accumulator = 0;
+    unsigned int steps;
+
+    framePacer->Start();
 
     while (true)
     {
-        dt = timerAdapter->GetElapsedTime();
-        currentFrameRate = 1/dt;
+        dt = framePacer->BeginFrame();
         
-        LOG_I("[Engine] Frame rate: " << currentFrameRate);
+        LOG_D("[Engine] Frame rate: " << 1/dt);
         LOG_D("[Engine] Elapsed time: " << dt);
 
-        inputAdapter->ProcessInputs();
-        if (inputAdapter->CheckInputOccurred(InputType::QuitButtonPress))
+        // The simulation catches up with the elapsed time in steps of fixed
+        // length. Inputs are processed once per step, so each step sees the
+        // inputs exactly once, however many steps a frame runs.
+        accumulator += dt;
+
+        for (steps = 0; accumulator >= timeStep && steps < maxStepsPerFrame; ++steps)
         {
-            LOG_I("[Engine] Quit requested");
-            break;
+            if (!Step())
+                return;
+
+            accumulator -= timeStep;
         }
 
-        systemManager->Update(dt);
-        levelManager->Update();
+        // Time the simulation could not catch up with is dropped.
+        if (accumulator >= timeStep)
+        {
+            LOG_D("[Engine] Dropped " << accumulator << "s of simulation");
+            accumulator = std::fmod(accumulator, timeStep);
+        }
+
+        interpolation = accumulator/timeStep;
+
+        {
+            PROFILE_ZONE("Present");
+            systemManager->Present(dt);
+        }
 
-        if (levelManager->HasFinished())
         {
-            LOG_I("[Engine] Finished game");
-            break;
+            PROFILE_ZONE("Sleep");
+            framePacer->EndFrame();
         }
 
-        sleepDuration = CalculateSleepTime(currentFrameRate);
-        LOG_D("Sleep duration: " << sleepDuration);
-        timerAdapter->Sleep(sleepDuration);
+        Profiler::GetInstance().Collect();
     }
 }
\ No newline at end of file
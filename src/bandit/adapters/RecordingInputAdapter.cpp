@@ -0,0 +1,41 @@
+#include "bandit/adapters/RecordingInputAdapter.h"
+
+RecordingInputAdapter::RecordingInputAdapter(
+    std::shared_ptr<InputAdapter> adapter, std::string file,
+    const ReplayHeader& header) :
+    adapter(adapter)
+{
+    replayFile.Create(file, header);
+}
+
+int RecordingInputAdapter::GetMouseX()
+{
+    return adapter->GetMouseX();
+}
+
+int RecordingInputAdapter::GetMouseY()
+{
+    return adapter->GetMouseY();
+}
+
+void RecordingInputAdapter::ProcessInputs()
+{
+    adapter->ProcessInputs();
+
+    frame.mouseX = adapter->GetMouseX();
+    frame.mouseY = adapter->GetMouseY();
+    frame.inputs = adapter->GetOccurredInputs();
+    replayFile.WriteFrame(frame);
+}
+
+bool RecordingInputAdapter::CheckInputOccurred(InputType::Type inputType,
+    int button)
+{
+    return adapter->CheckInputOccurred(inputType, button);
+}
+
+const std::vector<std::pair<InputType::Type, int>>&
+    RecordingInputAdapter::GetOccurredInputs()
+{
+    return adapter->GetOccurredInputs();
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "bandit/adapters/ReplayFile.h"
+
+const char ReplayFile::MAGIC[4] = {'B', 'R', 'P', 'L'};
+
+ReplayFile::ReplayFile() :
+    mouseX(0), mouseY(0)
+{
+}
+
+ReplayFile::~ReplayFile()
+{
+    Close();
+}
+
+void ReplayFile::Create(std::string file, const ReplayHeader& header)
+{
+    uint32_t timeStep;
+
+    stream.open(file, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!stream.is_open())
+    {
+        LOG_E("[ReplayFile] Could not create file: " << file);
+        exit(1);
+    }
+
+    std::memcpy(&timeStep, &header.timeStep, sizeof(timeStep));
+
+    stream.write(MAGIC, sizeof(MAGIC));
+    WriteInteger(VERSION);
+    WriteInteger(header.seed);
+    WriteInteger(timeStep);
+    WriteInteger(header.configuration.size());
+
+    for (auto& entry : header.configuration)
+    {
+        WriteString(entry.first);
+        WriteString(entry.second);
+    }
+
+    stream.flush();
+    mouseX = 0;
+    mouseY = 0;
+}
+
+void ReplayFile::Open(std::string file, ReplayHeader& header)
+{
+    char magic[sizeof(MAGIC)];
+    uint64_t version, timeStep, numberOfEntries;
+
+    stream.open(file, std::ios::in | std::ios::binary);
+
+    if (!stream.is_open())
+    {
+        LOG_E("[ReplayFile] Could not open file: " << file);
+        exit(1);
+    }
+
+    if (!stream.read(magic, sizeof(magic))
+        || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        LOG_E("[ReplayFile] Not a replay file: " << file);
+        exit(1);
+    }
+
+    if (!ReadInteger(version) || version != VERSION)
+    {
+        LOG_E("[ReplayFile] Unsupported replay version in file: " << file);
+        exit(1);
+    }
+
+    header.configuration.clear();
+
+    if (!ReadInteger(header.seed) || !ReadInteger(timeStep)
+        || !ReadInteger(numberOfEntries))
+    {
+        LOG_E("[ReplayFile] Truncated header in file: " << file);
+        exit(1);
+    }
+
+    uint32_t timeStepBits = timeStep;
+    std::memcpy(&header.timeStep, &timeStepBits, sizeof(header.timeStep));
+
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        std::pair<std::string, std::string> entry;
+
+        if (!ReadString(entry.first) || !ReadString(entry.second))
+        {
+            LOG_E("[ReplayFile] Truncated header in file: " << file);
+            exit(1);
+        }
+
+        header.configuration.push_back(entry);
+    }
+
+    mouseX = 0;
+    mouseY = 0;
+}
+
+void ReplayFile::Close()
+{
+    if (stream.is_open())
+        stream.close();
+}
+
+void ReplayFile::WriteFrame(const ReplayFrame& frame)
+{
+    WriteSignedInteger(frame.mouseX - mouseX);
+    WriteSignedInteger(frame.mouseY - mouseY);
+    WriteInteger(frame.inputs.size());
+
+    for (auto& input : frame.inputs)
+    {
+        WriteInteger(input.first);
+        WriteInteger(input.second);
+    }
+
+    stream.flush();
+    mouseX = frame.mouseX;
+    mouseY = frame.mouseY;
+}
+
+bool ReplayFile::ReadFrame(ReplayFrame& frame)
+{
+    int64_t deltaX, deltaY;
+    uint64_t numberOfInputs, type, button;
+
+    if (!ReadSignedInteger(deltaX) || !ReadSignedInteger(deltaY)
+        || !ReadInteger(numberOfInputs))
+        return false;
+
+    frame.inputs.clear();
+
+    for (uint64_t i = 0; i < numberOfInputs; ++i)
+    {
+        if (!ReadInteger(type) || !ReadInteger(button))
+            return false;
+
+        frame.inputs.push_back(std::make_pair(
+            static_cast<InputType::Type>(type), static_cast<int>(button)));
+    }
+
+    mouseX += deltaX;
+    mouseY += deltaY;
+    frame.mouseX = mouseX;
+    frame.mouseY = mouseY;
+
+    return true;
+}
+
+void ReplayFile::WriteInteger(uint64_t value)
+{
+    // Seven bits per byte, with the high bit set on all bytes but the last.
+    while (value >= 0x80)
+    {
+        stream.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+
+    stream.put(static_cast<char>(value));
+}
+
+void ReplayFile::WriteSignedInteger(int64_t value)
+{
+    // Zigzag encoding keeps small negative values short.
+    WriteInteger((static_cast<uint64_t>(value) << 1) ^ (value < 0 ? ~0ULL : 0));
+}
+
+void ReplayFile::WriteString(const std::string& value)
+{
+    WriteInteger(value.size());
+    stream.write(value.data(), value.size());
+}
+
+bool ReplayFile::ReadInteger(uint64_t& value)
+{
+    char byte;
+    unsigned int shift = 0;
+
+    value = 0;
+
+    while (shift < 64 && stream.get(byte))
+    {
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+
+        shift += 7;
+    }
+
+    return false;
+}
+
+bool ReplayFile::ReadSignedInteger(int64_t& value)
+{
+    uint64_t encoded;
+
+    if (!ReadInteger(encoded))
+        return false;
+
+    value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+    return true;
+}
+
+bool ReplayFile::ReadString(std::string& value)
+{
+    uint64_t size;
+
+    if (!ReadInteger(size))
+        return false;
+
+    value.resize(size);
+
+    return size == 0 || static_cast<bool>(stream.read(&value[0], size));
+}
\ No newline at end of file
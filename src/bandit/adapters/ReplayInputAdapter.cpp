@@ -0,0 +1,59 @@
+#include "bandit/adapters/ReplayInputAdapter.h"
+
+ReplayInputAdapter::ReplayInputAdapter(std::shared_ptr<InputAdapter> adapter,
+    std::string file) :
+    adapter(adapter), numberOfFrames(0)
+{
+    replayFile.Open(file, header);
+
+    frame.mouseX = 0;
+    frame.mouseY = 0;
+}
+
+const ReplayHeader& ReplayInputAdapter::GetHeader()
+{
+    return header;
+}
+
+int ReplayInputAdapter::GetMouseX()
+{
+    return frame.mouseX;
+}
+
+int ReplayInputAdapter::GetMouseY()
+{
+    return frame.mouseY;
+}
+
+void ReplayInputAdapter::ProcessInputs()
+{
+    adapter->ProcessInputs();
+
+    if (!replayFile.ReadFrame(frame))
+    {
+        LOG_I("[ReplayInputAdapter] Replay finished after " << numberOfFrames
+            << " frames");
+        frame.inputs.clear();
+        frame.inputs.push_back(std::make_pair(InputType::QuitButtonPress, 0));
+        return;
+    }
+
+    ++numberOfFrames;
+
+    if (adapter->CheckInputOccurred(InputType::QuitButtonPress))
+        frame.inputs.push_back(std::make_pair(InputType::QuitButtonPress, 0));
+}
+
+bool ReplayInputAdapter::CheckInputOccurred(InputType::Type inputType,
+    int button)
+{
+    std::pair<InputType::Type, int> input = std::make_pair(inputType, button);
+
+    return (std::find(frame.inputs.begin(), frame.inputs.end(), input) != frame.inputs.end());
+}
+
+const std::vector<std::pair<InputType::Type, int>>&
+    ReplayInputAdapter::GetOccurredInputs()
+{
+    return frame.inputs;
+}
\ No newline at end of file
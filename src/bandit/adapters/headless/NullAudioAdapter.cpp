@@ -0,0 +1,25 @@
+#include "bandit/adapters/headless/NullAudioAdapter.h"
+
+void NullAudioAdapter::Load(std::string file)
+{
+    audios.insert(file);
+}
+
+void NullAudioAdapter::Unload(std::string file)
+{
+    audios.erase(file);
+}
+
+bool NullAudioAdapter::IsLoaded(std::string file)
+{
+    return (audios.find(file) != audios.end());
+}
+
+void NullAudioAdapter::Play(std::string file, int)
+{
+    Load(file);
+}
+
+void NullAudioAdapter::Stop(std::string)
+{
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "bandit/adapters/headless/NullGraphicsAdapter.h"
+
+NullGraphicsAdapter::NullGraphicsAdapter() :
+    numberOfRenderings(0)
+{
+}
+
+void NullGraphicsAdapter::CreateWindow(std::string, int, int)
+{
+}
+
+void NullGraphicsAdapter::DestroyWindow()
+{
+}
+
+void NullGraphicsAdapter::LoadImage(std::string file)
+{
+    images.insert(file);
+}
+
+void NullGraphicsAdapter::UnloadImage(std::string file)
+{
+    images.erase(file);
+}
+
+bool NullGraphicsAdapter::IsLoaded(std::string file)
+{
+    return (images.find(file) != images.end());
+}
+
+void NullGraphicsAdapter::LoadFont(std::string fontFile, int)
+{
+    fonts.insert(fontFile);
+}
+
+void NullGraphicsAdapter::UnloadFont(std::string fontFile)
+{
+    fonts.erase(fontFile);
+}
+
+bool NullGraphicsAdapter::IsFontLoaded(std::string fontFile)
+{
+    return (fonts.find(fontFile) != fonts.end());
+}
+
+void NullGraphicsAdapter::InitRendering()
+{
+}
+
+void NullGraphicsAdapter::RenderImage(std::string, int, int, float, float,
+    int, int)
+{
+    ++numberOfRenderings;
+}
+
+void NullGraphicsAdapter::RenderCenteredImage(std::string, int, int, float,
+    float, int, int)
+{
+    ++numberOfRenderings;
+}
+
+void NullGraphicsAdapter::Write(std::string, std::string, int, int)
+{
+    ++numberOfRenderings;
+}
+
+void NullGraphicsAdapter::FinishRendering()
+{
+}
+
+unsigned long NullGraphicsAdapter::GetNumberOfRenderings()
+{
+    return numberOfRenderings;
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include "bandit/adapters/headless/NullSystemAdapter.h"
+
+void NullSystemAdapter::Initialize()
+{
+}
+
+void NullSystemAdapter::Shutdown()
+{
+}
\ No newline at end of file
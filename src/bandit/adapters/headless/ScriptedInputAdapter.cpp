@@ -0,0 +1,66 @@
+#include "bandit/adapters/headless/ScriptedInputAdapter.h"
+
+ScriptedInputAdapter::ScriptedInputAdapter() :
+    tick(0), mouseX(0), mouseY(0)
+{
+}
+
+void ScriptedInputAdapter::Schedule(unsigned int tick,
+    InputType::Type inputType, int button)
+{
+    inputs.insert(std::make_pair(tick, std::make_pair(inputType, button)));
+}
+
+void ScriptedInputAdapter::ScheduleMouse(unsigned int tick, int x, int y)
+{
+    mousePositions[tick] = std::make_pair(x, y);
+}
+
+unsigned int ScriptedInputAdapter::GetTick()
+{
+    return tick;
+}
+
+int ScriptedInputAdapter::GetMouseX()
+{
+    return mouseX;
+}
+
+int ScriptedInputAdapter::GetMouseY()
+{
+    return mouseY;
+}
+
+void ScriptedInputAdapter::ProcessInputs()
+{
+    occurredInputs.clear();
+
+    auto position = mousePositions.find(tick);
+
+    if (position != mousePositions.end())
+    {
+        mouseX = position->second.first;
+        mouseY = position->second.second;
+    }
+
+    auto range = inputs.equal_range(tick);
+
+    for (auto it = range.first; it != range.second; ++it)
+        occurredInputs.push_back(it->second);
+
+    ++tick;
+}
+
+bool ScriptedInputAdapter::CheckInputOccurred(InputType::Type inputType,
+    int button)
+{
+    std::pair<InputType::Type, int> input = std::make_pair(inputType, button);
+
+    return (std::find(occurredInputs.begin(), occurredInputs.end(), input) != occurredInputs.end());
+}
+
+const std::vector<std::pair<InputType::Type, int>>&
+    ScriptedInputAdapter::GetOccurredInputs()
+{
+    return occurredInputs;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "bandit/adapters/headless/VirtualTimerAdapter.h"
+
+VirtualTimerAdapter::VirtualTimerAdapter(double tick) :
+    tick(tick), time(0), previousTime(0)
+{
+}
+
+double VirtualTimerAdapter::GetTime()
+{
+    time += tick;
+    return time;
+}
+
+float VirtualTimerAdapter::GetElapsedTime()
+{
+    double currentTime = GetTime();
+    float seconds = currentTime - previousTime;
+    previousTime = currentTime;
+    return seconds;
+}
+
+void VirtualTimerAdapter::Sleep(float seconds)
+{
+    if (seconds > 0)
+        time += seconds;
+}
\ No newline at end of file
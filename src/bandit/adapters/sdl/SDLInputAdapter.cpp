@@ -188,4 +188,9 @@ bool SDLInputAdapter::CheckInputOccurred(InputType::Type inputType, int button)
     std::pair<InputType::Type, int> input = std::make_pair(inputType, button);
 
     return (std::find(occurredInputs.begin(), occurredInputs.end(), input) != occurredInputs.end());
+}
+
+const std::vector<std::pair<InputType::Type, int>>& SDLInputAdapter::GetOccurredInputs()
+{
+    return occurredInputs;
 }
\ No newline at end of file
@@ -1,13 +1,15 @@
 #include "bandit/adapters/sdl/SDLTimerAdapter.h"
 
-SDLTimerAdapter::SDLTimerAdapter() :
-    previousTicks(0)
+SDLTimerAdapter::SDLTimerAdapter()
 {
     if (SDL_InitSubSystem(SDL_INIT_TIMER) != 0)
     {
         std::cerr << "[SDLTimerAdapter] Error on initializing SDL timer."
             << SDL_GetError() << std::endl;
     }
+
+    counterPeriod = 1.0/SDL_GetPerformanceFrequency();
+    previousTime = GetTime();
 }
 
 SDLTimerAdapter::~SDLTimerAdapter()
@@ -15,17 +17,34 @@ SDLTimerAdapter::~SDLTimerAdapter()
     SDL_QuitSubSystem(SDL_INIT_TIMER);
 }
 
+double SDLTimerAdapter::GetTime()
+{
+    return SDL_GetPerformanceCounter()*counterPeriod;
+}
+
 float SDLTimerAdapter::GetElapsedTime()
 {
-    unsigned int ticks = SDL_GetTicks(); // in milliseconds
-    unsigned int milliseconds = ticks - previousTicks;
-    float seconds = milliseconds/1000.0;
-    previousTicks = ticks;
+    double time = GetTime();
+    float seconds = time - previousTime;
+    previousTime = time;
     return seconds;
 }
 
 void SDLTimerAdapter::Sleep(float seconds)
 {
+    if (seconds <= 0)
+        return;
+
+#if defined(_POSIX_TIMERS) && _POSIX_TIMERS > 0
+    struct timespec duration;
+    duration.tv_sec = static_cast<time_t>(seconds);
+    duration.tv_nsec = static_cast<long>((seconds - duration.tv_sec)*1e9);
+
+    // Sleeps again for the remaining time when interrupted by a signal.
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &duration, &duration) == EINTR)
+        continue;
+#else
     float milliseconds = seconds*1000.0;
     SDL_Delay(milliseconds);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "bandit/core/Allocations.h"
+
+#ifdef BANDIT_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<unsigned long> numberOfAllocations(0);
+}
+
+void* operator new(std::size_t size)
+{
+    numberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    void* pointer = std::malloc(size ? size : 1);
+
+    if (!pointer)
+        throw std::bad_alloc();
+
+    return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// The replaced operator new allocates with malloc, so freeing is right. GCC
+// pairs free with the standard operator new when inlining, though, and warns
+// about the mismatch. Compilers not knowing the warning would warn about the
+// pragma instead.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#pragma GCC diagnostic pop
+
+bool Allocations::IsCounting()
+{
+    return true;
+}
+
+unsigned long Allocations::GetNumberOfAllocations()
+{
+    return numberOfAllocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool Allocations::IsCounting()
+{
+    return false;
+}
+
+unsigned long Allocations::GetNumberOfAllocations()
+{
+    return 0;
+}
+
+#endif // BANDIT_COUNT_ALLOCATIONS
\ No newline at end of file
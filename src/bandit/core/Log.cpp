@@ -1,5 +1,144 @@
 #include "bandit/core/Log.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "bandit/core/MpscRingBuffer.h"
+
+namespace
+{
+    // Writes queued records out in batches, from a thread of its own.
+    class LogWriter
+    {
+      public:
+        static LogWriter& GetInstance();
+        ~LogWriter();
+
+        // Queues a record. Returns false if the queue is full.
+        bool Push(const LogRecord& record);
+
+        // Counts a record dropped because the queue was full.
+        void Drop();
+
+        // Waits until all records queued so far are written out.
+        void Flush();
+
+      private:
+        LogWriter();
+
+        // Writes records out until the writer is destroyed.
+        void Run();
+
+        // Number of records queued before the oldest ones are written out.
+        static const unsigned int CAPACITY = 1024;
+
+        // Largest number of records written out at once.
+        static const unsigned int BATCH_SIZE = 64;
+
+        MpscRingBuffer<LogRecord> records;
+        std::atomic<unsigned long> numberOfWrites;
+        std::atomic<unsigned long> numberOfDrops;
+        std::atomic<bool> running;
+        std::thread thread;
+    };
+
+    // Set once the writer is destroyed on exit, after which records are
+    // written out right away.
+    std::atomic<bool> writerDestroyed(false);
+
+    // Formats a record the way it is written out.
+    void Format(const LogRecord& record, std::string& output)
+    {
+        output += Log::GetPrefix(record.level);
+        output.append(record.text, record.length);
+
+        if (record.truncated)
+            output += "...";
+
+        output += Log::GetSufix();
+    }
+
+    LogWriter& LogWriter::GetInstance()
+    {
+        static LogWriter instance;
+        return instance;
+    }
+
+    LogWriter::LogWriter() :
+        records(CAPACITY), numberOfWrites(0), numberOfDrops(0), running(true)
+    {
+        thread = std::thread(&LogWriter::Run, this);
+    }
+
+    LogWriter::~LogWriter()
+    {
+        running.store(false, std::memory_order_release);
+        thread.join();
+        writerDestroyed.store(true, std::memory_order_release);
+    }
+
+    bool LogWriter::Push(const LogRecord& record)
+    {
+        return records.Push(record);
+    }
+
+    void LogWriter::Drop()
+    {
+        numberOfDrops.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void LogWriter::Flush()
+    {
+        unsigned long numberOfPushes = records.GetNumberOfPushes();
+
+        while (numberOfWrites.load(std::memory_order_acquire) < numberOfPushes)
+            std::this_thread::yield();
+    }
+
+    void LogWriter::Run()
+    {
+        std::string batch;
+        LogRecord record;
+
+        while (true)
+        {
+            bool stopping = !running.load(std::memory_order_acquire);
+            unsigned int batchSize = 0;
+
+            while (batchSize < BATCH_SIZE && records.Pop(record))
+            {
+                Format(record, batch);
+                ++batchSize;
+            }
+
+            unsigned long drops = numberOfDrops.exchange(0,
+                std::memory_order_relaxed);
+
+            if (drops > 0)
+                batch += Log::GetPrefix(Log::Warning) + "[Log] Dropped "
+                    + std::to_string(drops) + " logs, the queue was full"
+                    + Log::GetSufix();
+
+            if (!batch.empty())
+            {
+                Log::GetStream().write(batch.data(), batch.size());
+                Log::GetStream().flush();
+                batch.clear();
+                numberOfWrites.fetch_add(batchSize, std::memory_order_release);
+            }
+            else if (stopping)
+            {
+                return;
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+}
+
 Log::LogLevel Log::level = Log::Info;
 
 void Log::SetLevel(LogLevel level)
@@ -17,6 +156,39 @@ std::ostream& Log::GetStream()
     return std::cerr;
 };
 
+void Log::Write(const LogRecord& record)
+{
+    if (writerDestroyed.load(std::memory_order_acquire))
+    {
+        std::string output;
+        Format(record, output);
+        GetStream() << output;
+        return;
+    }
+
+    LogWriter& writer = LogWriter::GetInstance();
+
+    while (!writer.Push(record))
+    {
+        if (record.level < Warning)
+        {
+            writer.Drop();
+            return;
+        }
+
+        std::this_thread::yield();
+    }
+
+    if (record.level == Error)
+        writer.Flush();
+}
+
+void Log::Flush()
+{
+    if (!writerDestroyed.load(std::memory_order_acquire))
+        LogWriter::GetInstance().Flush();
+}
+
 std::string Log::GetLevelString(LogLevel level)
 {
     switch (level)
@@ -63,4 +235,25 @@ std::string Log::GetPrefix(LogLevel level)
 std::string Log::GetSufix()
 {
     return "\e[0;0m\n";
+}
+
+LogMessage::LogMessage(Log::LogLevel level) :
+    stream(this)
+{
+    record.level = level;
+    record.truncated = false;
+    record.length = 0;
+    setp(record.text, record.text + sizeof(record.text));
+}
+
+std::ostream& LogMessage::GetStream()
+{
+    return stream;
+}
+
+const LogRecord& LogMessage::GetRecord()
+{
+    record.length = pptr() - pbase();
+    record.truncated = stream.bad();
+    return record;
 }
\ No newline at end of file
@@ -1,22 +1,104 @@
 #include "bandit/core/Random.h"
 
+namespace
+{
+    // Stream IDs of the threads start here, far from the ones likely to be
+    // chosen by hand.
+    const uint64_t FIRST_THREAD_STREAM = 0x8000000000000000ULL;
+
+    uint64_t SplitMix64(uint64_t& value)
+    {
+        uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t RotateLeft(uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+}
+
+std::atomic<uint64_t> Random::seed(0x5EED5EED5EED5EEDULL);
+std::atomic<unsigned int> Random::seedVersion(0);
+std::atomic<unsigned int> Random::numberOfThreads(0);
+
 Random::Random()
 {
-    SeedRandomNumberGenerator();
+    Random& threadInstance = GetThreadInstance();
+    uint64_t high = threadInstance.GenerateBits();
+    Seed((high << 32) | threadInstance.GenerateBits());
+}
+
+Random::Random(const std::string& stream, uint64_t substream)
+{
+    Seed(seed ^ MixStream(GetStreamId(stream), substream));
+}
+
+Random::Random(uint64_t stream, uint64_t substream)
+{
+    Seed(seed ^ MixStream(stream, substream));
+}
+
+void Random::SetSeed(uint64_t seed)
+{
+    Random::seed = seed;
+    ++seedVersion;
+}
+
+uint64_t Random::GetSeed()
+{
+    return seed;
+}
+
+uint64_t Random::GetStreamId(const std::string& stream)
+{
+    // FNV-1a hash.
+    uint64_t id = 0xCBF29CE484222325ULL;
+
+    for (auto character : stream)
+    {
+        id ^= static_cast<unsigned char>(character);
+        id *= 0x100000001B3ULL;
+    }
+
+    return id;
+}
+
+Random& Random::GetThreadInstance()
+{
+    static thread_local unsigned int threadIndex = numberOfThreads++;
+    static thread_local unsigned int threadSeedVersion = seedVersion;
+    static thread_local Random threadInstance(FIRST_THREAD_STREAM + threadIndex);
+
+    if (threadSeedVersion != seedVersion)
+    {
+        threadSeedVersion = seedVersion;
+        threadInstance = Random(FIRST_THREAD_STREAM + threadIndex);
+    }
+
+    return threadInstance;
 }
 
-void Random::SeedRandomNumberGenerator()
+uint32_t Random::GenerateBits()
 {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint32_t result = RotateLeft(state[1]*5, 7)*9;
+    uint32_t t = state[1] << 9;
 
-    // using nano-seconds instead of seconds
-    srand((time_t)ts.tv_nsec);
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = RotateLeft(state[3], 11);
+
+    return result;
 }
 
 int Random::GenerateInt()
 {
-    return rand();
+    return static_cast<int>(GenerateBits() >> 1);
 }
 
 int Random::GenerateInt(int min, int max)
@@ -27,12 +109,14 @@ int Random::GenerateInt(int min, int max)
         exit(1);
     }
 
-    return (min + rand()%(max - min));
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min);
+    return (min + static_cast<int>((GenerateBits()*range) >> 32));
 }
 
 float Random::GenerateFloat()
 {
-    return GenerateFloat(0, 1);
+    // The upper 24 bits fill the mantissa of a float exactly.
+    return (GenerateBits() >> 8)*(1.0f/16777216.0f);
 }
 
 float Random::GenerateFloat(float min, float max)
@@ -43,5 +127,39 @@ float Random::GenerateFloat(float min, float max)
         exit(1);
     }
 
-    return (min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX/(max-min))));
+    return (min + GenerateFloat()*(max - min));
+}
+
+void Random::GenerateFloats(float* values, unsigned int count, float min,
+    float max)
+{
+    if (max <= min)
+    {
+        LOG_E("[Random] Maximum value must be greater than minimum value.");
+        exit(1);
+    }
+
+    float range = max - min;
+
+    for (unsigned int i = 0; i < count; ++i)
+        values[i] = min + (GenerateBits() >> 8)*(1.0f/16777216.0f)*range;
+}
+
+void Random::Seed(uint64_t value)
+{
+    uint64_t first = SplitMix64(value);
+    uint64_t second = SplitMix64(value);
+
+    state[0] = static_cast<uint32_t>(first);
+    state[1] = static_cast<uint32_t>(first >> 32);
+    state[2] = static_cast<uint32_t>(second);
+    state[3] = static_cast<uint32_t>(second >> 32);
+}
+
+uint64_t Random::MixStream(uint64_t stream, uint64_t substream)
+{
+    uint64_t value = stream;
+    uint64_t mixed = SplitMix64(value);
+    value = mixed ^ substream;
+    return SplitMix64(value);
 }
\ No newline at end of file
@@ -21,6 +21,12 @@ void ConfigParser::Parse(File& file)
     }
 
     Print();
+
+    parsed = true;
+    ++revision;
+
+    for (auto handle : handles)
+        Resolve(handle);
 }
 
 void ConfigParser::SetPath(std::string path)
@@ -89,6 +95,38 @@ std::string ConfigParser::SanitizeLine(std::string line)
     return line.substr(first, last-first+1);
 }
 
+std::vector<std::pair<std::string, std::string>> ConfigParser::GetEntries()
+{
+    std::vector<std::pair<std::string, std::string>> entries(
+        configurationMap.begin(), configurationMap.end());
+
+    std::sort(entries.begin(), entries.end());
+
+    return entries;
+}
+
+void ConfigParser::Set(std::string key, std::string value)
+{
+    if (key == "$PATH")
+        SetPath(value);
+
+    configurationMap[key] = value;
+    ++revision;
+
+    for (auto handle : handles)
+    {
+        if (key == handle->GetKey())
+            handle->Resolve(value);
+        else if (key == "$PATH" && parsed)
+            Resolve(handle);
+    }
+}
+
+unsigned int ConfigParser::GetRevision()
+{
+    return revision;
+}
+
 void ConfigParser::Print()
 {
     std::unordered_map<std::string, std::string>::iterator it;
@@ -120,6 +158,11 @@ std::string ConfigParser::Get(std::string key)
 }
 
 std::string ConfigParser::GetWithPath(std::string key)
+{
+    return PrependPath(Get(key));
+}
+
+std::string ConfigParser::PrependPath(std::string value)
 {
     if (path.empty())
     {
@@ -128,17 +171,21 @@ std::string ConfigParser::GetWithPath(std::string key)
         exit(1);
     }
 
-    return (File::Join(path, Get(key)));
+    return (File::Join(path, value));
 }
 
 int ConfigParser::GetAsInteger(std::string key)
 {
-    return std::stoi(Get(key));
+    int value;
+    Convert(key, Get(key), value);
+    return value;
 }
 
 float ConfigParser::GetAsFloat(std::string key)
 {
-    return std::stof(Get(key));
+    float value;
+    Convert(key, Get(key), value);
+    return value;
 }
 
 char ConfigParser::GetAsChar(std::string key)
@@ -149,20 +196,101 @@ char ConfigParser::GetAsChar(std::string key)
 
 bool ConfigParser::GetAsBool(std::string key)
 {
-    std::string value = Get(key);
+    bool value;
+    Convert(key, Get(key), value);
+    return value;
+}
+
+void ConfigParser::Register(BaseConfigHandle* handle)
+{
+    handles.push_back(handle);
+
+    if (parsed)
+        Resolve(handle);
+}
+
+void ConfigParser::Convert(const std::string& key, const std::string& value,
+    int& result)
+{
+    char* end;
+    errno = 0;
+    long converted = std::strtol(value.c_str(), &end, 10);
 
+    if (value.empty() || *end != '\0' || errno == ERANGE
+        || converted < INT_MIN || converted > INT_MAX)
+    {
+        LOG_E("[ConfigParser] Value \"" << value << "\" of key \"" << key
+            << "\" is not an integer.");
+        exit(1);
+    }
+
+    result = converted;
+}
+
+void ConfigParser::Convert(const std::string& key, const std::string& value,
+    float& result)
+{
+    char* end;
+    errno = 0;
+    result = std::strtof(value.c_str(), &end);
+
+    if (value.empty() || *end != '\0' || errno == ERANGE)
+    {
+        LOG_E("[ConfigParser] Value \"" << value << "\" of key \"" << key
+            << "\" is not a number.");
+        exit(1);
+    }
+}
+
+void ConfigParser::Convert(const std::string& key, const std::string& value,
+    bool& result)
+{
     if (value == "true")
-        return true;
+    {
+        result = true;
+        return;
+    }
     else if (value == "false")
-        return false;
-    
-    LOG_E("[ConfigParser] Unknown boolean value \"" << value << "\". "
-        << "Allowed values are \"true\" and \"false\".");
+    {
+        result = false;
+        return;
+    }
+
+    LOG_E("[ConfigParser] Unknown boolean value \"" << value << "\" of key \""
+        << key << "\". Allowed values are \"true\" and \"false\".");
     exit(1);
+}
 
+void ConfigParser::Convert(const std::string&, const std::string& value,
+    std::string& result)
+{
+    result = value;
+}
+
+void ConfigParser::Resolve(BaseConfigHandle* handle)
+{
+    if (!Contains(handle->GetKey()))
+    {
+        LOG_E("[ConfigParser] Key \"" << handle->GetKey() << "\" does not "
+            << "exist in the configuration file.");
+        exit(1);
+    }
+
+    handle->Resolve(configurationMap[handle->GetKey()]);
 }
 
 std::string ConfigParser::operator[](std::string key)
 {
     return Get(key);
+}
+
+CfgPath::CfgPath(const char* key) :
+    BaseConfigHandle(key)
+{
+    ConfigParser::GetInstance().Register(this);
+}
+
+void CfgPath::Resolve(const std::string& value)
+{
+    this->value = ConfigParser::GetInstance().PrependPath(value);
 }
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "bandit/core/thread/JobSystem.h"
+
+namespace
+{
+    // Job system whose worker is the calling thread, if any, and the index of
+    // the queue of such worker.
+    thread_local JobSystem* currentJobSystem = nullptr;
+    thread_local unsigned int currentQueueIndex = 0;
+}
+
+unsigned int TaskGraph::AddTask(std::function<void()> function)
+{
+    Task task;
+    task.function = function;
+    task.numberOfDependencies = 0;
+    tasks.push_back(task);
+    return tasks.size() - 1;
+}
+
+void TaskGraph::AddDependency(unsigned int task, unsigned int dependency)
+{
+    if (task >= tasks.size() || dependency >= task)
+    {
+        LOG_E("[TaskGraph] Task " << task << " can't depend on task "
+            << dependency << ".");
+        exit(1);
+    }
+
+    tasks[dependency].successors.push_back(task);
+    ++tasks[task].numberOfDependencies;
+}
+
+unsigned int TaskGraph::GetNumberOfTasks()
+{
+    return tasks.size();
+}
+
+void TaskGraph::Clear()
+{
+    tasks.clear();
+}
+
+JobSystem::JobSystem(unsigned int numberOfWorkers) :
+    numberOfQueuedJobs(0), stopped(false)
+{
+    LOG_D("[JobSystem] Starting " << numberOfWorkers << " workers");
+
+    for (unsigned int i = 0; i <= numberOfWorkers; ++i)
+        queues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+
+    for (unsigned int i = 1; i <= numberOfWorkers; ++i)
+        workers.push_back(std::thread(&JobSystem::RunWorker, this, i));
+}
+
+JobSystem::~JobSystem()
+{
+    Job job;
+
+    while (FindJob(job))
+        RunJob(job);
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopped = true;
+    }
+
+    jobAvailable.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void JobSystem::Run(JobGroup& group, std::function<void()> function)
+{
+    Job job;
+    job.function = std::move(function);
+    job.group = &group;
+
+    group.numberOfPendingJobs.fetch_add(1);
+
+    {
+        JobQueue& queue = *queues[GetQueueIndex()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+        numberOfQueuedJobs.fetch_add(1);
+    }
+
+    // Taking the lock makes sure a worker about to sleep sees the new job.
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+
+    jobAvailable.notify_one();
+}
+
+void JobSystem::Wait(JobGroup& group)
+{
+    Job job;
+
+    while (group.numberOfPendingJobs.load() > 0)
+    {
+        if (FindJob(job))
+            RunJob(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::Run(TaskGraph& graph)
+{
+    unsigned int numberOfTasks = graph.GetNumberOfTasks();
+    std::unique_ptr<std::atomic<unsigned int>[]> numberOfPendingDependencies(
+        new std::atomic<unsigned int>[numberOfTasks]);
+    JobGroup group;
+
+    for (unsigned int i = 0; i < numberOfTasks; ++i)
+        numberOfPendingDependencies[i].store(graph.tasks[i].numberOfDependencies);
+
+    for (unsigned int i = 0; i < numberOfTasks; ++i)
+    {
+        if (graph.tasks[i].numberOfDependencies > 0)
+            continue;
+
+        std::atomic<unsigned int>* counters = numberOfPendingDependencies.get();
+        Run(group, [this, &graph, i, counters, &group]()
+            {
+                RunTask(graph, i, counters, group);
+            });
+    }
+
+    Wait(group);
+}
+
+unsigned int JobSystem::GetNumberOfThreads()
+{
+    return workers.size() + 1;
+}
+
+unsigned int JobSystem::GetDefaultNumberOfWorkers()
+{
+    unsigned int numberOfThreads = std::thread::hardware_concurrency();
+    return (numberOfThreads > 1 ? numberOfThreads - 1 : 0);
+}
+
+unsigned int JobSystem::GetQueueIndex()
+{
+    return (currentJobSystem == this ? currentQueueIndex : 0);
+}
+
+bool JobSystem::PopJob(unsigned int queueIndex, bool owned, Job& job)
+{
+    JobQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.jobs.empty())
+        return false;
+
+    if (owned)
+    {
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+    }
+    else
+    {
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+    }
+
+    numberOfQueuedJobs.fetch_sub(1);
+    return true;
+}
+
+bool JobSystem::FindJob(Job& job)
+{
+    if (numberOfQueuedJobs.load() == 0)
+        return false;
+
+    unsigned int ownIndex = GetQueueIndex();
+
+    if (PopJob(ownIndex, true, job))
+        return true;
+
+    for (unsigned int i = 1; i < queues.size(); ++i)
+    {
+        if (PopJob((ownIndex + i) % queues.size(), false, job))
+            return true;
+    }
+
+    return false;
+}
+
+void JobSystem::RunJob(Job& job)
+{
+    JobGroup* group = job.group;
+
+    job.function();
+    job.function = nullptr;
+    group->numberOfPendingJobs.fetch_sub(1);
+}
+
+void JobSystem::RunWorker(unsigned int queueIndex)
+{
+    Job job;
+
+    currentJobSystem = this;
+    currentQueueIndex = queueIndex;
+
+    while (true)
+    {
+        if (FindJob(job))
+        {
+            RunJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        jobAvailable.wait(lock, [this]()
+            {
+                return stopped || numberOfQueuedJobs.load() > 0;
+            });
+
+        if (stopped && numberOfQueuedJobs.load() == 0)
+            return;
+    }
+}
+
+void JobSystem::RunTask(TaskGraph& graph, unsigned int task,
+    std::atomic<unsigned int>* numberOfPendingDependencies, JobGroup& group)
+{
+    graph.tasks[task].function();
+
+    // Successors are submitted before this task is counted as finished, so the
+    // group can't be seen empty while tasks are still left.
+    for (auto successor : graph.tasks[task].successors)
+    {
+        if (numberOfPendingDependencies[successor].fetch_sub(1) == 1)
+        {
+            Run(group, [this, &graph, successor, numberOfPendingDependencies, &group]()
+                {
+                    RunTask(graph, successor, numberOfPendingDependencies, group);
+                });
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "bandit/core/time/FramePacer.h"
+
+const float FramePacer::SPIN_DURATION = 0.002;
+
+FramePacer::FramePacer(std::shared_ptr<TimerAdapter> timerAdapter) :
+    timerAdapter(timerAdapter), framePeriod(0), frameStart(0), deadline(0),
+    nextSample(0)
+{
+    frameTimes.reserve(NUMBER_OF_SAMPLES);
+}
+
+void FramePacer::SetTargetFrameRate(float frameRate)
+{
+    framePeriod = frameRate > 0 ? 1/frameRate : 0;
+}
+
+float FramePacer::GetTargetFrameRate()
+{
+    return framePeriod > 0 ? 1/framePeriod : 0;
+}
+
+void FramePacer::Start()
+{
+    frameStart = timerAdapter->GetTime();
+    deadline = frameStart;
+    frameTimes.clear();
+    nextSample = 0;
+}
+
+float FramePacer::BeginFrame()
+{
+    double now = timerAdapter->GetTime();
+    float frameTime = now - frameStart;
+    frameStart = now;
+
+    if (frameTimes.size() < NUMBER_OF_SAMPLES)
+        frameTimes.push_back(frameTime);
+    else
+        frameTimes[nextSample] = frameTime;
+
+    nextSample = (nextSample + 1) % NUMBER_OF_SAMPLES;
+
+    return frameTime;
+}
+
+void FramePacer::EndFrame()
+{
+    if (framePeriod == 0)
+        return;
+
+    double now = timerAdapter->GetTime();
+    deadline += framePeriod;
+
+    if (now >= deadline)
+    {
+        // A frame late by more than a period is not made up for.
+        if (now - deadline > framePeriod)
+            deadline = now;
+
+        return;
+    }
+
+    if (deadline - now > SPIN_DURATION)
+        timerAdapter->Sleep(deadline - now - SPIN_DURATION);
+
+    while (timerAdapter->GetTime() < deadline)
+        std::this_thread::yield();
+}
+
+FrameStats FramePacer::GetStats()
+{
+    FrameStats stats = {0, 0, 0};
+
+    if (frameTimes.empty())
+        return stats;
+
+    std::vector<float> sortedTimes(frameTimes);
+    unsigned int percentile99 = (sortedTimes.size() - 1)*99/100;
+
+    std::nth_element(sortedTimes.begin(), sortedTimes.begin() + percentile99,
+        sortedTimes.end());
+    stats.percentile99 = sortedTimes[percentile99];
+    stats.minimum = *std::min_element(sortedTimes.begin(), sortedTimes.end());
+
+    for (auto frameTime : sortedTimes)
+        stats.average += frameTime;
+
+    stats.average /= sortedTimes.size();
+
+    return stats;
+}
\ No newline at end of file
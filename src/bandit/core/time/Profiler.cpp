@@ -0,0 +1,195 @@
+#include "bandit/core/time/Profiler.h"
+
+Profiler& Profiler::GetInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() :
+    enabled(false), epoch(std::chrono::steady_clock::now()),
+    numberOfDroppedZones(0), maxTraceZones(0)
+{
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+const char* Profiler::Intern(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(namesMutex);
+    return names.insert(name).first->c_str();
+}
+
+uint64_t Profiler::GetTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end)
+{
+    Zone zone = {name, start, end};
+
+    if (!GetBuffer().Push(zone))
+        numberOfDroppedZones.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::Collect()
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    Zone zone;
+
+    for (unsigned int thread = 0; thread < buffers.size(); ++thread)
+    {
+        while (buffers[thread]->Pop(zone))
+        {
+            Samples& zoneSamples = samples[zone.name];
+            float duration = (zone.end - zone.start)*1e-9;
+
+            if (zoneSamples.durations.size() < NUMBER_OF_SAMPLES)
+                zoneSamples.durations.push_back(duration);
+            else
+                zoneSamples.durations[zoneSamples.next] = duration;
+
+            zoneSamples.next = (zoneSamples.next + 1) % NUMBER_OF_SAMPLES;
+
+            if (trace.size() < maxTraceZones)
+            {
+                TraceZone traceZone = {zone, thread};
+                trace.push_back(traceZone);
+
+                if (trace.size() == maxTraceZones)
+                    LOG_W("[Profiler] Trace is full, later zones are left out");
+            }
+        }
+    }
+}
+
+std::vector<ZoneStats> Profiler::GetZoneStats()
+{
+    std::vector<ZoneStats> zoneStats;
+
+    for (auto& zoneSamples : samples)
+    {
+        std::vector<float> durations(zoneSamples.second.durations);
+        unsigned int percentile95 = (durations.size() - 1)*95/100;
+        ZoneStats stats = {zoneSamples.first, 0, 0, 0};
+
+        std::nth_element(durations.begin(), durations.begin() + percentile95,
+            durations.end());
+        stats.percentile95 = durations[percentile95];
+        stats.maximum = *std::max_element(durations.begin(), durations.end());
+
+        for (auto duration : durations)
+            stats.average += duration;
+
+        stats.average /= durations.size();
+        zoneStats.push_back(stats);
+    }
+
+    std::sort(zoneStats.begin(), zoneStats.end(),
+        [](const ZoneStats& a, const ZoneStats& b)
+        {
+            return a.average > b.average;
+        });
+
+    return zoneStats;
+}
+
+unsigned long Profiler::GetNumberOfDroppedZones()
+{
+    return numberOfDroppedZones.load(std::memory_order_relaxed);
+}
+
+void Profiler::StartTrace(unsigned int maxZones)
+{
+    trace.clear();
+    trace.reserve(maxZones);
+    maxTraceZones = maxZones;
+}
+
+void Profiler::WriteTrace(std::string file)
+{
+    std::ofstream stream(file);
+
+    if (!stream.is_open())
+    {
+        LOG_E("[Profiler] Could not create trace file: " << file);
+        exit(1);
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    // Complete events, with times in microseconds, plus a name for each
+    // thread.
+    stream << "{\"traceEvents\":[";
+
+    for (unsigned int thread = 0; thread < buffers.size(); ++thread)
+    {
+        stream << (thread == 0 ? "\n" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread << ",\"args\":{\"name\":\"Thread " << thread << "\"}}";
+    }
+
+    stream.precision(3);
+    stream << std::fixed;
+
+    for (auto& traceZone : trace)
+    {
+        stream << ",\n{\"name\":\"" << traceZone.zone.name
+            << "\",\"cat\":\"bandit\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+            << traceZone.thread << ",\"ts\":" << traceZone.zone.start*1e-3
+            << ",\"dur\":" << (traceZone.zone.end - traceZone.zone.start)*1e-3
+            << "}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    LOG_I("[Profiler] Wrote " << trace.size() << " zones to " << file);
+}
+
+Profiler::Buffer& Profiler::GetBuffer()
+{
+    static thread_local Buffer* buffer = nullptr;
+
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::unique_ptr<Buffer>(new Buffer()));
+        buffer = buffers.back().get();
+    }
+
+    return *buffer;
+}
+
+Profiler::Buffer::Buffer() :
+    zones(CAPACITY), head(0), tail(0)
+{
+}
+
+bool Profiler::Buffer::Push(const Zone& zone)
+{
+    unsigned int currentTail = tail.load(std::memory_order_relaxed);
+
+    if (currentTail - head.load(std::memory_order_acquire) == CAPACITY)
+        return false;
+
+    zones[currentTail & (CAPACITY - 1)] = zone;
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+bool Profiler::Buffer::Pop(Zone& zone)
+{
+    unsigned int currentHead = head.load(std::memory_order_relaxed);
+
+    if (currentHead == tail.load(std::memory_order_acquire))
+        return false;
+
+    zone = zones[currentHead & (CAPACITY - 1)];
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
\ No newline at end of file
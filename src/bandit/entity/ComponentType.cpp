@@ -0,0 +1,73 @@
+#include "bandit/entity/ComponentType.h"
+
+unsigned int ComponentType::GetId(Component& component)
+{
+    unsigned int id = Register(std::type_index(typeid(component)));
+    std::lock_guard<std::mutex> lock(GetMutex());
+
+    // Class names are only known once an instance is available.
+    if (!GetNamedTypes().test(id))
+    {
+        GetNameIds()[component.GetComponentClass()] = id;
+        GetNamedTypes().set(id);
+    }
+
+    return id;
+}
+
+bool ComponentType::FindId(std::string componentClass, unsigned int& id)
+{
+    std::lock_guard<std::mutex> lock(GetMutex());
+    auto it = GetNameIds().find(componentClass);
+
+    if (it == GetNameIds().end())
+        return false;
+
+    id = it->second;
+    return true;
+}
+
+unsigned int ComponentType::Register(std::type_index type)
+{
+    std::lock_guard<std::mutex> lock(GetMutex());
+    auto it = GetTypeIds().find(type);
+
+    if (it != GetTypeIds().end())
+        return it->second;
+
+    unsigned int id = GetTypeIds().size();
+
+    if (id >= MAX_COMPONENT_TYPES)
+    {
+        LOG_E("[ComponentType] More than " << MAX_COMPONENT_TYPES
+            << " component classes registered.");
+        exit(1);
+    }
+
+    GetTypeIds()[type] = id;
+    return id;
+}
+
+std::unordered_map<std::type_index, unsigned int>& ComponentType::GetTypeIds()
+{
+    static std::unordered_map<std::type_index, unsigned int> typeIds;
+    return typeIds;
+}
+
+std::unordered_map<std::string, unsigned int>& ComponentType::GetNameIds()
+{
+    static std::unordered_map<std::string, unsigned int> nameIds;
+    return nameIds;
+}
+
+ComponentMask& ComponentType::GetNamedTypes()
+{
+    static ComponentMask namedTypes;
+    return namedTypes;
+}
+
+std::mutex& ComponentType::GetMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
\ No newline at end of file
@@ -1,20 +1,41 @@
 #include "bandit/entity/Entity.h"
 
-unsigned int Entity::lowestUnassignedId = 0;
+Entity::Entity() :
+    index(INVALID_INDEX), generation(0)
+{
+}
+
+Entity::Entity(unsigned int index, unsigned int generation) :
+    index(index), generation(generation)
+{
+}
+
+unsigned int Entity::GetId() const
+{
+    return index;
+}
 
-Entity::Entity()
+unsigned int Entity::GetGeneration() const
 {
-    if (lowestUnassignedId == std::numeric_limits<unsigned int>::max())
-    {
-        LOG_E("[Entity] No entity UI available");
-        exit(1);
-    }
+    return generation;
+}
+
+bool Entity::IsValid() const
+{
+    return (index != INVALID_INDEX);
+}
 
-    id = lowestUnassignedId;
-    ++lowestUnassignedId;
+Entity::operator bool() const
+{
+    return IsValid();
+}
+
+bool Entity::operator==(const Entity& other) const
+{
+    return (index == other.index && generation == other.generation);
 }
 
-unsigned int Entity::GetId()
+bool Entity::operator!=(const Entity& other) const
 {
-    return id;
+    return !(*this == other);
 }
\ No newline at end of file
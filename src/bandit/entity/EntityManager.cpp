@@ -1,121 +1,401 @@
 #include "bandit/entity/EntityManager.h"
 
-std::shared_ptr<Entity> EntityManager::CreateEntity()
+EntityManager::EntityManager() :
+    nextCreationOrder(0), queriesDirty(false)
 {
-    std::shared_ptr<Entity> entity = std::make_shared<Entity>();
+}
+
+Entity EntityManager::CreateEntity()
+{
+    unsigned int index;
+
+    if (freeSlots.empty())
+    {
+        if (slots.size() == Entity::INVALID_INDEX)
+        {
+            LOG_E("[EntityManager] No entity slot available");
+            exit(1);
+        }
+
+        index = slots.size();
+        slots.push_back(EntitySlot());
+    }
+    else
+    {
+        if (queriesDirty)
+            SweepDirtyQueries();
+
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    slots[index].alive = true;
+    slots[index].creationOrder = nextCreationOrder;
+    ++nextCreationOrder;
+
+    slots[index].position = entities.size();
+
+    Entity entity(index, slots[index].generation);
     entities.push_back(entity);
 
-    LOG_D("[EntityManager] Created entity with ID: " << entity->GetId());
+    LOG_D("[EntityManager] Created entity with ID: " << entity.GetId());
 
     return entity;
 }
 
 void EntityManager::Clear()
 {
+    for (auto& query : queries)
+    {
+        query->entities.clear();
+        query->dirty = false;
+    }
+
+    queriesDirty = false;
+
+    for (auto& entity : entities)
+        ReleaseSlot(entity);
+
     entities.clear();
-    componentsByEntity.clear();
-    componentToEntities.clear();
+    commands.clear();
 }
 
-void EntityManager::DeleteEntity(std::shared_ptr<Entity> entity)
+void EntityManager::DeleteEntity(Entity entity)
 {
-    DeleteEntityComponents(entity);
+    if (!IsAlive(entity))
+    {
+        LOG_D("[EntityManager] Ignoring deletion of stale entity with ID: "
+            << entity.GetId());
+        return;
+    }
+
+    UpdateQueries(entity, slots[entity.GetId()].components.mask,
+        ComponentMask());
+    ReleaseSlot(entity);
     DeleteEntityFromContainer(entity);
 
-    LOG_D("[EntityManager] Deleted entity with ID: " << entity->GetId());
+    LOG_D("[EntityManager] Deleted entity with ID: " << entity.GetId());
+}
+
+bool EntityManager::IsAlive(Entity entity)
+{
+    unsigned int index = entity.GetId();
+
+    return (index < slots.size() && slots[index].alive
+        && slots[index].generation == entity.GetGeneration());
+}
+
+bool EntityManager::IsDeleted(Entity entity)
+{
+    return (!IsAlive(entity) || slots[entity.GetId()].deletionPending);
+}
+
+void EntityManager::ReleaseSlot(Entity entity)
+{
+    EntitySlot& slot = slots[entity.GetId()];
+
+    // Components are cleared instead of reassigned, so the next entity in
+    // this slot reuses their memory.
+    slot.components.mask.reset();
+    slot.components.components.clear();
+    slot.components.types.clear();
+    slot.alive = false;
+    slot.deletionPending = false;
+
+    // Generations wrap around, which only matters for handles kept across
+    // four billion deletions of the same slot.
+    ++slot.generation;
+
+    freeSlots.push_back(entity.GetId());
 }
 
-void EntityManager::DeleteEntityComponents(std::shared_ptr<Entity> entity)
+void EntityManager::DeleteEntityFromContainer(Entity entity)
 {
-    componentsByEntity[entity->GetId()].clear();
-    componentsByEntity.erase(entity->GetId());
+    unsigned int position = slots[entity.GetId()].position;
+    Entity lastEntity = entities.back();
+
+    entities[position] = lastEntity;
+    slots[lastEntity.GetId()].position = position;
+    entities.pop_back();
 }
 
-void EntityManager::DeleteEntityFromContainer(std::shared_ptr<Entity> entity)
+void EntityManager::DeleteEntitiesWithComponentsOfClass(
+    std::string componentClass)
 {
-    for (unsigned int i = 0; i < entities.size(); ++i)
+    std::vector<Entity> deletedEntities =
+        GetAllEntitiesWithComponentOfClass(componentClass);
+
+    for (auto& entity : deletedEntities)
     {
-        if (entity->GetId() == entities[i]->GetId())
-        {
-            entities.erase(entities.begin() + i);
-            --i; // Decrease index since entities is one size smaller
-        }
+        ReleaseSlot(entity);
+        DeleteEntityFromContainer(entity);
     }
+
+    RemoveDeletedEntitiesFromQueries();
 }
 
-void EntityManager::DeleteEntitiesWithComponentsOfClass(
+void EntityManager::DeleteEntityDeferred(Entity entity)
+{
+    std::lock_guard<std::mutex> lock(commandsMutex);
+
+    if (IsDeleted(entity))
+        return;
+
+    slots[entity.GetId()].deletionPending = true;
+
+    Command command;
+    command.type = Command::DeleteEntityCommand;
+    command.entity = entity;
+    commands.push_back(command);
+}
+
+void EntityManager::AddComponentDeferred(std::shared_ptr<Component> component,
+    Entity entity)
+{
+    Command command;
+    command.type = Command::AddComponentCommand;
+    command.entity = entity;
+    command.component = component;
+
+    std::lock_guard<std::mutex> lock(commandsMutex);
+    commands.push_back(command);
+}
+
+void EntityManager::DeleteComponentsOfClassDeferred(Entity entity,
     std::string componentClass)
 {
-    for (unsigned int i = 0; i < entities.size(); ++i)
+    Command command;
+    command.type = Command::DeleteComponentsCommand;
+    command.entity = entity;
+    command.componentClass = componentClass;
+
+    std::lock_guard<std::mutex> lock(commandsMutex);
+    commands.push_back(command);
+}
+
+void EntityManager::ApplyDeferredCommands()
+{
+    bool hasDeletedEntities = false;
+
+    // Commands are moved out first, so the ones applied below can't be
+    // appended to the list being iterated.
+    pendingCommands.swap(commands);
+
+    for (auto& command : pendingCommands)
     {
-        if (HasComponent(entities[i], componentClass))
+        switch (command.type)
         {
-            DeleteEntity(entities[i]);
-            --i; // Decrease index since entities is one size smaller
+            case Command::DeleteEntityCommand:
+                // Deleted entities remain in the queries until the end, which
+                // is fine since their slots are not reused in the meantime.
+                if (IsAlive(command.entity))
+                {
+                    ReleaseSlot(command.entity);
+                    DeleteEntityFromContainer(command.entity);
+                    hasDeletedEntities = true;
+
+                    LOG_D("[EntityManager] Deleted entity with ID: "
+                        << command.entity.GetId());
+                }
+                break;
+
+            case Command::AddComponentCommand:
+                AddComponent(command.component, command.entity);
+                break;
+
+            case Command::DeleteComponentsCommand:
+                DeleteComponentsOfClass(command.entity,
+                    command.componentClass);
+                break;
         }
     }
+
+    pendingCommands.clear();
+
+    if (hasDeletedEntities)
+        RemoveDeletedEntitiesFromQueries();
+    else if (queriesDirty)
+        SweepDirtyQueries();
 }
 
 void EntityManager::AddComponent(std::shared_ptr<Component> component,
-    std::shared_ptr<Entity> entity)
+    Entity entity)
 {
-    if (HasEntity(entity))
+    if (!IsAlive(entity))
     {
-        componentsByEntity[entity->GetId()].push_back(component);
+        LOG_W("[EntityManager] Ignoring component \"" << component->GetComponentClass()
+            << "\" added to stale entity with ID: " << entity.GetId());
+        return;
     }
-    else
+
+    unsigned int type = ComponentType::GetId(*component);
+    EntityComponents& entityComponents = slots[entity.GetId()].components;
+
+    if (!entityComponents.mask.test(type))
     {
-        std::vector<std::shared_ptr<Component>> componentsArray = { component };
-        componentsByEntity[entity->GetId()] = componentsArray;
+        UpdateQueries(entity, entityComponents.mask,
+            ComponentMask(entityComponents.mask).set(type));
     }
 
+    entityComponents.mask.set(type);
+    entityComponents.components.push_back(component);
+    entityComponents.types.push_back(type);
+
     LOG_D("[EntityManager] Added component \"" << component->GetComponentClass()
-        << "\" to entity with ID: " << entity->GetId());
+        << "\" to entity with ID: " << entity.GetId());
 }
 
-bool EntityManager::HasEntity(std::shared_ptr<Entity> entity)
+EntityManager::EntityComponents* EntityManager::FindComponents(
+    Entity entity)
 {
-    return (componentsByEntity.find(entity->GetId()) != componentsByEntity.end());
+    if (!IsAlive(entity))
+        return nullptr;
+
+    return &slots[entity.GetId()].components;
 }
 
 std::vector<std::shared_ptr<Component>> EntityManager::GetComponentsOfClass(
-    std::shared_ptr<Entity> entity, std::string componentClass)
+    Entity entity, std::string componentClass)
 {
     std::vector<std::shared_ptr<Component>> componentsArray;
+    EntityComponents* entityComponents = FindComponents(entity);
+    unsigned int type;
 
-    for (auto component : componentsByEntity[entity->GetId()])
+    if (!entityComponents || !ComponentType::FindId(componentClass, type))
+        return componentsArray;
+
+    for (unsigned int i = 0; i < entityComponents->types.size(); ++i)
     {
-        if (component->GetComponentClass() == componentClass)
-            componentsArray.push_back(component);
+        if (entityComponents->types[i] == type)
+            componentsArray.push_back(entityComponents->components[i]);
     }
 
     return componentsArray;
 }
 
-std::vector<std::shared_ptr<Entity>> EntityManager::GetAllEntitiesWithComponentOfClass(
+const std::vector<Entity>& EntityManager::GetAllEntitiesWithComponentOfClass(
     std::string componentClass)
 {
-    std::vector<std::shared_ptr<Entity>> entitiesArray;
+    static const std::vector<Entity> noEntities;
+    unsigned int type;
+
+    if (!ComponentType::FindId(componentClass, type))
+        return noEntities;
+
+    return GetQuery(ComponentMask().set(type));
+}
+
+const std::vector<Entity>& EntityManager::GetQuery(ComponentMask mask)
+{
+    std::lock_guard<std::mutex> lock(queriesMutex);
 
-    for (auto entity : entities)
+    for (auto& query : queries)
     {
-        for (auto component : componentsByEntity[entity->GetId()])
+        if (query->mask == mask)
         {
-            if (component->GetComponentClass() == componentClass)
-            {
-                entitiesArray.push_back(entity);
-                break;
-            }
+            if (query->dirty)
+                SweepQuery(*query);
+
+            return query->entities;
         }
     }
 
-    return entitiesArray;
+    std::unique_ptr<Query> query(new Query());
+    query->mask = mask;
+
+    for (auto& entity : entities)
+    {
+        if ((slots[entity.GetId()].components.mask & mask) == mask)
+            query->entities.push_back(entity);
+    }
+
+    std::sort(query->entities.begin(), query->entities.end(),
+        [this](const Entity& entity1, const Entity& entity2)
+        {
+            return (slots[entity1.GetId()].creationOrder
+                < slots[entity2.GetId()].creationOrder);
+        });
+
+    queries.push_back(std::move(query));
+    return queries.back()->entities;
 }
 
-std::shared_ptr<Entity> EntityManager::GetEntityWithComponentOfClass(
+void EntityManager::UpdateQueries(Entity entity, ComponentMask oldMask,
+    ComponentMask newMask)
+{
+    for (auto& query : queries)
+    {
+        bool oldMatch = ((oldMask & query->mask) == query->mask);
+        bool newMatch = ((newMask & query->mask) == query->mask);
+
+        if (!oldMatch && newMatch)
+            InsertIntoQuery(*query, entity);
+        else if (oldMatch && !newMatch)
+            RemoveFromQuery(*query, entity);
+    }
+}
+
+void EntityManager::InsertIntoQuery(Query& query, Entity entity)
+{
+    unsigned long long creationOrder = slots[entity.GetId()].creationOrder;
+
+    // Most entities get their components right after being created, so they
+    // are usually appended.
+    auto it = std::lower_bound(query.entities.begin(), query.entities.end(),
+        creationOrder, [this](const Entity& other, unsigned long long order)
+        {
+            return slots[other.GetId()].creationOrder < order;
+        });
+
+    // An entity whose component was just replaced is still in the query.
+    if (it != query.entities.end() && *it == entity)
+        return;
+
+    query.entities.insert(it, entity);
+}
+
+void EntityManager::RemoveFromQuery(Query& query, Entity)
+{
+    query.dirty = true;
+    queriesDirty = true;
+}
+
+void EntityManager::SweepQuery(Query& query)
+{
+    auto end = std::remove_if(query.entities.begin(), query.entities.end(),
+        [this, &query](const Entity& entity)
+        {
+            return (!IsAlive(entity) || (slots[entity.GetId()].components.mask
+                & query.mask) != query.mask);
+        });
+
+    query.entities.erase(end, query.entities.end());
+    query.dirty = false;
+}
+
+void EntityManager::SweepDirtyQueries()
+{
+    for (auto& query : queries)
+    {
+        if (query->dirty)
+            SweepQuery(*query);
+    }
+
+    queriesDirty = false;
+}
+
+void EntityManager::RemoveDeletedEntitiesFromQueries()
+{
+    for (auto& query : queries)
+        SweepQuery(*query);
+
+    queriesDirty = false;
+}
+
+Entity EntityManager::GetEntityWithComponentOfClass(
         std::string componentClass)
 {
-    std::vector<std::shared_ptr<Entity>> entitiesArray =
+    const std::vector<Entity>& entitiesArray =
         GetAllEntitiesWithComponentOfClass(componentClass);
 
     if (entitiesArray.size() == 0)
@@ -141,53 +421,76 @@ bool EntityManager::HasEntityWithComponentOfClass(std::string componentClass)
 }
 
 std::shared_ptr<Component> EntityManager::GetSingleComponentOfClass(
-    std::shared_ptr<Entity> entity, std::string componentClass)
+    Entity entity, std::string componentClass)
 {
-    std::vector<std::shared_ptr<Component>> componentsArray =
-        GetComponentsOfClass(entity, componentClass);
+    unsigned int type;
 
-    if (componentsArray.size() == 0)
+    if (!ComponentType::FindId(componentClass, type))
     {
         LOG_E("[EntityManager] There is no component of class \""
-            << componentClass << "\" in entity " << entity->GetId());
+            << componentClass << "\" in entity " << entity.GetId());
         exit(1);
     }
 
-    if (componentsArray.size() > 1)
+    return GetSingleComponentOfType(entity, type);
+}
+
+std::shared_ptr<Component> EntityManager::GetSingleComponentOfType(
+    Entity entity, unsigned int type)
+{
+    EntityComponents* entityComponents = FindComponents(entity);
+
+    if (!entityComponents || !entityComponents->mask.test(type))
     {
-        LOG_W("[EntityManager] Entity " << entity->GetId() << " has more than "
-            << "one component of class \"" << componentClass << "\" (number of "
-            << "components: " << componentsArray.size() << "). "
-            << "Returning the first one.");
+        LOG_E("[EntityManager] There is no component of class ID " << type
+            << " in entity " << entity.GetId());
+        exit(1);
     }
 
-    return componentsArray[0];
+    // Only the first match is returned. Extra components of the same class,
+    // such as additional sprites, must be fetched with GetComponents.
+    unsigned int i = 0;
+
+    while (entityComponents->types[i] != type)
+        ++i;
+
+    return entityComponents->components[i];
 }
 
 std::vector<std::shared_ptr<Component>> EntityManager::GetAllComponentsOfClass(
         std::string componentClass)
 {
     std::vector<std::shared_ptr<Component>> componentsArray;
+    unsigned int type;
+
+    if (!ComponentType::FindId(componentClass, type))
+        return componentsArray;
 
-    for (auto entity : entities)
+    for (auto& entity : entities)
     {
-        for (auto component : componentsByEntity[entity->GetId()])
+        EntityComponents* entityComponents = FindComponents(entity);
+
+        if (!entityComponents || !entityComponents->mask.test(type))
+            continue;
+
+        for (unsigned int i = 0; i < entityComponents->types.size(); ++i)
         {
-            if (component->GetComponentClass() == componentClass)
-                componentsArray.push_back(component);
+            if (entityComponents->types[i] == type)
+                componentsArray.push_back(entityComponents->components[i]);
         }
     }
 
     return componentsArray;
 }
 
-bool EntityManager::HasComponent(std::shared_ptr<Entity> entity,
+bool EntityManager::HasComponent(Entity entity,
         std::string componentClass)
 {
-    std::vector<std::shared_ptr<Component>> componentsArray =
-        GetComponentsOfClass(entity, componentClass);
+    EntityComponents* entityComponents = FindComponents(entity);
+    unsigned int type;
 
-    return (componentsArray.size() > 0);
+    return (entityComponents && ComponentType::FindId(componentClass, type)
+        && entityComponents->mask.test(type));
 }
 
 unsigned int EntityManager::GetNumberOfEntities()
@@ -195,19 +498,55 @@ unsigned int EntityManager::GetNumberOfEntities()
     return entities.size();
 }
 
-void EntityManager::DeleteComponentsOfClass(std::shared_ptr<Entity> entity,
-    std::string componentClass)
+unsigned int EntityManager::GetNumberOfPooledComponents()
 {
-    std::shared_ptr<Component> component;
+    unsigned int numberOfComponents = 0;
 
-    for (unsigned int i = 0; i < componentsByEntity[entity->GetId()].size(); ++i)
+    for (auto& storage : storages)
     {
-        component = componentsByEntity[entity->GetId()][i];
+        if (storage)
+            numberOfComponents += storage->GetNumberOfCreations();
+    }
+
+    return numberOfComponents;
+}
+
+unsigned int EntityManager::GetNumberOfComponentAllocations()
+{
+    unsigned int numberOfAllocations = 0;
+
+    for (auto& storage : storages)
+    {
+        if (storage)
+            numberOfAllocations += storage->GetNumberOfAllocations();
+    }
 
-        if (component->GetComponentClass() == componentClass)
+    return numberOfAllocations;
+}
+
+void EntityManager::DeleteComponentsOfClass(Entity entity,
+    std::string componentClass)
+{
+    EntityComponents* entityComponents = FindComponents(entity);
+    unsigned int type;
+
+    if (!entityComponents || !ComponentType::FindId(componentClass, type))
+        return;
+
+    if (!entityComponents->mask.test(type))
+        return;
+
+    for (unsigned int i = 0; i < entityComponents->types.size(); ++i)
+    {
+        if (entityComponents->types[i] == type)
         {
-            componentsByEntity[entity->GetId()].erase(componentsByEntity[entity->GetId()].begin() + i);
-            --i; // Decrease index since entities is one size smaller
+            entityComponents->components.erase(entityComponents->components.begin() + i);
+            entityComponents->types.erase(entityComponents->types.begin() + i);
+            --i; // Decrease index since components is one size smaller
         }
     }
+
+    UpdateQueries(entity, entityComponents->mask,
+        ComponentMask(entityComponents->mask).reset(type));
+    entityComponents->mask.reset(type);
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "bandit/entity/Prefab.h"
+
+Entity Prefab::Instantiate(EntityManager& entityManager) const
+{
+    Entity entity = entityManager.CreateEntity();
+
+    for (auto& cloner : cloners)
+        entityManager.AddComponent(cloner(entityManager), entity);
+
+    return entity;
+}
+
+std::vector<Entity> Prefab::Instantiate(EntityManager& entityManager,
+    unsigned int numberOfEntities) const
+{
+    std::vector<Entity> entities;
+    entities.reserve(numberOfEntities);
+
+    for (unsigned int i = 0; i < numberOfEntities; ++i)
+        entities.push_back(Instantiate(entityManager));
+
+    return entities;
+}
\ No newline at end of file
@@ -1,9 +1,19 @@
 #include "bandit/entity/SystemManager.h"
 
+SystemManager::SystemManager() : stagesOutdated(false)
+{
+}
+
+void SystemManager::SetJobSystem(std::shared_ptr<JobSystem> jobSystem)
+{
+    this->jobSystem = jobSystem;
+}
+
 void SystemManager::AddSystem(std::shared_ptr<System> system)
 {
     LOG_D("[SystemManager] Adding \"" << system->GetName() << "\" system");
     systems.push_back(system);
+    stagesOutdated = true;
 }
 
 void SystemManager::DeleteSystem(std::string name)
@@ -18,21 +28,126 @@ void SystemManager::DeleteSystem(std::string name)
             --i; // Decrease index since systems is one size smaller
         }
     }
+
+    stagesOutdated = true;
 }
 
-void SystemManager::Update(float dt)
+void SystemManager::Simulate(float dt)
 {
-    std::shared_ptr<System> system;
+    if (stagesOutdated)
+        BuildStages();
 
-    for (unsigned int i = 0; i < systems.size(); ++i)
+    Update(simulationStages, dt);
+}
+
+void SystemManager::Present(float dt)
+{
+    if (stagesOutdated)
+        BuildStages();
+
+    Update(presentationStages, dt);
+}
+
+void SystemManager::Update(std::vector<std::vector<System*>>& stages,
+    float dt)
+{
+    for (auto& stage : stages)
     {
-        system = systems[i];
-        LOG_D("[SystemManager] Updating \"" << system->GetName() << "\" system");
-        system->Update(dt);
+        JobGroup group;
+
+        // The first system is updated by this thread while the others are
+        // handed to the job system, and every system of the stage must finish
+        // before the next stage starts.
+        for (unsigned int i = 1; i < stage.size(); ++i)
+        {
+            System* system = stage[i];
+            const char* zoneName = zoneNames[system];
+            LOG_D("[SystemManager] Updating \"" << system->GetName() << "\" system");
+
+            if (jobSystem)
+                jobSystem->Run(group, [this, system, zoneName, dt]()
+                    {
+                        UpdateSystem(system, zoneName, dt);
+                    });
+            else
+                UpdateSystem(system, zoneName, dt);
+        }
+
+        LOG_D("[SystemManager] Updating \"" << stage[0]->GetName() << "\" system");
+        UpdateSystem(stage[0], zoneNames[stage[0]], dt);
+
+        if (jobSystem)
+            jobSystem->Wait(group);
     }
 }
 
+void SystemManager::UpdateSystem(System* system, const char* zoneName,
+    float dt)
+{
+    PROFILE_ZONE(zoneName);
+    system->Update(dt);
+}
+
 void SystemManager::Clear()
 {
     systems.clear();
+    simulationStages.clear();
+    presentationStages.clear();
+    zoneNames.clear();
+    stagesOutdated = false;
+}
+
+void SystemManager::BuildStages()
+{
+    zoneNames.clear();
+
+    for (auto& system : systems)
+        zoneNames[system.get()] = Profiler::GetInstance().Intern(system->GetName());
+
+    BuildStages(false, simulationStages);
+    BuildStages(true, presentationStages);
+    stagesOutdated = false;
+}
+
+void SystemManager::BuildStages(bool presentation,
+    std::vector<std::vector<System*>>& stages)
+{
+    std::vector<System*> stagedSystems;
+
+    for (auto& system : systems)
+    {
+        if (system->IsPresentation() == presentation)
+            stagedSystems.push_back(system.get());
+    }
+
+    std::vector<unsigned int> systemStages(stagedSystems.size());
+
+    stages.clear();
+
+    for (unsigned int i = 0; i < stagedSystems.size(); ++i)
+    {
+        unsigned int stage = 0;
+
+        for (unsigned int j = 0; j < i; ++j)
+        {
+            if (stagedSystems[i]->ConflictsWith(*stagedSystems[j]) && systemStages[j] >= stage)
+                stage = systemStages[j] + 1;
+        }
+
+        systemStages[i] = stage;
+
+        if (stage == stages.size())
+            stages.push_back(std::vector<System*>());
+
+        stages[stage].push_back(stagedSystems[i]);
+    }
+
+    for (unsigned int i = 0; i < stages.size(); ++i)
+    {
+        for (auto system : stages[i])
+        {
+            LOG_D("[SystemManager] " << (presentation ? "Presentation" : "Simulation")
+                << " stage " << i << ": \"" << system->GetName() << "\" system");
+        }
+    }
 }
\ No newline at end of file
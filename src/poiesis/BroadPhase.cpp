@@ -0,0 +1,126 @@
+#include "poiesis/BroadPhase.h"
+
+#include "poiesis/QuadtreeBroadPhase.h"
+#include "poiesis/SweepAndPrune.h"
+#include "poiesis/UniformGrid.h"
+
+BroadPhase::BroadPhase() : currentUpdate(0)
+{
+}
+
+std::unique_ptr<BroadPhase> BroadPhase::Create(std::string name)
+{
+    if (name == "grid")
+        return std::unique_ptr<BroadPhase>(
+            new UniformGrid(CFG_GETF("COLLISION_CELL_SIZE")));
+    else if (name == "sweep_and_prune")
+        return std::unique_ptr<BroadPhase>(new SweepAndPrune());
+    else if (name == "quadtree")
+        return std::unique_ptr<BroadPhase>(new QuadtreeBroadPhase(
+            Rectangle(CFG_GETF("LEVEL_MIN_X"), CFG_GETF("LEVEL_MIN_Y"),
+                CFG_GETF("LEVEL_MAX_X") - CFG_GETF("LEVEL_MIN_X"),
+                CFG_GETF("LEVEL_MAX_Y") - CFG_GETF("LEVEL_MIN_Y"))));
+
+    LOG_E("[BroadPhase] Unknown broad phase \"" << name << "\".");
+    exit(1);
+}
+
+void BroadPhase::BeginUpdate()
+{
+    ++currentUpdate;
+}
+
+void BroadPhase::Update(Entity entity, Vector position, float radius)
+{
+    unsigned int id = entity.GetId();
+
+    if (id >= proxies.size())
+    {
+        Proxy proxy;
+        proxy.inserted = false;
+        proxies.resize(id + 1, proxy);
+    }
+
+    // The slot may have been recycled by a new entity.
+    if (proxies[id].inserted && proxies[id].entity != entity)
+        Remove(proxies[id].entity);
+
+    Proxy& proxy = proxies[id];
+    float minX = position.GetX() - radius;
+    float minY = position.GetY() - radius;
+    float maxX = position.GetX() + radius;
+    float maxY = position.GetY() + radius;
+    bool moved = (!proxy.inserted || minX != proxy.minX || minY != proxy.minY
+        || maxX != proxy.maxX || maxY != proxy.maxY);
+
+    proxy.entity = entity;
+    proxy.minX = minX;
+    proxy.minY = minY;
+    proxy.maxX = maxX;
+    proxy.maxY = maxY;
+    proxy.lastUpdate = currentUpdate;
+
+    if (!proxy.inserted)
+    {
+        proxy.inserted = true;
+        proxy.position = insertedProxies.size();
+        insertedProxies.push_back(id);
+        OnInsert(id);
+    }
+    else if (moved)
+    {
+        OnMove(id);
+    }
+}
+
+void BroadPhase::RemoveStaleEntities()
+{
+    for (unsigned int i = 0; i < insertedProxies.size(); ++i)
+    {
+        Proxy& proxy = proxies[insertedProxies[i]];
+
+        if (proxy.lastUpdate != currentUpdate)
+        {
+            Remove(proxy.entity);
+            --i; // The last inserted entity took its place
+        }
+    }
+}
+
+void BroadPhase::Remove(Entity entity)
+{
+    unsigned int id = entity.GetId();
+
+    if (id >= proxies.size() || !proxies[id].inserted
+        || proxies[id].entity != entity)
+        return;
+
+    OnRemove(id);
+
+    unsigned int position = proxies[id].position;
+    insertedProxies[position] = insertedProxies.back();
+    proxies[insertedProxies[position]].position = position;
+    insertedProxies.pop_back();
+
+    proxies[id].inserted = false;
+}
+
+void BroadPhase::Clear()
+{
+    for (auto id : insertedProxies)
+        proxies[id].inserted = false;
+
+    insertedProxies.clear();
+    OnClear();
+}
+
+unsigned int BroadPhase::GetNumberOfEntities()
+{
+    return insertedProxies.size();
+}
+
+bool BroadPhase::Overlap(const Proxy& proxy1, const Proxy& proxy2)
+{
+    return !(proxy1.maxX < proxy2.minX || proxy2.maxX < proxy1.minX
+        || proxy1.maxY < proxy2.minY || proxy2.maxY < proxy1.minY);
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "poiesis/ContactCache.h"
+
+ContactCache::ContactCache() :
+    frame(0)
+{
+}
+
+void ContactCache::Update(const std::vector<Contact>& contacts,
+    RingBuffer<CollisionEvent>& events)
+{
+    ++frame;
+
+    for (auto& contact : contacts)
+    {
+        CollisionEvent event;
+        event.contact = contact;
+
+        auto key = GetKey(contact.entity1, contact.entity2);
+        auto it = cachedContacts.find(key);
+
+        if (it == cachedContacts.end())
+        {
+            event.type = CollisionBegin;
+            it = cachedContacts.insert(std::make_pair(key, CachedContact())).first;
+        }
+        else
+        {
+            auto& cachedContact = it->second.contact;
+            bool sameEntities =
+                (cachedContact.entity1 == contact.entity1 && cachedContact.entity2 == contact.entity2)
+                || (cachedContact.entity1 == contact.entity2 && cachedContact.entity2 == contact.entity1);
+
+            // Slots of deleted entities may have been reused by new entities,
+            // which are not colliding with anything yet.
+            if (sameEntities)
+                event.type = CollisionStay;
+            else
+            {
+                CollisionEvent endEvent;
+                endEvent.type = CollisionEnd;
+                endEvent.contact = cachedContact;
+                events.Push(endEvent);
+
+                event.type = CollisionBegin;
+            }
+        }
+
+        it->second.contact = contact;
+        it->second.frame = frame;
+        events.Push(event);
+    }
+
+    for (auto it = cachedContacts.begin(); it != cachedContacts.end();)
+    {
+        if (it->second.frame == frame)
+        {
+            ++it;
+            continue;
+        }
+
+        CollisionEvent event;
+        event.type = CollisionEnd;
+        event.contact = it->second.contact;
+        events.Push(event);
+
+        it = cachedContacts.erase(it);
+    }
+}
+
+uint64_t ContactCache::GetKey(Entity entity1, Entity entity2)
+{
+    uint64_t id1 = entity1.GetId();
+    uint64_t id2 = entity2.GetId();
+
+    if (id1 > id2)
+        std::swap(id1, id2);
+
+    return ((id1 << 32) | id2);
+}
\ No newline at end of file
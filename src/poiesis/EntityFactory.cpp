@@ -1,323 +1,448 @@
 #include "poiesis/EntityFactory.h"
 
-std::shared_ptr<Entity> EntityFactory::CreateBackground()
+namespace
 {
-    std::shared_ptr<Entity> background = Engine::GetInstance().CreateEntity();
+    // Prefab built from the configuration. It is built again the first time
+    // it is needed after the configuration changes, such as when a replay
+    // restores the configuration it was recorded with, so instances never
+    // carry stale values. Creating entities is not thread-safe, so only
+    // exclusive systems spawn, and prefabs need no lock.
+    template <typename T>
+    class ConfiguredPrefab
+    {
+      public:
+        explicit ConfiguredPrefab(T (*build)()) :
+            build(build), built(false), revision(0)
+        {
+        }
+
+        const T& Get()
+        {
+            unsigned int currentRevision =
+                ConfigParser::GetInstance().GetRevision();
+
+            if (!built || revision != currentRevision)
+            {
+                prefab = build();
+                built = true;
+                revision = currentRevision;
+            }
+
+            return prefab;
+        }
+
+      private:
+        T (*build)();
+        T prefab;
+        bool built;
+        unsigned int revision;
+    };
+}
+
+Entity EntityFactory::CreateBackground()
+{
+    Entity background = Engine::GetInstance().CreateEntity();
     Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("BACKGROUND_IMAGE")),
+        Engine::GetInstance().CreateComponent<SpriteComponent>(CFG_GETP("BACKGROUND_IMAGE")),
         background);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(), background);
+    auto particleComponent = Engine::GetInstance().CreateComponent<ParticleComponent>();
+    particleComponent->SetBodyType(StaticBody);
+    Engine::GetInstance().AddComponent(particleComponent, background);
     return background;
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateCell(Vector position)
+Entity EntityFactory::CreateCell(Vector position)
 {
-    std::shared_ptr<Entity> cell = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<MoveableComponent>(), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ComplexityComponent>(CFG_GETI("CELL_MAX_COMPLEXITY")),
-        cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(CFG_GETF("CELL_INVERSE_MASS"),
-            position, Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING"),
-            0, CFG_GETF("CELL_ANGULAR_VELOCITY")),
-            cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<GrowthComponent>(), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("CELL_COLLIDER_RADIUS")),
-        cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<CombatComponent>(), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<InfectionComponent>(NoInfection, false), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("CELL_ANIMATION"),
-            Vector(0, 0), 0, 0, true,
-            CFG_GETF("CELL_ANIMATION_SCALE"),
-            CFG_GETI("CELL_ANIMATION_NUM_FRAMES"),
-            CFG_GETF("CELL_ANIMATION_FRAME_DURATION"), true, true),
-        cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ReproductionComponent>(1), cell);
-    return cell;
+    return InstantiateAt(GetCellPrefab(), position);
+}
+
+std::vector<Entity> EntityFactory::CreateCells(
+    const std::vector<Vector>& positions)
+{
+    return InstantiateAt(GetCellPrefab(), positions);
 }
 
-std::shared_ptr<Entity> EntityFactory::CreatePlayer()
+Entity EntityFactory::CreatePlayer()
 {
-    std::shared_ptr<Entity> player = CreateCell(Vector(0, 0));
+    Entity player = CreateCell(Vector(0, 0));
     Engine::GetInstance().AddComponent(
-        std::make_shared<PlayerComponent>(), player);
+        Engine::GetInstance().CreateComponent<PlayerComponent>(), player);
     Engine::GetInstance().AddComponent(
-        std::make_shared<CameraFollowComponent>(), player);
+        Engine::GetInstance().CreateComponent<CameraFollowComponent>(), player);
     return player;
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateLevel3Cell(Vector position)
+Entity EntityFactory::CreateLevel3Cell(Vector position)
 {
-    std::shared_ptr<Entity> cell = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<MoveableComponent>(), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ComplexityComponent>(CFG_GETI("CELL_MAX_COMPLEXITY")),
-        cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(CFG_GETF("CELL_INVERSE_MASS"),
-            position, Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING"),
-            0, CFG_GETF("CELL_ANGULAR_VELOCITY")),
-            cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<GrowthComponent>(), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("CELL_COLLIDER_RADIUS")),
-        cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<CombatComponent>(), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<InfectionComponent>(NoInfection, false), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("REPRODUCTION_MATURING_ANIMATION"),
-            Vector(0, 0), 0, CFG_GETF("REPRODUCTION_MATURING_ROTATION_SPEED"), true,
-            CFG_GETF("REPRODUCTION_MATURING_SCALE"),
-            CFG_GETI("REPRODUCTION_MATURING_NUM_FRAMES"),
-            1, true, true),
-        cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ReproductionComponent>(1), cell);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<AIComponent>("EatableComponent"), cell);
-    return cell;
+    return InstantiateAt(GetLevel3CellPrefab(), position);
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateLevel3Player()
+std::vector<Entity> EntityFactory::CreateLevel3Cells(
+    const std::vector<Vector>& positions)
 {
-    std::shared_ptr<Entity> player = CreateLevel3Cell(Vector(0, 0));
+    return InstantiateAt(GetLevel3CellPrefab(), positions);
+}
+
+Entity EntityFactory::CreateLevel3Player()
+{
+    Entity player = CreateLevel3Cell(Vector(0, 0));
     Engine::GetInstance().AddComponent(
-        std::make_shared<PlayerComponent>(), player);
+        Engine::GetInstance().CreateComponent<PlayerComponent>(), player);
     Engine::GetInstance().AddComponent(
-        std::make_shared<CameraFollowComponent>(), player);
+        Engine::GetInstance().CreateComponent<CameraFollowComponent>(), player);
     return player;
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateFood(Vector position)
+Entity EntityFactory::CreateFood(Vector position)
 {
-    std::shared_ptr<Entity> food = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("FOOD_IMAGE"), Vector(0, 0),
-            0, 0, true, CFG_GETF("FOOD_SCALE")), food);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<MoveableComponent>(), food);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(CFG_GETF("FOOD_INVERSE_MASS"),
-            position, Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")),
-        food);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<EatableComponent>(), food);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("FOOD_COLLIDER_RADIUS")),
-        food);
-    return food;
+    return InstantiateAt(GetFoodPrefab(), position);
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateCellParticle(Vector position)
+std::vector<Entity> EntityFactory::CreateFood(
+    const std::vector<Vector>& positions)
 {
-    std::shared_ptr<Entity> cellParticle = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("CELL_PARTICLE_IMAGE"),
-            Vector(0, 0), 0, 0, true, CFG_GETF("CELL_PARTICLE_SCALE")),
-        cellParticle);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<MoveableComponent>(), cellParticle);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(
-            CFG_GETF("CELL_PARTICLE_INVERSE_MASS"),
-            position, Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")),
-        cellParticle);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<EatableComponent>(), cellParticle);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(
-            CFG_GETF("CELL_PARTICLE_COLLIDER_RADIUS")),
-        cellParticle);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<CellParticleComponent>(), cellParticle);
-    return cellParticle;
+    return InstantiateAt(GetFoodPrefab(), positions);
+}
+
+Entity EntityFactory::CreateCellParticle(Vector position)
+{
+    return InstantiateAt(GetCellParticlePrefab(), position);
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateVirus(Vector position)
+Entity EntityFactory::CreateVirus(Vector position)
 {
     Random r;
-    std::shared_ptr<Entity> virus = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("VIRUS_IMAGE"),
-            Vector(0, 0), r.GenerateFloat(-M_PI, M_PI),
-            CFG_GETF("VIRUS_ANGULAR_VELOCITY"), true,
-            CFG_GETF("VIRUS_SCALE")), virus);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<MoveableComponent>(), virus);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(CFG_GETF("VIRUS_INVERSE_MASS"),
-            position, Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")),
-        virus);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("VIRUS_COLLIDER_RADIUS")),
-        virus);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<CombatComponent>(CFG_GETI("VIRUS_COMBAT_POWER")),
-        virus);
+    Entity virus = InstantiateAt(GetVirusPrefab(), position);
+    Engine::GetInstance().Get<SpriteComponent>(virus)->SetRotation(
+        r.GenerateFloat(-M_PI, M_PI));
     return virus;
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateCamera(float height)
+std::vector<Entity> EntityFactory::CreateViruses(
+    const std::vector<Vector>& positions)
+{
+    Random r;
+    std::vector<Entity> viruses = InstantiateAt(GetVirusPrefab(), positions);
+
+    for (auto virus : viruses)
+        Engine::GetInstance().Get<SpriteComponent>(virus)->SetRotation(
+            r.GenerateFloat(-M_PI, M_PI));
+
+    return viruses;
+}
+
+Entity EntityFactory::CreateCamera(float height)
 {
-    std::shared_ptr<Entity> camera = Engine::GetInstance().CreateEntity();
+    Entity camera = Engine::GetInstance().CreateEntity();
     Engine::GetInstance().AddComponent(
-        std::make_shared<CameraComponent>(Vector(0, 0), height), camera);
+        Engine::GetInstance().CreateComponent<CameraComponent>(Vector(0, 0), height), camera);
     return camera;
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateSlowArea(Vector position)
+Entity EntityFactory::CreateSlowArea(Vector position)
 {
-    std::shared_ptr<Entity> area = Engine::GetInstance().CreateEntity();
+    return InstantiateAt(GetSlowAreaPrefab(), position);
+}
+
+Entity EntityFactory::CreateFastArea(Vector position)
+{
+    return InstantiateAt(GetFastAreaPrefab(), position);
+}
+
+Entity EntityFactory::CreateVitaminArea(Vector position)
+{
+    return InstantiateAt(GetVitaminAreaPrefab(), position);
+}
+
+Entity EntityFactory::CreateAcidArea(Vector position)
+{
+    return InstantiateAt(GetAcidAreaPrefab(), position);
+}
+
+Entity EntityFactory::CreateButton(std::string image,
+    Rectangle rectangle, std::function<void()> callback)
+{
+    Entity button = Engine::GetInstance().CreateEntity();
+    Engine::GetInstance().AddComponent(
+        Engine::GetInstance().CreateComponent<SpriteComponent>(image), button);
     Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("SLOW_AREA_ANIMATION"),
+        Engine::GetInstance().CreateComponent<ButtonComponent>(rectangle, callback), button);
+    return button;
+}
+
+Entity EntityFactory::CreateBacterium(Vector position)
+{
+    Random r;
+    Entity bacterium = InstantiateAt(
+        GetBacteriumPrefab(r.GenerateInt(0, 3)), position);
+    Engine::GetInstance().Get<SpriteComponent>(bacterium)->SetRotation(
+        r.GenerateFloat(-M_PI, M_PI));
+    return bacterium;
+}
+
+Entity EntityFactory::InstantiateAt(const Prefab& prefab, Vector position)
+{
+    Entity entity = Engine::GetInstance().Instantiate(prefab);
+    Engine::GetInstance().Get<ParticleComponent>(entity)->SetPosition(position);
+
+    // Sprites are copied from the prototype along with its animation, so
+    // each instance starts its own.
+    Engine::GetInstance().Get<SpriteComponent>(entity)->RandomizeAnimation();
+    return entity;
+}
+
+std::vector<Entity> EntityFactory::InstantiateAt(const Prefab& prefab,
+    const std::vector<Vector>& positions)
+{
+    std::vector<Entity> entities =
+        Engine::GetInstance().Instantiate(prefab, positions.size());
+
+    for (unsigned int i = 0; i < entities.size(); ++i)
+    {
+        Engine::GetInstance().Get<ParticleComponent>(entities[i])->SetPosition(positions[i]);
+        Engine::GetInstance().Get<SpriteComponent>(entities[i])->RandomizeAnimation();
+    }
+
+    return entities;
+}
+
+const Prefab& EntityFactory::GetCellPrefab()
+{
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab cell;
+        cell.AddComponent(MoveableComponent());
+        cell.AddComponent(ComplexityComponent(CFG_GETI("CELL_MAX_COMPLEXITY")));
+        cell.AddComponent(ParticleComponent(CFG_GETF("CELL_INVERSE_MASS"),
+            Vector(0, 0), Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING"),
+            0, CFG_GETF("CELL_ANGULAR_VELOCITY")));
+        cell.AddComponent(GrowthComponent());
+        cell.AddComponent(ColliderComponent(CFG_GETF("CELL_COLLIDER_RADIUS")));
+        cell.AddComponent(CombatComponent());
+        cell.AddComponent(InfectionComponent(NoInfection, false));
+        cell.AddComponent(SpriteComponent(CFG_GETP("CELL_ANIMATION"),
+            Vector(0, 0), 0, 0, true,
+            CFG_GETF("CELL_ANIMATION_SCALE"),
+            CFG_GETI("CELL_ANIMATION_NUM_FRAMES"),
+            CFG_GETF("CELL_ANIMATION_FRAME_DURATION"), true, true));
+        cell.AddComponent(ReproductionComponent(1));
+        return cell;
+    });
+
+    return prefab.Get();
+}
+
+const Prefab& EntityFactory::GetLevel3CellPrefab()
+{
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab cell;
+        cell.AddComponent(MoveableComponent());
+        cell.AddComponent(ComplexityComponent(CFG_GETI("CELL_MAX_COMPLEXITY")));
+        cell.AddComponent(ParticleComponent(CFG_GETF("CELL_INVERSE_MASS"),
+            Vector(0, 0), Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING"),
+            0, CFG_GETF("CELL_ANGULAR_VELOCITY")));
+        cell.AddComponent(GrowthComponent());
+        cell.AddComponent(ColliderComponent(CFG_GETF("CELL_COLLIDER_RADIUS")));
+        cell.AddComponent(CombatComponent());
+        cell.AddComponent(InfectionComponent(NoInfection, false));
+        cell.AddComponent(SpriteComponent(CFG_GETP("REPRODUCTION_MATURING_ANIMATION"),
+            Vector(0, 0), 0, CFG_GETF("REPRODUCTION_MATURING_ROTATION_SPEED"), true,
+            CFG_GETF("REPRODUCTION_MATURING_SCALE"),
+            CFG_GETI("REPRODUCTION_MATURING_NUM_FRAMES"),
+            1, true, true));
+        cell.AddComponent(ReproductionComponent(1));
+        cell.AddComponent(AIComponent("EatableComponent"));
+        return cell;
+    });
+
+    return prefab.Get();
+}
+
+const Prefab& EntityFactory::GetFoodPrefab()
+{
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab food;
+        food.AddComponent(SpriteComponent(CFG_GETP("FOOD_IMAGE"), Vector(0, 0),
+            0, 0, true, CFG_GETF("FOOD_SCALE")));
+        food.AddComponent(MoveableComponent());
+        food.AddComponent(ParticleComponent(CFG_GETF("FOOD_INVERSE_MASS"),
+            Vector(0, 0), Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")));
+        food.AddComponent(EatableComponent());
+        food.AddComponent(ColliderComponent(CFG_GETF("FOOD_COLLIDER_RADIUS")));
+        return food;
+    });
+
+    return prefab.Get();
+}
+
+const Prefab& EntityFactory::GetCellParticlePrefab()
+{
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab cellParticle;
+        cellParticle.AddComponent(SpriteComponent(CFG_GETP("CELL_PARTICLE_IMAGE"),
+            Vector(0, 0), 0, 0, true, CFG_GETF("CELL_PARTICLE_SCALE")));
+        cellParticle.AddComponent(MoveableComponent());
+        cellParticle.AddComponent(ParticleComponent(
+            CFG_GETF("CELL_PARTICLE_INVERSE_MASS"),
+            Vector(0, 0), Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")));
+        cellParticle.AddComponent(EatableComponent());
+        cellParticle.AddComponent(ColliderComponent(
+            CFG_GETF("CELL_PARTICLE_COLLIDER_RADIUS")));
+        cellParticle.AddComponent(CellParticleComponent());
+        return cellParticle;
+    });
+
+    return prefab.Get();
+}
+
+const Prefab& EntityFactory::GetVirusPrefab()
+{
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab virus;
+        virus.AddComponent(SpriteComponent(CFG_GETP("VIRUS_IMAGE"),
+            Vector(0, 0), 0, CFG_GETF("VIRUS_ANGULAR_VELOCITY"), true,
+            CFG_GETF("VIRUS_SCALE")));
+        virus.AddComponent(MoveableComponent());
+        virus.AddComponent(ParticleComponent(CFG_GETF("VIRUS_INVERSE_MASS"),
+            Vector(0, 0), Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")));
+        virus.AddComponent(ColliderComponent(CFG_GETF("VIRUS_COLLIDER_RADIUS")));
+        virus.AddComponent(CombatComponent(CFG_GETI("VIRUS_COMBAT_POWER")));
+        return virus;
+    });
+
+    return prefab.Get();
+}
+
+const Prefab& EntityFactory::GetSlowAreaPrefab()
+{
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab area;
+        area.AddComponent(SpriteComponent(CFG_GETP("SLOW_AREA_ANIMATION"),
             Vector(0, 0), 0, 0, true,
             CFG_GETF("SLOW_AREA_ANIMATION_SCALE"),
             CFG_GETI("SLOW_AREA_ANIMATION_NUM_FRAMES"),
-            CFG_GETF("SLOW_AREA_ANIMATION_FRAME_DURATION"), true, true),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, position), area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("SLOW_AREA_COLLIDER_RADIUS")),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SlowingComponent>(CFG_GETF("SLOW_AREA_MAGNITUDE")), area);
-    return area;
+            CFG_GETF("SLOW_AREA_ANIMATION_FRAME_DURATION"), true, true));
+        ParticleComponent particleComponent(0, Vector(0, 0));
+        particleComponent.SetBodyType(StaticBody);
+        area.AddComponent(particleComponent);
+        area.AddComponent(ColliderComponent(CFG_GETF("SLOW_AREA_COLLIDER_RADIUS")));
+        area.AddComponent(SlowingComponent(CFG_GETF("SLOW_AREA_MAGNITUDE")));
+        return area;
+    });
+
+    return prefab.Get();
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateFastArea(Vector position)
+const Prefab& EntityFactory::GetFastAreaPrefab()
 {
-    std::shared_ptr<Entity> area = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("FAST_AREA_ANIMATION"),
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab area;
+        area.AddComponent(SpriteComponent(CFG_GETP("FAST_AREA_ANIMATION"),
             Vector(0, 0), 0, 0, true,
             CFG_GETF("FAST_AREA_ANIMATION_SCALE"),
             CFG_GETI("FAST_AREA_ANIMATION_NUM_FRAMES"),
-            CFG_GETF("FAST_AREA_ANIMATION_FRAME_DURATION"), true, true),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, position), area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("FAST_AREA_COLLIDER_RADIUS")),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SlowingComponent>(CFG_GETF("FAST_AREA_MAGNITUDE")), area);
-    return area;
+            CFG_GETF("FAST_AREA_ANIMATION_FRAME_DURATION"), true, true));
+        ParticleComponent particleComponent(0, Vector(0, 0));
+        particleComponent.SetBodyType(StaticBody);
+        area.AddComponent(particleComponent);
+        area.AddComponent(ColliderComponent(CFG_GETF("FAST_AREA_COLLIDER_RADIUS")));
+        area.AddComponent(SlowingComponent(CFG_GETF("FAST_AREA_MAGNITUDE")));
+        return area;
+    });
+
+    return prefab.Get();
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateVitaminArea(Vector position)
+const Prefab& EntityFactory::GetVitaminAreaPrefab()
 {
-    std::shared_ptr<Entity> area = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("VITAMIN_AREA_ANIMATION"),
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab area;
+        area.AddComponent(SpriteComponent(CFG_GETP("VITAMIN_AREA_ANIMATION"),
             Vector(0, 0), 0, 0, true,
             CFG_GETF("VITAMIN_AREA_ANIMATION_SCALE"),
             CFG_GETI("VITAMIN_AREA_ANIMATION_NUM_FRAMES"),
-            CFG_GETF("VITAMIN_AREA_ANIMATION_FRAME_DURATION"), true, true),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, position), area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("VITAMIN_AREA_COLLIDER_RADIUS")),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<VitaminComponent>(CFG_GETF("VITAMIN_AREA_GROWTH_FACTOR")),
-        area);
-    return area;
+            CFG_GETF("VITAMIN_AREA_ANIMATION_FRAME_DURATION"), true, true));
+        ParticleComponent particleComponent(0, Vector(0, 0));
+        particleComponent.SetBodyType(StaticBody);
+        area.AddComponent(particleComponent);
+        area.AddComponent(ColliderComponent(CFG_GETF("VITAMIN_AREA_COLLIDER_RADIUS")));
+        area.AddComponent(VitaminComponent(CFG_GETF("VITAMIN_AREA_GROWTH_FACTOR")));
+        return area;
+    });
+
+    return prefab.Get();
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateAcidArea(Vector position)
+const Prefab& EntityFactory::GetAcidAreaPrefab()
 {
-    std::shared_ptr<Entity> area = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("ACID_AREA_ANIMATION"),
+    static ConfiguredPrefab<Prefab> prefab([]()
+    {
+        Prefab area;
+        area.AddComponent(SpriteComponent(CFG_GETP("ACID_AREA_ANIMATION"),
             Vector(0, 0), 0, 0, true,
             CFG_GETF("ACID_AREA_ANIMATION_SCALE"),
             CFG_GETI("ACID_AREA_ANIMATION_NUM_FRAMES"),
-            CFG_GETF("ACID_AREA_ANIMATION_FRAME_DURATION"), true, true),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, position), area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("ACID_AREA_COLLIDER_RADIUS")),
-        area);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<VitaminComponent>(CFG_GETF("ACID_AREA_GROWTH_FACTOR")),
-        area);
-    return area;
-}
+            CFG_GETF("ACID_AREA_ANIMATION_FRAME_DURATION"), true, true));
+        ParticleComponent particleComponent(0, Vector(0, 0));
+        particleComponent.SetBodyType(StaticBody);
+        area.AddComponent(particleComponent);
+        area.AddComponent(ColliderComponent(CFG_GETF("ACID_AREA_COLLIDER_RADIUS")));
+        area.AddComponent(VitaminComponent(CFG_GETF("ACID_AREA_GROWTH_FACTOR")));
+        return area;
+    });
 
-std::shared_ptr<Entity> EntityFactory::CreateButton(std::string image,
-    Rectangle rectangle, std::function<void()> callback)
-{
-    std::shared_ptr<Entity> button = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(image), button);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ButtonComponent>(rectangle, callback), button);
-    return button;
+    return prefab.Get();
 }
 
-std::shared_ptr<Entity> EntityFactory::CreateBacterium(Vector position)
+const Prefab& EntityFactory::GetBacteriumPrefab(int type)
 {
-    Random r;
-    std::shared_ptr<Entity> bacterium = Engine::GetInstance().CreateEntity();
-    Engine::GetInstance().AddComponent(
-        std::make_shared<MoveableComponent>(), bacterium);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(CFG_GETF("BACTERIUM_INVERSE_MASS"),
-            position, Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")),
-        bacterium);
-    Engine::GetInstance().AddComponent(
-        std::make_shared<ColliderComponent>(CFG_GETF("BACTERIUM_COLLIDER_RADIUS")),
-        bacterium);
+    static ConfiguredPrefab<std::vector<Prefab>> prefabs([]()
+    {
+        std::vector<Prefab> bacteria(3);
+
+        for (auto& bacterium : bacteria)
+        {
+            bacterium.AddComponent(MoveableComponent());
+            bacterium.AddComponent(ParticleComponent(CFG_GETF("BACTERIUM_INVERSE_MASS"),
+                Vector(0, 0), Vector(0, 0), Vector(0, 0), CFG_GETF("DEFAULT_DAMPING")));
+            bacterium.AddComponent(ColliderComponent(CFG_GETF("BACTERIUM_COLLIDER_RADIUS")));
+        }
+
+        bacteria[0].AddComponent(SpriteComponent(CFG_GETP("BACTERIUM_FROZEN_IMAGE"),
+            Vector(0, 0), 0, CFG_GETF("BACTERIUM_ANGULAR_VELOCITY"), true,
+            CFG_GETF("BACTERIUM_SCALE")));
+        bacteria[0].AddComponent(InfectionComponent(CannotInput, true, false,
+            CFG_GETF("INFECTION_FROZEN_DURATION")));
+
+        bacteria[1].AddComponent(SpriteComponent(CFG_GETP("BACTERIUM_ERRACTIC_IMAGE"),
+            Vector(0, 0), 0, CFG_GETF("BACTERIUM_ANGULAR_VELOCITY"), true,
+            CFG_GETF("BACTERIUM_SCALE")));
+        bacteria[1].AddComponent(InfectionComponent(StrongImpulses, true, false,
+            CFG_GETF("INFECTION_IMPULSES_DURATION")));
 
-    switch (r.GenerateInt(0, 3))
+        bacteria[2].AddComponent(SpriteComponent(CFG_GETP("BACTERIUM_CANNOT_EAT_IMAGE"),
+            Vector(0, 0), 0, CFG_GETF("BACTERIUM_ANGULAR_VELOCITY"), true,
+            CFG_GETF("BACTERIUM_SCALE")));
+        bacteria[2].AddComponent(InfectionComponent(CannotEat, true, false,
+            CFG_GETF("INFECTION_CANNOT_EAT_DURATION")));
+
+        return bacteria;
+    });
+
+    const std::vector<Prefab>& bacteria = prefabs.Get();
+
+    if (type < 0 || type >= (int)bacteria.size())
     {
-        case 0:
-            Engine::GetInstance().AddComponent(
-                std::make_shared<SpriteComponent>(CFG_GETP("BACTERIUM_FROZEN_IMAGE"),
-                    Vector(0, 0), r.GenerateFloat(-M_PI, M_PI), CFG_GETF("BACTERIUM_ANGULAR_VELOCITY"), true,
-                    CFG_GETF("BACTERIUM_SCALE")), bacterium);
-            Engine::GetInstance().AddComponent(
-                std::make_shared<InfectionComponent>(CannotInput, true, false,
-                    CFG_GETF("INFECTION_FROZEN_DURATION")), bacterium);
-            break;
-        case 1:
-            Engine::GetInstance().AddComponent(
-                std::make_shared<SpriteComponent>(CFG_GETP("BACTERIUM_ERRACTIC_IMAGE"),
-                    Vector(0, 0), r.GenerateFloat(-M_PI, M_PI), CFG_GETF("BACTERIUM_ANGULAR_VELOCITY"), true,
-                    CFG_GETF("BACTERIUM_SCALE")), bacterium);
-            Engine::GetInstance().AddComponent(
-                std::make_shared<InfectionComponent>(StrongImpulses, true, false,
-                    CFG_GETF("INFECTION_IMPULSES_DURATION")), bacterium);
-            break;
-        case 2:
-            Engine::GetInstance().AddComponent(
-                std::make_shared<SpriteComponent>(CFG_GETP("BACTERIUM_CANNOT_EAT_IMAGE"),
-                    Vector(0, 0), r.GenerateFloat(-M_PI, M_PI), CFG_GETF("BACTERIUM_ANGULAR_VELOCITY"), true,
-                    CFG_GETF("BACTERIUM_SCALE")), bacterium);
-            Engine::GetInstance().AddComponent(
-                std::make_shared<InfectionComponent>(CannotEat, true, false,
-                    CFG_GETF("INFECTION_CANNOT_EAT_DURATION")), bacterium);
-            break;
-        default:
-            LOG_E("[EntityFactory] Bacterium type larger than permitted.");
-            exit(1);
-            break;
+        LOG_E("[EntityFactory] Bacterium type larger than permitted.");
+        exit(1);
     }
-    return bacterium;
+
+    return bacteria[type];
 }
\ No newline at end of file
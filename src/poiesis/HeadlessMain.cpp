@@ -0,0 +1,103 @@
+// Runs a level with no display, audio or input device, as fast as possible,
+// and prints the simulation throughput.
+//
+// Usage: poiesis-headless [level] [ticks] [seed] [workers]
+//
+// Each tick is a simulation step followed by a presented frame. The seed
+// defaults to the one in the configuration file and the number of workers to
+// one less than the number of hardware threads.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "bandit/Engine.h"
+
+#include "poiesis/levels/Level1.h"
+#include "poiesis/levels/Level2.h"
+#include "poiesis/levels/Level3.h"
+
+int main(int argc, char* argv[])
+{
+    LOG_SET_WARNING();
+    CFG_INIT("Configurations.cfg");
+
+    int level = (argc > 1 ? std::atoi(argv[1]) : 3);
+    unsigned int ticks = (argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000);
+    uint64_t seed = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : CFG_GETI("RANDOM_SEED"));
+    unsigned int workers = (argc > 4 ? std::strtoul(argv[4], nullptr, 10)
+        : JobSystem::GetDefaultNumberOfWorkers());
+
+    if (level < 1 || level > 3 || ticks == 0)
+    {
+        LOG_E("Usage: " << argv[0] << " [level 1-3] [ticks > 0] [seed] [workers]");
+        return 1;
+    }
+
+    float timeStep = CFG_GETF("SIMULATION_TIME_STEP");
+    auto graphicsAdapter = std::make_shared<NullGraphicsAdapter>();
+    auto inputAdapter = std::make_shared<ScriptedInputAdapter>();
+
+    // Inputs are processed once per tick, so quitting at the given tick
+    // stops right after that many ticks.
+    inputAdapter->Schedule(ticks, InputType::QuitButtonPress);
+
+    // The virtual clock advances by one time step per frame, so each frame
+    // runs exactly one simulation step.
+    Engine::GetInstance().Initialize(
+        std::make_shared<NullSystemAdapter>(),
+        std::make_shared<VirtualTimerAdapter>(timeStep),
+        graphicsAdapter,
+        std::make_shared<NullAudioAdapter>(),
+        std::make_shared<NullAudioAdapter>(),
+        inputAdapter,
+        std::make_shared<EntityManager>(),
+        std::make_shared<LevelManager>(),
+        std::make_shared<SystemManager>(),
+        std::make_shared<JobSystem>(workers));
+
+    Engine::GetInstance().SetRandomSeed(seed);
+    Engine::GetInstance().SetTimeStep(timeStep);
+    Engine::GetInstance().SetMaxStepsPerFrame(1);
+    Engine::GetInstance().SetTargetFrameRate(0);
+
+    Profiler::GetInstance().SetEnabled(CFG_GETB("PROFILER")
+        || CFG_GETB("PROFILER_TRACE"));
+
+    if (CFG_GETB("PROFILER_TRACE"))
+        Profiler::GetInstance().StartTrace(CFG_GETI("PROFILER_TRACE_MAX_ZONES"));
+
+    if (level == 1)
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level1>());
+    else if (level == 2)
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level2>());
+    else
+        Engine::GetInstance().SetCurrentLevel(std::make_shared<Level3>());
+
+    auto start = std::chrono::steady_clock::now();
+    Engine::GetInstance().Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Ticks run short when the game finishes on its own, and the tick
+    // quitting is not simulated.
+    unsigned int ranTicks = inputAdapter->GetTick();
+
+    if (inputAdapter->CheckInputOccurred(InputType::QuitButtonPress))
+        --ranTicks;
+
+    std::cout << "Level " << level << ": " << ranTicks << " ticks in "
+        << elapsed.count() << " s, " << ranTicks/elapsed.count()
+        << " ticks/s, " << elapsed.count()*1000/ranTicks << " ms/tick, "
+        << Engine::GetInstance().GetNumberOfEntities() << " entities, "
+        << graphicsAdapter->GetNumberOfRenderings() << " renderings, "
+        << workers << " workers, seed " << Engine::GetInstance().GetRandomSeed()
+        << std::endl;
+
+    if (CFG_GETB("PROFILER_TRACE"))
+        Profiler::GetInstance().WriteTrace(CFG_GETS("PROFILER_TRACE_FILE"));
+
+    BANDIT_ENGINE_SHUTDOWN();
+
+    return 0;
+}
\ No newline at end of file
@@ -10,6 +10,22 @@ int main()
     LOG_SET_INFO();
     BANDIT_ENGINE_INIT();
     CFG_INIT("Configurations.cfg");
+    Engine::GetInstance().SetRandomSeed(CFG_GETI("RANDOM_SEED"));
+    Engine::GetInstance().SetTimeStep(CFG_GETF("SIMULATION_TIME_STEP"));
+    Engine::GetInstance().SetMaxStepsPerFrame(
+        CFG_GETI("SIMULATION_MAX_STEPS_PER_FRAME"));
+    Engine::GetInstance().SetTargetFrameRate(CFG_GETF("FRAME_RATE"));
+
+    Profiler::GetInstance().SetEnabled(CFG_GETB("PROFILER")
+        || CFG_GETB("PROFILER_TRACE"));
+
+    if (CFG_GETB("PROFILER_TRACE"))
+        Profiler::GetInstance().StartTrace(CFG_GETI("PROFILER_TRACE_MAX_ZONES"));
+
+    if (CFG_GETS("REPLAY_MODE") == "record")
+        Engine::GetInstance().RecordReplay(CFG_GETS("REPLAY_FILE"));
+    else if (CFG_GETS("REPLAY_MODE") == "play")
+        Engine::GetInstance().PlayReplay(CFG_GETS("REPLAY_FILE"));
 
     Engine::GetInstance().CreateWindow(CFG_GETS("WINDOW_TITLE"),
         CFG_GETI("WINDOW_WIDTH"), CFG_GETI("WINDOW_HEIGHT"));
@@ -17,6 +33,9 @@ int main()
     Engine::GetInstance().SetCurrentLevel(std::make_shared<EntryLevel>());
     Engine::GetInstance().Run();
 
+    if (CFG_GETB("PROFILER_TRACE"))
+        Profiler::GetInstance().WriteTrace(CFG_GETS("PROFILER_TRACE_FILE"));
+
     BANDIT_ENGINE_SHUTDOWN();
 
     return 0;
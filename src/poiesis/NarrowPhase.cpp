@@ -0,0 +1,126 @@
+#include "poiesis/NarrowPhase.h"
+
+void NarrowPhase::SetCircle(Entity entity, Vector position, float radius)
+{
+    unsigned int id = entity.GetId();
+
+    if (id >= circlesX.size())
+    {
+        circlesX.resize(id + 1);
+        circlesY.resize(id + 1);
+        circlesRadius.resize(id + 1);
+    }
+
+    circlesX[id] = position.GetX();
+    circlesY[id] = position.GetY();
+    circlesRadius[id] = radius;
+}
+
+void NarrowPhase::FindContacts(
+    const std::vector<std::pair<Entity, Entity>>& pairs,
+    unsigned int grainSize, std::vector<Contact>& contacts)
+{
+    unsigned int numberOfBlocks = (pairs.size() + BLOCK_SIZE - 1)/BLOCK_SIZE;
+    unsigned int paddedSize = numberOfBlocks*BLOCK_SIZE;
+
+    x1.resize(paddedSize);
+    y1.resize(paddedSize);
+    x2.resize(paddedSize);
+    y2.resize(paddedSize);
+    radiusSums.resize(paddedSize);
+    overlapping.resize(paddedSize);
+
+    // Jobs take whole blocks, so no block is shared by two of them.
+    Engine::GetInstance().GetJobSystem()->ParallelFor(
+        numberOfBlocks, (grainSize + BLOCK_SIZE - 1)/BLOCK_SIZE,
+        [this, &pairs](unsigned int firstBlock, unsigned int lastBlock)
+        {
+            TestPairs(pairs, firstBlock*BLOCK_SIZE, lastBlock*BLOCK_SIZE);
+        });
+
+    contacts.clear();
+
+    for (unsigned int i = 0; i < pairs.size(); ++i)
+    {
+        if (!overlapping[i])
+            continue;
+
+        Contact contact;
+        unsigned int id1 = pairs[i].first.GetId();
+        unsigned int id2 = pairs[i].second.GetId();
+
+        // Rounding may disagree with the packed test by a hair, in which case
+        // the pair is dropped.
+        if (CreateContact(pairs[i].first, Vector(circlesX[id1], circlesY[id1]),
+            circlesRadius[id1], pairs[i].second,
+            Vector(circlesX[id2], circlesY[id2]), circlesRadius[id2], contact))
+            contacts.push_back(contact);
+    }
+}
+
+bool NarrowPhase::CreateContact(Entity entity1, Vector position1,
+    float radius1, Entity entity2, Vector position2, float radius2,
+    Contact& contact)
+{
+    float distance = position1.CalculateDistance(position2);
+
+    if (distance >= radius1 + radius2)
+        return false;
+
+    contact.entity1 = entity1;
+    contact.entity2 = entity2;
+    contact.penetration = radius1 + radius2 - distance;
+
+    if (distance > 0)
+        contact.normal.Set((position2 - position1)*(1/distance));
+    else
+        contact.normal.Set(0, 0);
+
+    return true;
+}
+
+void NarrowPhase::TestPairs(const std::vector<std::pair<Entity, Entity>>& pairs,
+    unsigned int first, unsigned int last)
+{
+    for (unsigned int i = first; i < last; ++i)
+    {
+        // Padding pairs never overlap.
+        if (i >= pairs.size())
+        {
+            x1[i] = y1[i] = x2[i] = y2[i] = 0;
+            radiusSums[i] = 0;
+            continue;
+        }
+
+        unsigned int id1 = pairs[i].first.GetId();
+        unsigned int id2 = pairs[i].second.GetId();
+        x1[i] = circlesX[id1];
+        y1[i] = circlesY[id1];
+        x2[i] = circlesX[id2];
+        y2[i] = circlesY[id2];
+        radiusSums[i] = circlesRadius[id1] + circlesRadius[id2];
+    }
+
+#ifdef __SSE2__
+    for (unsigned int i = first; i < last; i += BLOCK_SIZE)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&x2[i]), _mm_loadu_ps(&x1[i]));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&y2[i]), _mm_loadu_ps(&y1[i]));
+        __m128 radiusSum = _mm_loadu_ps(&radiusSums[i]);
+        __m128 squaredDistance = _mm_add_ps(_mm_mul_ps(dx, dx),
+            _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(squaredDistance,
+            _mm_mul_ps(radiusSum, radiusSum)));
+
+        for (unsigned int j = 0; j < BLOCK_SIZE; ++j)
+            overlapping[i + j] = (mask >> j) & 1;
+    }
+#else
+    for (unsigned int i = first; i < last; ++i)
+    {
+        float dx = x2[i] - x1[i];
+        float dy = y2[i] - y1[i];
+        overlapping[i] = (dx*dx + dy*dy < radiusSums[i]*radiusSums[i]);
+    }
+#endif
+}
\ No newline at end of file
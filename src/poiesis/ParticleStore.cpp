@@ -0,0 +1,301 @@
+#include "poiesis/ParticleStore.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARTICLE_STORE_AVX2
+#include <immintrin.h>
+#endif
+
+ParticleStore::ParticleStore() :
+    kernel(IntegrateScalar), kernelName("scalar"), size(0)
+{
+#ifdef PARTICLE_STORE_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernel = IntegrateAvx2;
+        kernelName = "avx2";
+    }
+#endif
+
+    LOG_D("[ParticleStore] Using " << kernelName << " integrator.");
+}
+
+const std::shared_ptr<ParticleStore>& ParticleStore::GetIntegratedStore()
+{
+    static std::shared_ptr<ParticleStore> store =
+        std::make_shared<ParticleStore>();
+    return store;
+}
+
+const std::shared_ptr<ParticleStore>& ParticleStore::GetDetachedStore()
+{
+    static std::shared_ptr<ParticleStore> store =
+        std::make_shared<ParticleStore>();
+    return store;
+}
+
+std::string ParticleStore::GetKernelName()
+{
+    return kernelName;
+}
+
+unsigned int ParticleStore::Create()
+{
+    unsigned int index;
+
+    if (freeIndices.empty())
+    {
+        index = positionsX.size();
+
+        positionsX.push_back(0);
+        positionsY.push_back(0);
+        velocitiesX.push_back(0);
+        velocitiesY.push_back(0);
+        accelerationsX.push_back(0);
+        accelerationsY.push_back(0);
+        forcesX.push_back(0);
+        forcesY.push_back(0);
+        randomForcesX.push_back(0);
+        randomForcesY.push_back(0);
+        inverseMasses.push_back(0);
+        dampings.push_back(1);
+        angles.push_back(0);
+        angularVelocities.push_back(0);
+        previousPositionsX.push_back(0);
+        previousPositionsY.push_back(0);
+        previousAngles.push_back(0);
+        hasPreviousStates.push_back(0);
+        dynamics.push_back(0);
+    }
+    else
+    {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+
+        positionsX[index] = 0;
+        positionsY[index] = 0;
+        velocitiesX[index] = 0;
+        velocitiesY[index] = 0;
+        accelerationsX[index] = 0;
+        accelerationsY[index] = 0;
+        forcesX[index] = 0;
+        forcesY[index] = 0;
+        inverseMasses[index] = 0;
+        dampings[index] = 1;
+        angles[index] = 0;
+        angularVelocities[index] = 0;
+        hasPreviousStates[index] = 0;
+    }
+
+    ++size;
+
+    return index;
+}
+
+void ParticleStore::Destroy(unsigned int index)
+{
+    dynamics[index] = 0;
+    freeIndices.push_back(index);
+    --size;
+
+    // The capacity is kept, so starting over allocates nothing.
+    if (size == 0)
+    {
+        positionsX.clear();
+        positionsY.clear();
+        velocitiesX.clear();
+        velocitiesY.clear();
+        accelerationsX.clear();
+        accelerationsY.clear();
+        forcesX.clear();
+        forcesY.clear();
+        randomForcesX.clear();
+        randomForcesY.clear();
+        inverseMasses.clear();
+        dampings.clear();
+        angles.clear();
+        angularVelocities.clear();
+        previousPositionsX.clear();
+        previousPositionsY.clear();
+        previousAngles.clear();
+        hasPreviousStates.clear();
+        dynamics.clear();
+        freeIndices.clear();
+    }
+}
+
+void ParticleStore::Copy(unsigned int index, ParticleStore& source,
+    unsigned int sourceIndex)
+{
+    positionsX[index] = source.positionsX[sourceIndex];
+    positionsY[index] = source.positionsY[sourceIndex];
+    velocitiesX[index] = source.velocitiesX[sourceIndex];
+    velocitiesY[index] = source.velocitiesY[sourceIndex];
+    accelerationsX[index] = source.accelerationsX[sourceIndex];
+    accelerationsY[index] = source.accelerationsY[sourceIndex];
+    forcesX[index] = source.forcesX[sourceIndex];
+    forcesY[index] = source.forcesY[sourceIndex];
+    inverseMasses[index] = source.inverseMasses[sourceIndex];
+    dampings[index] = source.dampings[sourceIndex];
+    angles[index] = source.angles[sourceIndex];
+    angularVelocities[index] = source.angularVelocities[sourceIndex];
+    previousPositionsX[index] = source.previousPositionsX[sourceIndex];
+    previousPositionsY[index] = source.previousPositionsY[sourceIndex];
+    previousAngles[index] = source.previousAngles[sourceIndex];
+    hasPreviousStates[index] = source.hasPreviousStates[sourceIndex];
+    dynamics[index] = source.dynamics[sourceIndex];
+}
+
+unsigned int ParticleStore::GetNumberOfSlots()
+{
+    return positionsX.size();
+}
+
+void ParticleStore::GenerateRandomForces(unsigned int first,
+    unsigned int last, Random& random, float magnitude)
+{
+    if (first == last)
+        return;
+
+    random.GenerateFloats(&randomForcesX[first], last - first, -magnitude,
+        magnitude);
+    random.GenerateFloats(&randomForcesY[first], last - first, -magnitude,
+        magnitude);
+}
+
+void ParticleStore::Integrate(unsigned int first, unsigned int last, float dt)
+{
+    kernel(*this, first, last, dt);
+}
+
+void ParticleStore::IntegrateScalar(ParticleStore& store, unsigned int first,
+    unsigned int last, float dt)
+{
+    float halfDtSquare = dt*dt*0.5f;
+
+    for (unsigned int i = first; i < last; ++i)
+    {
+        if (store.dynamics[i] == 0)
+            continue;
+
+        float accelerationX = store.accelerationsX[i];
+        float accelerationY = store.accelerationsY[i];
+
+        store.previousPositionsX[i] = store.positionsX[i];
+        store.previousPositionsY[i] = store.positionsY[i];
+        store.previousAngles[i] = store.angles[i];
+        store.hasPreviousStates[i] = 1;
+
+        store.positionsX[i] += store.velocitiesX[i]*dt + accelerationX*halfDtSquare;
+        store.positionsY[i] += store.velocitiesY[i]*dt + accelerationY*halfDtSquare;
+        store.velocitiesX[i] = store.velocitiesX[i]*store.dampings[i] + accelerationX*dt;
+        store.velocitiesY[i] = store.velocitiesY[i]*store.dampings[i] + accelerationY*dt;
+        store.accelerationsX[i] = (store.forcesX[i] + store.randomForcesX[i])*store.inverseMasses[i];
+        store.accelerationsY[i] = (store.forcesY[i] + store.randomForcesY[i])*store.inverseMasses[i];
+        store.angles[i] = WrapAngle(store.angles[i] + store.angularVelocities[i]*dt);
+
+        // Erases the force vector since if no force is applied, no
+        // acceleration exists.
+        store.forcesX[i] = 0;
+        store.forcesY[i] = 0;
+    }
+}
+
+#ifdef PARTICLE_STORE_AVX2
+
+__attribute__((target("avx2")))
+void ParticleStore::IntegrateAvx2(ParticleStore& store, unsigned int first,
+    unsigned int last, float dt)
+{
+    const unsigned int width = 8;
+    const __m256 zeros = _mm256_setzero_ps();
+    const __m256 ones = _mm256_set1_ps(1);
+    const __m256 dts = _mm256_set1_ps(dt);
+    const __m256 halfDtSquares = _mm256_set1_ps(dt*dt*0.5f);
+    const __m256 pis = _mm256_set1_ps(M_PI);
+    const __m256 twoPis = _mm256_set1_ps(2*M_PI);
+    unsigned int i = first;
+
+    for (; i + width <= last; i += width)
+    {
+        // Lanes of static bodies and released indices keep their values.
+        __m256 dynamics = _mm256_cmp_ps(_mm256_loadu_ps(&store.dynamics[i]),
+            zeros, _CMP_NEQ_OQ);
+
+        if (_mm256_movemask_ps(dynamics) == 0)
+            continue;
+
+        __m256 positionsX = _mm256_loadu_ps(&store.positionsX[i]);
+        __m256 positionsY = _mm256_loadu_ps(&store.positionsY[i]);
+        __m256 velocitiesX = _mm256_loadu_ps(&store.velocitiesX[i]);
+        __m256 velocitiesY = _mm256_loadu_ps(&store.velocitiesY[i]);
+        __m256 accelerationsX = _mm256_loadu_ps(&store.accelerationsX[i]);
+        __m256 accelerationsY = _mm256_loadu_ps(&store.accelerationsY[i]);
+        __m256 forcesX = _mm256_loadu_ps(&store.forcesX[i]);
+        __m256 forcesY = _mm256_loadu_ps(&store.forcesY[i]);
+        __m256 dampings = _mm256_loadu_ps(&store.dampings[i]);
+        __m256 inverseMasses = _mm256_loadu_ps(&store.inverseMasses[i]);
+        __m256 angles = _mm256_loadu_ps(&store.angles[i]);
+        __m256 angularVelocities = _mm256_loadu_ps(&store.angularVelocities[i]);
+
+        _mm256_storeu_ps(&store.previousPositionsX[i], _mm256_blendv_ps(
+            _mm256_loadu_ps(&store.previousPositionsX[i]), positionsX, dynamics));
+        _mm256_storeu_ps(&store.previousPositionsY[i], _mm256_blendv_ps(
+            _mm256_loadu_ps(&store.previousPositionsY[i]), positionsY, dynamics));
+        _mm256_storeu_ps(&store.previousAngles[i], _mm256_blendv_ps(
+            _mm256_loadu_ps(&store.previousAngles[i]), angles, dynamics));
+        _mm256_storeu_ps(&store.hasPreviousStates[i], _mm256_blendv_ps(
+            _mm256_loadu_ps(&store.hasPreviousStates[i]), ones, dynamics));
+
+        __m256 newPositionsX = _mm256_add_ps(positionsX, _mm256_add_ps(
+            _mm256_mul_ps(velocitiesX, dts),
+            _mm256_mul_ps(accelerationsX, halfDtSquares)));
+        __m256 newPositionsY = _mm256_add_ps(positionsY, _mm256_add_ps(
+            _mm256_mul_ps(velocitiesY, dts),
+            _mm256_mul_ps(accelerationsY, halfDtSquares)));
+        __m256 newVelocitiesX = _mm256_add_ps(
+            _mm256_mul_ps(velocitiesX, dampings),
+            _mm256_mul_ps(accelerationsX, dts));
+        __m256 newVelocitiesY = _mm256_add_ps(
+            _mm256_mul_ps(velocitiesY, dampings),
+            _mm256_mul_ps(accelerationsY, dts));
+        __m256 newAccelerationsX = _mm256_mul_ps(_mm256_add_ps(forcesX,
+            _mm256_loadu_ps(&store.randomForcesX[i])), inverseMasses);
+        __m256 newAccelerationsY = _mm256_mul_ps(_mm256_add_ps(forcesY,
+            _mm256_loadu_ps(&store.randomForcesY[i])), inverseMasses);
+
+        __m256 newAngles = _mm256_add_ps(angles,
+            _mm256_mul_ps(angularVelocities, dts));
+        __m256 turns = _mm256_floor_ps(
+            _mm256_div_ps(_mm256_add_ps(newAngles, pis), twoPis));
+        newAngles = _mm256_sub_ps(newAngles, _mm256_mul_ps(turns, twoPis));
+
+        _mm256_storeu_ps(&store.positionsX[i],
+            _mm256_blendv_ps(positionsX, newPositionsX, dynamics));
+        _mm256_storeu_ps(&store.positionsY[i],
+            _mm256_blendv_ps(positionsY, newPositionsY, dynamics));
+        _mm256_storeu_ps(&store.velocitiesX[i],
+            _mm256_blendv_ps(velocitiesX, newVelocitiesX, dynamics));
+        _mm256_storeu_ps(&store.velocitiesY[i],
+            _mm256_blendv_ps(velocitiesY, newVelocitiesY, dynamics));
+        _mm256_storeu_ps(&store.accelerationsX[i],
+            _mm256_blendv_ps(accelerationsX, newAccelerationsX, dynamics));
+        _mm256_storeu_ps(&store.accelerationsY[i],
+            _mm256_blendv_ps(accelerationsY, newAccelerationsY, dynamics));
+        _mm256_storeu_ps(&store.forcesX[i],
+            _mm256_blendv_ps(forcesX, zeros, dynamics));
+        _mm256_storeu_ps(&store.forcesY[i],
+            _mm256_blendv_ps(forcesY, zeros, dynamics));
+        _mm256_storeu_ps(&store.angles[i],
+            _mm256_blendv_ps(angles, newAngles, dynamics));
+    }
+
+    IntegrateScalar(store, i, last, dt);
+}
+
+#endif
+
+float ParticleStore::WrapAngle(float angle)
+{
+    const float twoPi = 2*M_PI;
+    return angle - std::floor((angle + static_cast<float>(M_PI))/twoPi)*twoPi;
+}
\ No newline at end of file
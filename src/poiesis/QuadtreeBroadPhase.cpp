@@ -0,0 +1,62 @@
+#include "poiesis/QuadtreeBroadPhase.h"
+
+QuadtreeBroadPhase::QuadtreeBroadPhase(Rectangle area) : area(area)
+{
+}
+
+std::string QuadtreeBroadPhase::GetName()
+{
+    return "quadtree";
+}
+
+void QuadtreeBroadPhase::GetPairs(std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    Quadtree<unsigned int> quadtree(area);
+
+    pairs.clear();
+    idPairs.clear();
+
+    for (auto id : insertedProxies)
+        quadtree.Add(id, GetCenter(id));
+
+    for (auto id : insertedProxies)
+    {
+        for (auto otherId : quadtree.Get(GetCenter(id)))
+        {
+            if (id != otherId && Overlap(proxies[id], proxies[otherId]))
+                idPairs.push_back(std::make_pair(std::min(id, otherId),
+                    std::max(id, otherId)));
+        }
+    }
+
+    std::sort(idPairs.begin(), idPairs.end());
+    idPairs.erase(std::unique(idPairs.begin(), idPairs.end()), idPairs.end());
+
+    for (auto& idPair : idPairs)
+    {
+        pairs.push_back(std::make_pair(proxies[idPair.first].entity,
+            proxies[idPair.second].entity));
+    }
+}
+
+void QuadtreeBroadPhase::OnInsert(unsigned int)
+{
+}
+
+void QuadtreeBroadPhase::OnMove(unsigned int)
+{
+}
+
+void QuadtreeBroadPhase::OnRemove(unsigned int)
+{
+}
+
+void QuadtreeBroadPhase::OnClear()
+{
+}
+
+Vector QuadtreeBroadPhase::GetCenter(unsigned int id)
+{
+    return Vector((proxies[id].minX + proxies[id].maxX)/2,
+        (proxies[id].minY + proxies[id].maxY)/2);
+}
\ No newline at end of file
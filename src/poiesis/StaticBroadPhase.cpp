@@ -0,0 +1,153 @@
+#include "poiesis/StaticBroadPhase.h"
+
+StaticBroadPhase::StaticBroadPhase(float cellSize) :
+    cellSize(cellSize), outdated(false)
+{
+    if (cellSize <= 0)
+    {
+        LOG_E("[StaticBroadPhase] Cell size must be positive.");
+        exit(1);
+    }
+}
+
+std::string StaticBroadPhase::GetName()
+{
+    return "static";
+}
+
+void StaticBroadPhase::GetPairs(std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    pairs.clear();
+
+    for (auto id : insertedProxies)
+    {
+        const Proxy& proxy = proxies[id];
+        Query(proxy.entity, proxy.minX, proxy.minY, proxy.maxX, proxy.maxY,
+            pairs);
+    }
+
+    // Each pair was found from both of its bodies.
+    pairs.erase(std::remove_if(pairs.begin(), pairs.end(),
+        [](const std::pair<Entity, Entity>& pair)
+        {
+            return (pair.first.GetId() > pair.second.GetId());
+        }), pairs.end());
+}
+
+void StaticBroadPhase::Query(Entity entity, Vector position, float radius,
+    std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    Query(entity, position.GetX() - radius, position.GetY() - radius,
+        position.GetX() + radius, position.GetY() + radius, pairs);
+}
+
+void StaticBroadPhase::OnInsert(unsigned int)
+{
+    outdated = true;
+}
+
+void StaticBroadPhase::OnMove(unsigned int)
+{
+    outdated = true;
+}
+
+void StaticBroadPhase::OnRemove(unsigned int)
+{
+    outdated = true;
+}
+
+void StaticBroadPhase::OnClear()
+{
+    outdated = true;
+}
+
+int StaticBroadPhase::GetCellCoordinate(float coordinate)
+{
+    return static_cast<int>(std::floor(coordinate/cellSize));
+}
+
+long long StaticBroadPhase::GetCellKey(int x, int y)
+{
+    return (static_cast<long long>(x) << 32) | static_cast<unsigned int>(y);
+}
+
+void StaticBroadPhase::Query(Entity entity, float minX, float minY,
+    float maxX, float maxY, std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    if (outdated)
+        Build();
+
+    Proxy query;
+    query.minX = minX;
+    query.minY = minY;
+    query.maxX = maxX;
+    query.maxY = maxY;
+
+    int firstX = GetCellCoordinate(minX);
+    int firstY = GetCellCoordinate(minY);
+    int lastX = GetCellCoordinate(maxX);
+    int lastY = GetCellCoordinate(maxY);
+
+    for (int x = firstX; x <= lastX; ++x)
+    {
+        for (int y = firstY; y <= lastY; ++y)
+        {
+            auto it = cellRanges.find(GetCellKey(x, y));
+
+            if (it == cellRanges.end())
+                continue;
+
+            for (unsigned int i = it->second.first; i < it->second.second; ++i)
+            {
+                const Proxy& proxy = proxies[cellProxies[i]];
+
+                if (proxy.entity == entity || !Overlap(query, proxy))
+                    continue;
+
+                // Both boxes are listed by every cell of the overlap, but
+                // only the first one reports them.
+                int overlapCellX = std::max(firstX, GetCellCoordinate(proxy.minX));
+                int overlapCellY = std::max(firstY, GetCellCoordinate(proxy.minY));
+
+                if (overlapCellX == x && overlapCellY == y)
+                    pairs.push_back(std::make_pair(entity, proxy.entity));
+            }
+        }
+    }
+}
+
+void StaticBroadPhase::Build()
+{
+    entries.clear();
+
+    for (auto id : insertedProxies)
+    {
+        const Proxy& proxy = proxies[id];
+        int firstX = GetCellCoordinate(proxy.minX);
+        int firstY = GetCellCoordinate(proxy.minY);
+        int lastX = GetCellCoordinate(proxy.maxX);
+        int lastY = GetCellCoordinate(proxy.maxY);
+
+        for (int x = firstX; x <= lastX; ++x)
+        {
+            for (int y = firstY; y <= lastY; ++y)
+                entries.push_back(std::make_pair(GetCellKey(x, y), id));
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+
+    cellProxies.clear();
+    cellRanges.clear();
+
+    for (unsigned int i = 0; i < entries.size(); ++i)
+    {
+        if (i == 0 || entries[i].first != entries[i - 1].first)
+            cellRanges[entries[i].first] = std::make_pair(i, i);
+
+        cellRanges[entries[i].first].second = i + 1;
+        cellProxies.push_back(entries[i].second);
+    }
+
+    outdated = false;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "poiesis/SweepAndPrune.h"
+
+SweepAndPrune::SweepAndPrune() : hasRemovedEndpoints(false)
+{
+}
+
+std::string SweepAndPrune::GetName()
+{
+    return "sweep_and_prune";
+}
+
+void SweepAndPrune::GetPairs(std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    pairs.clear();
+
+    if (hasRemovedEndpoints)
+    {
+        endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+            [this](const Endpoint& endpoint) { return !IsValid(endpoint); }),
+            endpoints.end());
+        hasRemovedEndpoints = false;
+    }
+
+    // Entities moved since the last sort only shift a few positions.
+    for (unsigned int i = 0; i < endpoints.size(); ++i)
+    {
+        Proxy& proxy = proxies[endpoints[i].id];
+        endpoints[i].value = endpoints[i].isMin ? proxy.minX : proxy.maxX;
+    }
+
+    for (unsigned int i = 1; i < endpoints.size(); ++i)
+    {
+        Endpoint endpoint = endpoints[i];
+        unsigned int j = i;
+
+        for (; j > 0 && IsBefore(endpoint, endpoints[j - 1]); --j)
+            endpoints[j] = endpoints[j - 1];
+
+        endpoints[j] = endpoint;
+    }
+
+    activePositions.resize(proxies.size());
+    activeProxies.clear();
+
+    for (auto& endpoint : endpoints)
+    {
+        unsigned int id = endpoint.id;
+
+        if (endpoint.isMin)
+        {
+            for (auto activeId : activeProxies)
+            {
+                if (Overlap(proxies[activeId], proxies[id]))
+                {
+                    pairs.push_back(
+                        std::make_pair(proxies[activeId].entity, proxies[id].entity));
+                }
+            }
+
+            activePositions[id] = activeProxies.size();
+            activeProxies.push_back(id);
+        }
+        else
+        {
+            unsigned int position = activePositions[id];
+            activeProxies[position] = activeProxies.back();
+            activePositions[activeProxies[position]] = position;
+            activeProxies.pop_back();
+        }
+    }
+}
+
+void SweepAndPrune::OnInsert(unsigned int id)
+{
+    if (id >= insertions.size())
+        insertions.resize(id + 1, 0);
+
+    ++insertions[id];
+
+    Endpoint endpoint;
+    endpoint.id = id;
+    endpoint.insertion = insertions[id];
+
+    // New endpoints are sorted along with the others by the next sweep.
+    endpoint.isMin = true;
+    endpoint.value = proxies[id].minX;
+    endpoints.push_back(endpoint);
+
+    endpoint.isMin = false;
+    endpoint.value = proxies[id].maxX;
+    endpoints.push_back(endpoint);
+}
+
+void SweepAndPrune::OnMove(unsigned int)
+{
+    // Endpoints are read from the entities when they are sorted.
+}
+
+void SweepAndPrune::OnRemove(unsigned int)
+{
+    hasRemovedEndpoints = true;
+}
+
+void SweepAndPrune::OnClear()
+{
+    endpoints.clear();
+    hasRemovedEndpoints = false;
+}
+
+bool SweepAndPrune::IsBefore(const Endpoint& endpoint1,
+    const Endpoint& endpoint2)
+{
+    if (endpoint1.value != endpoint2.value)
+        return (endpoint1.value < endpoint2.value);
+
+    return (endpoint1.isMin && !endpoint2.isMin);
+}
+
+bool SweepAndPrune::IsValid(const Endpoint& endpoint)
+{
+    return (proxies[endpoint.id].inserted
+        && insertions[endpoint.id] == endpoint.insertion);
+}
\ No newline at end of file
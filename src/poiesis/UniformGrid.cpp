@@ -0,0 +1,179 @@
+#include "poiesis/UniformGrid.h"
+
+UniformGrid::UniformGrid(float cellSize) : cellSize(cellSize)
+{
+    if (cellSize <= 0)
+    {
+        LOG_E("[UniformGrid] Cell size must be positive.");
+        exit(1);
+    }
+}
+
+std::string UniformGrid::GetName()
+{
+    return "grid";
+}
+
+void UniformGrid::GetPairs(std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    pairs.clear();
+
+    for (auto index : occupiedCells)
+    {
+        Cell& cell = cells[index];
+
+        for (unsigned int i = 0; i < cell.proxies.size(); ++i)
+        {
+            unsigned int id1 = cell.proxies[i];
+
+            for (unsigned int j = i + 1; j < cell.proxies.size(); ++j)
+            {
+                unsigned int id2 = cell.proxies[j];
+
+                if (!Overlap(proxies[id1], proxies[id2]))
+                    continue;
+
+                // Both entities are listed by every cell of the overlap, but
+                // only the first one reports them.
+                int overlapCellX = std::max(ranges[id1].firstX, ranges[id2].firstX);
+                int overlapCellY = std::max(ranges[id1].firstY, ranges[id2].firstY);
+
+                if (overlapCellX == cell.x && overlapCellY == cell.y)
+                {
+                    pairs.push_back(
+                        std::make_pair(proxies[id1].entity, proxies[id2].entity));
+                }
+            }
+        }
+    }
+}
+
+void UniformGrid::OnInsert(unsigned int id)
+{
+    if (id >= ranges.size())
+        ranges.resize(id + 1);
+
+    ranges[id] = GetCellRange(id);
+    InsertIntoCells(id);
+}
+
+void UniformGrid::OnMove(unsigned int id)
+{
+    CellRange range = GetCellRange(id);
+
+    if (range.firstX == ranges[id].firstX && range.firstY == ranges[id].firstY
+        && range.lastX == ranges[id].lastX && range.lastY == ranges[id].lastY)
+        return;
+
+    RemoveFromCells(id);
+    ranges[id] = range;
+    InsertIntoCells(id);
+}
+
+void UniformGrid::OnRemove(unsigned int id)
+{
+    RemoveFromCells(id);
+}
+
+void UniformGrid::OnClear()
+{
+    for (auto index : occupiedCells)
+        cells[index].proxies.clear();
+
+    occupiedCells.clear();
+}
+
+int UniformGrid::GetCellCoordinate(float coordinate)
+{
+    return static_cast<int>(std::floor(coordinate/cellSize));
+}
+
+UniformGrid::CellRange UniformGrid::GetCellRange(unsigned int id)
+{
+    CellRange range;
+    range.firstX = GetCellCoordinate(proxies[id].minX);
+    range.firstY = GetCellCoordinate(proxies[id].minY);
+    range.lastX = GetCellCoordinate(proxies[id].maxX);
+    range.lastY = GetCellCoordinate(proxies[id].maxY);
+    return range;
+}
+
+unsigned int UniformGrid::GetCell(int x, int y)
+{
+    long long key = (static_cast<long long>(x) << 32)
+        | static_cast<unsigned int>(y);
+    auto it = cellIndices.find(key);
+
+    if (it != cellIndices.end())
+        return it->second;
+
+    Cell cell;
+    cell.x = x;
+    cell.y = y;
+    cell.occupiedPosition = 0;
+    cellIndices[key] = cells.size();
+    cells.push_back(cell);
+    return cells.size() - 1;
+}
+
+void UniformGrid::InsertIntoCells(unsigned int id)
+{
+    CellRange& range = ranges[id];
+
+    for (int x = range.firstX; x <= range.lastX; ++x)
+    {
+        for (int y = range.firstY; y <= range.lastY; ++y)
+        {
+            unsigned int index = GetCell(x, y);
+
+            if (cells[index].proxies.empty())
+                MarkOccupied(index);
+
+            cells[index].proxies.push_back(id);
+        }
+    }
+}
+
+void UniformGrid::RemoveFromCells(unsigned int id)
+{
+    CellRange& range = ranges[id];
+
+    for (int x = range.firstX; x <= range.lastX; ++x)
+    {
+        for (int y = range.firstY; y <= range.lastY; ++y)
+        {
+            unsigned int index = GetCell(x, y);
+            auto& cellProxies = cells[index].proxies;
+
+            for (unsigned int i = 0; i < cellProxies.size(); ++i)
+            {
+                if (cellProxies[i] == id)
+                {
+                    cellProxies[i] = cellProxies.back();
+                    cellProxies.pop_back();
+
+                    if (cellProxies.empty())
+                        MarkEmpty(index);
+
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void UniformGrid::MarkOccupied(unsigned int index)
+{
+    cells[index].occupiedPosition = occupiedCells.size();
+    occupiedCells.push_back(index);
+}
+
+void UniformGrid::MarkEmpty(unsigned int index)
+{
+    unsigned int position = cells[index].occupiedPosition;
+    unsigned int lastIndex = occupiedCells.back();
+
+    occupiedCells[position] = lastIndex;
+    cells[lastIndex].occupiedPosition = position;
+    occupiedCells.pop_back();
+}
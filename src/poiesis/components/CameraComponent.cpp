@@ -1,7 +1,7 @@
 #include "poiesis/components/CameraComponent.h"
 
 CameraComponent::CameraComponent(Vector position, float height) :
-    position(position), height(height)
+    position(position), height(height), hasPreviousPosition(false)
 {
 }
 
@@ -28,4 +28,18 @@ float CameraComponent::GetHeight()
 void CameraComponent::SetHeight(float height)
 {
     this->height = height;
+}
+
+void CameraComponent::SavePreviousPosition()
+{
+    previousPosition.Set(position);
+    hasPreviousPosition = true;
+}
+
+Vector CameraComponent::GetInterpolatedPosition(float interpolation)
+{
+    if (!hasPreviousPosition)
+        return position;
+
+    return previousPosition + (position - previousPosition)*interpolation;
 }
\ No newline at end of file
@@ -3,15 +3,47 @@
 ParticleComponent::ParticleComponent(float inverseMass, Vector position,
     Vector velocity, Vector acceleration, float damping, float angle,
     float angularVelocity) :
-    inverseMass(inverseMass), position(position), velocity(velocity),
-    acceleration(acceleration), damping(damping), angle(angle),
-    angularVelocity(angularVelocity)
+    store(ParticleStore::GetDetachedStore()), index(store->Create()),
+    bodyType(DynamicBody)
 {
+    store->inverseMasses[index] = inverseMass;
+    store->dampings[index] = damping;
+    store->angularVelocities[index] = angularVelocity;
+
+    SetPosition(position);
+    SetVelocity(velocity);
+    SetAcceleration(acceleration);
+    SetAngle(angle);
+    SetBodyType(DynamicBody);
+}
+
+ParticleComponent::ParticleComponent(const ParticleComponent& other) :
+    Component(other), store(ParticleStore::GetDetachedStore()),
+    index(store->Create()), bodyType(other.bodyType)
+{
+    store->Copy(index, *other.store, other.index);
+}
+
+ParticleComponent& ParticleComponent::operator=(
+    const ParticleComponent& other)
+{
+    if (this != &other)
+    {
+        store->Copy(index, *other.store, other.index);
+        bodyType = other.bodyType;
+    }
+
+    return *this;
+}
+
+ParticleComponent::~ParticleComponent()
+{
+    store->Destroy(index);
 }
 
 float ParticleComponent::GetInverseMass()
 {
-    return inverseMass;
+    return store->inverseMasses[index];
 }
 
 std::string ParticleComponent::GetComponentClass()
@@ -19,75 +51,129 @@ std::string ParticleComponent::GetComponentClass()
     return "ParticleComponent";
 }
 
+void ParticleComponent::OnStored()
+{
+    const std::shared_ptr<ParticleStore>& integratedStore =
+        ParticleStore::GetIntegratedStore();
+    unsigned int integratedIndex = integratedStore->Create();
+
+    integratedStore->Copy(integratedIndex, *store, index);
+    store->Destroy(index);
+
+    store = integratedStore;
+    index = integratedIndex;
+}
+
 
 Vector ParticleComponent::GetPosition()
 {
-    return position;
+    return Vector(store->positionsX[index], store->positionsY[index]);
 }
 
 void ParticleComponent::SetPosition(Vector position)
 {
-    this->position = position;
+    store->positionsX[index] = position.GetX();
+    store->positionsY[index] = position.GetY();
 }
 
 
 Vector ParticleComponent::GetVelocity()
 {
-    return velocity;
+    return Vector(store->velocitiesX[index], store->velocitiesY[index]);
 }
 
 void ParticleComponent::SetVelocity(Vector velocity)
 {
-    this->velocity = velocity;
+    store->velocitiesX[index] = velocity.GetX();
+    store->velocitiesY[index] = velocity.GetY();
 }
 
 
 Vector ParticleComponent::GetAcceleration()
 {
-    return acceleration;
+    return Vector(store->accelerationsX[index], store->accelerationsY[index]);
 }
 
 void ParticleComponent::SetAcceleration(Vector acceleration)
 {
-    this->acceleration = acceleration;
+    store->accelerationsX[index] = acceleration.GetX();
+    store->accelerationsY[index] = acceleration.GetY();
 }
 
 float ParticleComponent::GetDamping()
 {
-    return damping;
+    return store->dampings[index];
 }
 
 void ParticleComponent::SetDamping(float damping)
 {
-    this->damping = damping;
+    store->dampings[index] = damping;
 }
 
 Vector ParticleComponent::GetForce()
 {
-    return force;
+    return Vector(store->forcesX[index], store->forcesY[index]);
 }
 
 void ParticleComponent::SetForce(Vector force)
 {
-    this->force = force;
+    store->forcesX[index] = force.GetX();
+    store->forcesY[index] = force.GetY();
 }
 
 float ParticleComponent::GetAngle()
 {
-    return angle;
+    return store->angles[index];
 }
 
 void ParticleComponent::SetAngle(float angle)
 {
-    this->angle = angle;
+    store->angles[index] = angle;
 }
 
 float ParticleComponent::GetAngularVelocity()
 {
-    return angularVelocity;
+    return store->angularVelocities[index];
 }
 
 void ParticleComponent::SetAngularVelocity(float angularVelocity)
 {
-    this->angularVelocity = angularVelocity;
-}
\ No newline at end of file
+    store->angularVelocities[index] = angularVelocity;
+}
+
+BodyType ParticleComponent::GetBodyType()
+{
+    return bodyType;
+}
+
+void ParticleComponent::SetBodyType(BodyType bodyType)
+{
+    this->bodyType = bodyType;
+    store->dynamics[index] = (bodyType == DynamicBody ? 1 : 0);
+}
+
+Vector ParticleComponent::GetInterpolatedPosition(float interpolation)
+{
+    Vector position = GetPosition();
+
+    if (bodyType == StaticBody || store->hasPreviousStates[index] == 0)
+        return position;
+
+    Vector previousPosition(store->previousPositionsX[index],
+        store->previousPositionsY[index]);
+
+    return previousPosition + (position - previousPosition)*interpolation;
+}
+
+float ParticleComponent::GetInterpolatedAngle(float interpolation)
+{
+    float angle = store->angles[index];
+
+    if (bodyType == StaticBody || store->hasPreviousStates[index] == 0)
+        return angle;
+
+    // Angles are wrapped, so the shortest way between both is taken.
+    float previousAngle = store->previousAngles[index];
+    float delta = std::remainder(angle - previousAngle, 2*M_PI);
+    return previousAngle + delta*interpolation;
+}
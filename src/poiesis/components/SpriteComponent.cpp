@@ -3,22 +3,13 @@
 SpriteComponent::SpriteComponent(std::string filename, Vector position,
     float rotation, float rotationSpeed, bool centered, float scale,
     int numFrames, float frameDuration, bool repeat, bool multipleFiles) :
-    filename(filename), position(position), rotation(rotation),
+    filename(std::make_shared<const std::string>(filename)),
+    position(position), rotation(rotation),
     rotationSpeed(rotationSpeed), centered(centered), baseScale(scale), scale(scale),
     numFrames(numFrames), frameDuration(frameDuration), repeat(repeat),
     multipleFiles(multipleFiles)
 {
-    Random r;
-
-    if (frameDuration > 0)
-        elapsedTime = r.GenerateFloat(0, frameDuration);
-    else
-        elapsedTime = 0;
-
-    if (numFrames > 1)
-        currentFrame = r.GenerateInt(0, numFrames);
-    else
-        currentFrame = 0;
+    RandomizeAnimation();
 }
 
 std::string SpriteComponent::GetComponentClass()
@@ -28,12 +19,12 @@ std::string SpriteComponent::GetComponentClass()
 
 std::string SpriteComponent::GetFilename()
 {
-    return filename;
+    return *filename;
 }
 
 void SpriteComponent::SetFilename(std::string filename)
 {
-    this->filename = filename;
+    this->filename = std::make_shared<const std::string>(filename);
 }
 
 Vector SpriteComponent::GetPosition()
@@ -155,3 +146,21 @@ void SpriteComponent::SetMultipleFiles(bool multipleFiles)
 {
     this->multipleFiles = multipleFiles;
 }
+
+void SpriteComponent::RandomizeAnimation()
+{
+    // Animations only change what is shown, so they draw from a stream of
+    // their own. Prototypes of prefabs drawing once, when first built, would
+    // otherwise shift the numbers the simulation draws afterwards.
+    static thread_local Random random(Random::GetStreamId("SpriteComponent"));
+
+    if (frameDuration > 0)
+        elapsedTime = random.GenerateFloat(0, frameDuration);
+    else
+        elapsedTime = 0;
+
+    if (numFrames > 1)
+        currentFrame = random.GenerateInt(0, numFrames);
+    else
+        currentFrame = 0;
+}
\ No newline at end of file
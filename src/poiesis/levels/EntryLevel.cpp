@@ -13,9 +13,9 @@ void EntryLevel::Start()
 
     auto logo = Engine::GetInstance().CreateEntity();
     Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, Vector(50 + CFG_GETI("WINDOW_WIDTH")/2, 150)), logo);
+        Engine::GetInstance().CreateComponent<ParticleComponent>(0, Vector(50 + CFG_GETI("WINDOW_WIDTH")/2, 150)), logo);
     Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("ENTRY_LOGO")), logo);
+        Engine::GetInstance().CreateComponent<SpriteComponent>(CFG_GETP("ENTRY_LOGO")), logo);
 
     // Creating systems.
     Engine::GetInstance().AddSystem(std::make_shared<RenderingSystem>());
@@ -38,9 +38,9 @@ void EntryLevel::Update()
         {
             loading = Engine::GetInstance().CreateEntity();
             Engine::GetInstance().AddComponent(
-                std::make_shared<ParticleComponent>(0, Vector(925, 525)), loading);
+                Engine::GetInstance().CreateComponent<ParticleComponent>(0, Vector(925, 525)), loading);
             Engine::GetInstance().AddComponent(
-                std::make_shared<SpriteComponent>(CFG_GETP("LOADING_IMAGE")), loading);
+                Engine::GetInstance().CreateComponent<SpriteComponent>(CFG_GETP("LOADING_IMAGE")), loading);
         }
     }
     else if (canCreateStartButton)
@@ -20,7 +20,7 @@ void Level1::CreateAllEntities()
     // Cells and food must be created after areas to be rendered above them.
     auto player = EntityFactory::CreatePlayer();
     Engine::GetInstance().AddComponent(
-        std::make_shared<AIComponent>("EatableComponent"), player);
+        Engine::GetInstance().CreateComponent<AIComponent>("EatableComponent"), player);
 
     // CreateCells();
     CreateBacteria();
@@ -84,7 +84,7 @@ void Level1::CreateCells()
     Random r;
     float x;
     float y;
-    std::shared_ptr<Entity> cell;
+    Entity cell;
 
     for (int i = 0; i < CFG_GETI("LEVEL_1_INITIAL_NUM_CELLS"); ++i)
     {
@@ -92,7 +92,7 @@ void Level1::CreateCells()
         y = r.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
         cell = EntityFactory::CreateCell(Vector(x, y));
         Engine::GetInstance().AddComponent(
-            std::make_shared<AIComponent>("EatableComponent"), cell);
+            Engine::GetInstance().CreateComponent<AIComponent>("EatableComponent"), cell);
     }
 }
 
@@ -115,13 +115,16 @@ void Level1::CreateFood()
     Random r;
     float x;
     float y;
+    std::vector<Vector> positions;
 
     for (int i = 0; i < CFG_GETI("LEVEL_1_INITIAL_NUM_FOOD"); ++i)
     {
         x = r.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
         y = r.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
-        EntityFactory::CreateFood(Vector(x, y));
+        positions.push_back(Vector(x, y));
     }
+
+    EntityFactory::CreateFood(positions);
 }
 
 void Level1::CreateAllSystems()
@@ -175,7 +178,7 @@ void Level1::Update()
 {
     LOG_D("[Level1] Updating");
 
-    auto cells = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("GrowthComponent");
+    auto cells = Engine::GetInstance().View<GrowthComponent>();
 
     for (int i = cells.size(); i < CFG_GETI("LEVEL_1_INITIAL_NUM_CELLS"); ++i)
     {
@@ -183,13 +186,13 @@ void Level1::Update()
         float x = r.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
         float y = r.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
         auto cell = EntityFactory::CreateCell(Vector(x, y));
-        auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetEntityManager()->GetSingleComponentOfClass(cell, "GrowthComponent"));
+        auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(cell);
 
         if (r.GenerateFloat() < 0.1)
             growthComponent->SetLevel(2);
 
         Engine::GetInstance().AddComponent(
-            std::make_shared<AIComponent>("EatableComponent"), cell);
+            Engine::GetInstance().CreateComponent<AIComponent>("EatableComponent"), cell);
     }
 
     if (finished)
@@ -206,7 +209,7 @@ void Level1::Update()
         else
         {
             auto playerEntity = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
-            auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetEntityManager()->GetSingleComponentOfClass(playerEntity, "GrowthComponent"));
+            auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(playerEntity);
 
             if (growthComponent->GetLevel() == CFG_GETI("LEVEL_1_GOAL_SIZE"))
             {
@@ -229,7 +232,7 @@ void Level1::Finish()
 void Level1::ZoomOutEffect()
 {
     auto cameraEntity = Engine::GetInstance().GetEntityWithComponentOfClass("CameraComponent");
-    auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntity, "CameraComponent"));
+    auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntity);
     auto height = cameraComponent->GetHeight();
 
     if (height < 4)
@@ -22,7 +22,7 @@ void Level2::CreateAllEntities()
 
     auto player = EntityFactory::CreatePlayer(); 
     Engine::GetInstance().AddComponent(
-        std::make_shared<AIComponent>("CellParticleComponent"), player);
+        Engine::GetInstance().CreateComponent<AIComponent>("CellParticleComponent"), player);
 
     // Cells and food must be created after areas to be rendered above them.
     // if (Engine::GetInstance().HasEntityWithComponentOfClass("PlayerComponent"))
@@ -30,13 +30,13 @@ void Level2::CreateAllEntities()
     //     auto player = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
     //     Engine::GetInstance().DeleteComponentsOfClass(player, "AIComponent");
     //     Engine::GetInstance().AddComponent(
-    //         std::make_shared<AIComponent>("CellParticleComponent"), player);
+    //         Engine::GetInstance().CreateComponent<AIComponent>("CellParticleComponent"), player);
     // }
     // else
     // {
     //    auto player = EntityFactory::CreatePlayer(); 
     //    Engine::GetInstance().AddComponent(
-    //         std::make_shared<AIComponent>("CellParticleComponent"), player);
+    //         Engine::GetInstance().CreateComponent<AIComponent>("CellParticleComponent"), player);
     // }
 
     CreateCells();
@@ -103,7 +103,7 @@ void Level2::CreateCells()
     Random r;
     float x;
     float y;
-    std::shared_ptr<Entity> cell;
+    Entity cell;
 
     for (int i = 0; i < CFG_GETI("LEVEL_2_INITIAL_NUM_CELLS"); ++i)
     {
@@ -111,7 +111,7 @@ void Level2::CreateCells()
         y = r.GenerateFloat(CFG_GETF("LEVEL_2_MIN_Y"), CFG_GETF("LEVEL_2_MAX_Y"));
         cell = EntityFactory::CreateCell(Vector(x, y));
         Engine::GetInstance().AddComponent(
-            std::make_shared<AIComponent>("CellParticleComponent"), cell);
+            Engine::GetInstance().CreateComponent<AIComponent>("CellParticleComponent"), cell);
     }
 }
 
@@ -134,13 +134,16 @@ void Level2::CreateViruses()
     Random r;
     float x;
     float y;
+    std::vector<Vector> positions;
 
     for (int i = 0; i < CFG_GETI("LEVEL_2_INITIAL_NUM_VIRUSES"); ++i)
     {
         x = r.GenerateFloat(CFG_GETF("LEVEL_2_MIN_X"), CFG_GETF("LEVEL_2_MAX_X"));
         y = r.GenerateFloat(CFG_GETF("LEVEL_2_MIN_Y"), CFG_GETF("LEVEL_2_MAX_Y"));
-        EntityFactory::CreateVirus(Vector(x, y));
+        positions.push_back(Vector(x, y));
     }
+
+    EntityFactory::CreateViruses(positions);
 }
 
 void Level2::CreateFood()
@@ -148,13 +151,16 @@ void Level2::CreateFood()
     Random r;
     float x;
     float y;
+    std::vector<Vector> positions;
 
     for (int i = 0; i < CFG_GETI("LEVEL_2_INITIAL_NUM_FOOD"); ++i)
     {
         x = r.GenerateFloat(CFG_GETF("LEVEL_2_MIN_X"), CFG_GETF("LEVEL_2_MAX_X"));
         y = r.GenerateFloat(CFG_GETF("LEVEL_2_MIN_Y"), CFG_GETF("LEVEL_2_MAX_Y"));
-        EntityFactory::CreateFood(Vector(x, y));
+        positions.push_back(Vector(x, y));
     }
+
+    EntityFactory::CreateFood(positions);
 }
 
 void Level2::CreateCellParticles()
@@ -241,17 +247,17 @@ void Level2::Update()
         else
         {
             auto playerEntity = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
-            auto complexityComponent = std::static_pointer_cast<ComplexityComponent>(Engine::GetInstance().GetEntityManager()->GetSingleComponentOfClass(playerEntity, "ComplexityComponent"));
+            auto complexityComponent = Engine::GetInstance().Get<ComplexityComponent>(playerEntity);
 
             if (complexityComponent->GetComplexity() == CFG_GETI("LEVEL_2_GOAL_COMPLEXITY"))
             {
                 finished = true;
                 Engine::GetInstance().DeleteSystem("CollisionSystem");
 
-                auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(playerEntity, "SpriteComponent");
+                auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(playerEntity);
                 Engine::GetInstance().GetEntityManager()->DeleteComponentsOfClass(playerEntity, "SpriteComponent");
-                auto sprite = std::static_pointer_cast<SpriteComponent>(spriteComponents[0]);
-                auto animation = std::make_shared<SpriteComponent>(
+                auto sprite = spriteComponents[0];
+                auto animation = Engine::GetInstance().CreateComponent<SpriteComponent>(
                     CFG_GETP("CELL_TO_REPRODUCTION_ANIMATION"),
                     Vector(0, 0), sprite->GetRotation(),
                     sprite->GetRotationSpeed(), true,
@@ -276,7 +282,7 @@ void Level2::Finish()
 void Level2::ZoomOutEffect()
 {
     auto cameraEntity = Engine::GetInstance().GetEntityWithComponentOfClass("CameraComponent");
-    auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntity, "CameraComponent"));
+    auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntity);
     auto height = cameraComponent->GetHeight();
 
     if (height < CFG_GETF("LEVEL_3_CAMERA_HEIGHT"))
@@ -83,13 +83,16 @@ void Level3::CreateCells()
     Random r;
     float x;
     float y;
+    std::vector<Vector> positions;
 
     for (int i = 0; i < CFG_GETI("LEVEL_3_INITIAL_NUM_CELLS"); ++i)
     {
         x = r.GenerateFloat(CFG_GETF("LEVEL_3_MIN_X"), CFG_GETF("LEVEL_3_MAX_X"));
         y = r.GenerateFloat(CFG_GETF("LEVEL_3_MIN_Y"), CFG_GETF("LEVEL_3_MAX_Y"));
-        EntityFactory::CreateLevel3Cell(Vector(x, y));
+        positions.push_back(Vector(x, y));
     }
+
+    EntityFactory::CreateLevel3Cells(positions);
 }
 
 void Level3::CreateBacteria()
@@ -111,13 +114,16 @@ void Level3::CreateViruses()
     Random r;
     float x;
     float y;
+    std::vector<Vector> positions;
 
     for (int i = 0; i < CFG_GETI("LEVEL_3_INITIAL_NUM_VIRUSES"); ++i)
     {
         x = r.GenerateFloat(CFG_GETF("LEVEL_3_MIN_X"), CFG_GETF("LEVEL_3_MAX_X"));
         y = r.GenerateFloat(CFG_GETF("LEVEL_3_MIN_Y"), CFG_GETF("LEVEL_3_MAX_Y"));
-        EntityFactory::CreateVirus(Vector(x, y));
+        positions.push_back(Vector(x, y));
     }
+
+    EntityFactory::CreateViruses(positions);
 }
 
 void Level3::CreateFood()
@@ -125,13 +131,16 @@ void Level3::CreateFood()
     Random r;
     float x;
     float y;
+    std::vector<Vector> positions;
 
     for (int i = 0; i < CFG_GETI("LEVEL_3_INITIAL_NUM_FOOD"); ++i)
     {
         x = r.GenerateFloat(CFG_GETF("LEVEL_3_MIN_X"), CFG_GETF("LEVEL_3_MAX_X"));
         y = r.GenerateFloat(CFG_GETF("LEVEL_3_MIN_Y"), CFG_GETF("LEVEL_3_MAX_Y"));
-        EntityFactory::CreateFood(Vector(x, y));
+        positions.push_back(Vector(x, y));
     }
+
+    EntityFactory::CreateFood(positions);
 }
 
 void Level3::CreateAllSystems()
@@ -197,7 +206,7 @@ void Level3::Update()
     else
     {
         auto playerEntity = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
-        auto reproductionComponent = std::static_pointer_cast<ReproductionComponent>(Engine::GetInstance().GetEntityManager()->GetSingleComponentOfClass(playerEntity, "ReproductionComponent"));
+        auto reproductionComponent = Engine::GetInstance().Get<ReproductionComponent>(playerEntity);
 
         if (reproductionComponent->GetReproduced())
         {
@@ -4,9 +4,9 @@ void LoseLevel::Start()
 {
     auto loseImage = Engine::GetInstance().CreateEntity();
     Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, Vector(CFG_GETI("WINDOW_WIDTH")/2, 450)), loseImage);
+        Engine::GetInstance().CreateComponent<ParticleComponent>(0, Vector(CFG_GETI("WINDOW_WIDTH")/2, 450)), loseImage);
     Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("LOSE_IMAGE")), loseImage);
+        Engine::GetInstance().CreateComponent<SpriteComponent>(CFG_GETP("LOSE_IMAGE")), loseImage);
 
     EntityFactory::CreateButton(CFG_GETP("MENU_BUTTON_IMAGE"),
         Rectangle(880, 700,
@@ -4,9 +4,9 @@ void WinLevel::Start()
 {
     auto winImage = Engine::GetInstance().CreateEntity();
     Engine::GetInstance().AddComponent(
-        std::make_shared<ParticleComponent>(0, Vector(CFG_GETI("WINDOW_WIDTH")/2, 450)), winImage);
+        Engine::GetInstance().CreateComponent<ParticleComponent>(0, Vector(CFG_GETI("WINDOW_WIDTH")/2, 450)), winImage);
     Engine::GetInstance().AddComponent(
-        std::make_shared<SpriteComponent>(CFG_GETP("WIN_IMAGE")), winImage);
+        Engine::GetInstance().CreateComponent<SpriteComponent>(CFG_GETP("WIN_IMAGE")), winImage);
 
     EntityFactory::CreateButton(CFG_GETP("MENU_BUTTON_IMAGE"),
         Rectangle(880, 700,
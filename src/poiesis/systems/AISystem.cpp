@@ -1,5 +1,15 @@
 #include "poiesis/systems/AISystem.h"
 
+CfgFloat AISystem::aiMinDrivingForce("AI_MIN_DRIVING_FORCE");
+CfgFloat AISystem::aiMaxDrivingForce("AI_MAX_DRIVING_FORCE");
+
+AISystem::AISystem() :
+    random("AISystem")
+{
+    Reads<AIComponent>();
+    Writes<ParticleComponent>();
+}
+
 std::string AISystem::GetName()
 {
     return "AISystem";
@@ -10,40 +20,39 @@ void AISystem::Update(float dt)
     // Avoid warnings for not using dt.
     LOG_D("[AISystem] Update: " << dt);
 
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("AIComponent");
+    auto& entities = Engine::GetInstance().View<AIComponent>();
 
     if (entities.size() == 0)
         return;
 
     std::shared_ptr<AIComponent> aiComponent;
     std::shared_ptr<ParticleComponent> aiParticleComponent;
-    std::vector<std::shared_ptr<Entity>> pursueEntities;
+    std::vector<Entity> pursueEntities;
     Vector aiParticlePosition;
     Vector resultantForce;
     Vector drivingForce;
 
     for (auto entity : entities)
     {
-        aiComponent = std::static_pointer_cast<AIComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "AIComponent"));
+        aiComponent = Engine::GetInstance().Get<AIComponent>(entity);
         
         drivingForce += PursueComponent(entity, aiComponent->GetPursueComponent());
         
         // if (aiComponent->GetPursueComponent() == "CellParticleComponent")
         //     drivingForce += FleeFromComponent(entity, "ComplexityComponent");
 
-        auto aiParticleComponent = std::static_pointer_cast<ParticleComponent>(
-            Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
+        auto aiParticleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
 
         resultantForce = aiParticleComponent->GetForce() + drivingForce;
         aiParticleComponent->SetForce(resultantForce);
     }
 }
 
-Vector AISystem::PursueComponent(std::shared_ptr<Entity> entity,
+Vector AISystem::PursueComponent(Entity entity,
     std::string componentClass)
 {
     auto aiParticlePosition = GetEntityPosition(entity);
-    auto pursueEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass(componentClass);
+    auto& pursueEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass(componentClass);
     auto closestEntity = GetClosestEntity(entity, pursueEntities);
 
     if (!closestEntity)
@@ -54,11 +63,11 @@ Vector AISystem::PursueComponent(std::shared_ptr<Entity> entity,
     return drivingForce;
 }
 
-Vector AISystem::FleeFromComponent(std::shared_ptr<Entity> entity,
+Vector AISystem::FleeFromComponent(Entity entity,
     std::string componentClass)
 {
     auto aiParticlePosition = GetEntityPosition(entity);
-    auto fleeEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass(componentClass);
+    auto& fleeEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass(componentClass);
     Vector drivingForce;
 
     for (auto fleeEntity : fleeEntities)
@@ -74,10 +83,9 @@ Vector AISystem::FleeFromComponent(std::shared_ptr<Entity> entity,
 Vector AISystem::CalculateAttractionForce(Vector entityPosition,
     Vector attractionPosition)
 {
-    Random r;
     Vector force = attractionPosition - entityPosition;
     force.Normalize();
-    force *= r.GenerateFloat(CFG_GETF("AI_MIN_DRIVING_FORCE"), CFG_GETF("AI_MAX_DRIVING_FORCE"));
+    force *= random.GenerateFloat(aiMinDrivingForce.Get(), aiMaxDrivingForce.Get());
     return force;
 }
 
@@ -88,18 +96,17 @@ Vector AISystem::CalculateRepulsionForce(Vector entityPosition,
     return (force*(-1));
 }
 
-Vector AISystem::GetEntityPosition(std::shared_ptr<Entity> entity)
+Vector AISystem::GetEntityPosition(Entity entity)
 {
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(
-            Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
     return particleComponent->GetPosition();
 }
 
-std::shared_ptr<Entity> AISystem::GetClosestEntity(
-    std::shared_ptr<Entity> referenceEntity,
-    std::vector<std::shared_ptr<Entity>> entities)
+Entity AISystem::GetClosestEntity(
+    Entity referenceEntity,
+    const std::vector<Entity>& entities)
 {
-    std::shared_ptr<Entity> closestEntity;
+    Entity closestEntity;
     Vector position = GetEntityPosition(referenceEntity);
     float closestDistance = std::numeric_limits<float>::max();
     
@@ -108,7 +115,7 @@ std::shared_ptr<Entity> AISystem::GetClosestEntity(
         auto particlePosition = GetEntityPosition(entity);
         auto distance = particlePosition.CalculateDistance(position);
 
-        if (distance < closestDistance && referenceEntity->GetId() != entity->GetId())
+        if (distance < closestDistance && referenceEntity != entity)
         {
             closestEntity = entity;
             closestDistance = distance;
@@ -1,5 +1,13 @@
 #include "poiesis/systems/AnimationSystem.h"
 
+CfgInt AnimationSystem::animationGrainSize("ANIMATION_GRAIN_SIZE");
+
+AnimationSystem::AnimationSystem()
+{
+    Writes<SpriteComponent>();
+    Presents();
+}
+
 std::string AnimationSystem::GetName()
 {
     return "AnimationSystem";
@@ -7,43 +15,50 @@ std::string AnimationSystem::GetName()
 
 void AnimationSystem::Update(float dt)
 {
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("SpriteComponent");
-    std::shared_ptr<SpriteComponent> spriteComponent;
+    auto& entities = Engine::GetInstance().View<SpriteComponent>();
 
-    for (auto entity : entities)
-    {
-        for (auto component : Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent"))
+    Engine::GetInstance().GetJobSystem()->ParallelFor(
+        entities.size(), animationGrainSize.Get(),
+        [this, &entities, dt](unsigned int first, unsigned int last)
         {
-            auto spriteComponent = std::static_pointer_cast<SpriteComponent>(component);
-            auto elapsedTime = spriteComponent->GetElapsedTime();
-            auto frameDuration = spriteComponent->GetFrameDuration();
-            auto currentFrame = spriteComponent->GetCurrentFrame();
-            auto repeat = spriteComponent->GetRepeat();
-            auto numFrames = spriteComponent->GetNumFrames();
+            for (unsigned int i = first; i < last; ++i)
+            {
+                for (auto spriteComponent : Engine::GetInstance().GetComponents<SpriteComponent>(entities[i]))
+                    UpdateSprite(spriteComponent, dt);
+            }
+        });
+}
 
-            auto rotation = spriteComponent->GetRotation();
-            auto rotationSpeed = spriteComponent->GetRotationSpeed();
+void AnimationSystem::UpdateSprite(
+    std::shared_ptr<SpriteComponent> spriteComponent, float dt)
+{
+    auto elapsedTime = spriteComponent->GetElapsedTime();
+    auto frameDuration = spriteComponent->GetFrameDuration();
+    auto currentFrame = spriteComponent->GetCurrentFrame();
+    auto repeat = spriteComponent->GetRepeat();
+    auto numFrames = spriteComponent->GetNumFrames();
 
-            Vector rotationVector(1, 0);
-            rotationVector.Rotate(rotation + rotationSpeed*dt);
-            rotation = rotationVector.GetDirection();
+    auto rotation = spriteComponent->GetRotation();
+    auto rotationSpeed = spriteComponent->GetRotationSpeed();
 
-            elapsedTime += dt;
+    Vector rotationVector(1, 0);
+    rotationVector.Rotate(rotation + rotationSpeed*dt);
+    rotation = rotationVector.GetDirection();
 
-            if (elapsedTime >= frameDuration)
-            {
-                elapsedTime = 0;
-                ++currentFrame;
+    elapsedTime += dt;
 
-                if (repeat)
-                    currentFrame = currentFrame >= numFrames ? 0 : currentFrame;
-                else
-                    currentFrame = currentFrame >= numFrames ? numFrames-1 : currentFrame;
-            }
+    if (elapsedTime >= frameDuration)
+    {
+        elapsedTime = 0;
+        ++currentFrame;
 
-            spriteComponent->SetElapsedTime(elapsedTime);
-            spriteComponent->SetCurrentFrame(currentFrame);
-            spriteComponent->SetRotation(rotation);
-        }
+        if (repeat)
+            currentFrame = currentFrame >= numFrames ? 0 : currentFrame;
+        else
+            currentFrame = currentFrame >= numFrames ? numFrames-1 : currentFrame;
     }
+
+    spriteComponent->SetElapsedTime(elapsedTime);
+    spriteComponent->SetCurrentFrame(currentFrame);
+    spriteComponent->SetRotation(rotation);
 }
\ No newline at end of file
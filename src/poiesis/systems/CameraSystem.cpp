@@ -1,5 +1,13 @@
 #include "poiesis/systems/CameraSystem.h"
 
+CfgFloat CameraSystem::cameraMaxDistance("CAMERA_MAX_DISTANCE");
+
+CameraSystem::CameraSystem()
+{
+    Reads<CameraFollowComponent, ParticleComponent>();
+    Writes<CameraComponent>();
+}
+
 std::string CameraSystem::GetName()
 {
     return "CameraSystem";
@@ -17,9 +25,11 @@ void CameraSystem::Update(float dt)
     auto camera = Engine::GetInstance().GetEntityWithComponentOfClass("CameraComponent");
     auto followEntity = Engine::GetInstance().GetEntityWithComponentOfClass("CameraFollowComponent");
 
-    auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(camera, "CameraComponent"));
-    auto cameraFollowComponent = std::static_pointer_cast<CameraFollowComponent>(Engine::GetInstance().GetSingleComponentOfClass(followEntity, "CameraFollowComponent"));
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(followEntity, "ParticleComponent"));
+    auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(camera);
+    auto cameraFollowComponent = Engine::GetInstance().Get<CameraFollowComponent>(followEntity);
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(followEntity);
+
+    cameraComponent->SavePreviousPosition();
 
     if (!cameraFollowComponent->GetEnabled())
         return;
@@ -28,12 +38,12 @@ void CameraSystem::Update(float dt)
     auto particlePosition = particleComponent->GetPosition();
     auto cameraPosition = cameraComponent->GetPosition();
 
-    if (cameraPosition.CalculateDistance(particlePosition) > CFG_GETF("CAMERA_MAX_DISTANCE"))
+    if (cameraPosition.CalculateDistance(particlePosition) > cameraMaxDistance.Get())
     {
         auto exceeding = particlePosition - cameraPosition;
         auto mag = exceeding.GetMagnitude();
         auto dir = exceeding.GetDirection();
-        exceeding.SetPolar(mag - CFG_GETF("CAMERA_MAX_DISTANCE"), dir);
+        exceeding.SetPolar(mag - cameraMaxDistance.Get(), dir);
         cameraPosition += exceeding;
     }
 
@@ -1,7 +1,25 @@
 #include "poiesis/systems/CollisionSystem.h"
 
+CfgFloat CollisionSystem::collisionMaxDistance("COLLISION_MAX_DISTANCE");
+CfgInt CollisionSystem::collisionGrainSize("COLLISION_GRAIN_SIZE");
+CfgFloat CollisionSystem::reproductionDistanceMax("REPRODUCTION_DISTANCE_MAX");
+CfgFloat CollisionSystem::complexityParticleEmitForce("COMPLEXITY_PARTICLE_EMIT_FORCE");
+CfgPath CollisionSystem::eatSoundEffect("EAT_SOUND_EFFECT");
+CfgPath CollisionSystem::frozenSoundEffect("FROZEN_SOUND_EFFECT");
+CfgPath CollisionSystem::impulsesSoundEffect("IMPULSES_SOUND_EFFECT");
+CfgPath CollisionSystem::cellFrozenImage("CELL_FROZEN_IMAGE");
+CfgFloat CollisionSystem::cellFrozenScale("CELL_FROZEN_SCALE");
+CfgPath CollisionSystem::cellErracticImage("CELL_ERRACTIC_IMAGE");
+CfgFloat CollisionSystem::cellErracticRotationSpeed("CELL_ERRACTIC_ROTATION_SPEED");
+CfgFloat CollisionSystem::cellErracticScale("CELL_ERRACTIC_SCALE");
+CfgPath CollisionSystem::cellCannotEatImage("CELL_CANNOT_EAT_IMAGE");
+CfgFloat CollisionSystem::cellCannotEatScale("CELL_CANNOT_EAT_SCALE");
+
 CollisionSystem::CollisionSystem() :
-    reproductionEnabled(false), complexityEnabled(false)
+    reproductionEnabled(false), complexityEnabled(false),
+    broadPhase(BroadPhase::Create(CFG_GETS("COLLISION_BROAD_PHASE"))),
+    staticBroadPhase(CFG_GETF("COLLISION_CELL_SIZE")),
+    roleSetIndices(NUMBER_OF_ROLE_SETS, -1)
 {
 }
 
@@ -39,172 +57,292 @@ void CollisionSystem::Update(float dt)
 
 void CollisionSystem::CheckCollisions()
 {
-    float maxDistance = CFG_GETF("COLLISION_MAX_DISTANCE");
-    Quadtree<std::shared_ptr<Entity>> quadtree(Rectangle(CFG_GETF("LEVEL_MIN_X"), CFG_GETF("LEVEL_MIN_Y"), CFG_GETF("LEVEL_MAX_X") - CFG_GETF("LEVEL_MIN_X"), CFG_GETF("LEVEL_MAX_Y") - CFG_GETF("LEVEL_MIN_Y")));
-    auto cameraEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("CameraComponent");
-    collidableEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("ColliderComponent");
-
-    // Clear deleted entities from last iteration.
-    deletedEntities.clear();
+    float maxDistance = collisionMaxDistance.Get();
+    auto& cameraEntities = Engine::GetInstance().View<CameraComponent>();
+    auto& collidableEntities = Engine::GetInstance().View<ColliderComponent>();
 
-    std::shared_ptr<Entity> cameraEntity;
+    Entity cameraEntity;
     if (cameraEntities.size() > 0)
         cameraEntity = cameraEntities[0];
 
-    // Build quadtree for close enough entities.
+    // Move close enough entities in the broad phase, dropping the others.
+    // Static bodies are kept in their own broad phase regardless of the
+    // distance, so it doesn't change as the camera moves.
+    broadPhase->BeginUpdate();
+    staticBroadPhase.BeginUpdate();
+    movingEntities.clear();
+
     for (auto entity : collidableEntities)
     {
-        auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
+        auto colliderComponent = Engine::GetInstance().Get<ColliderComponent>(entity);
+        auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
         auto position = particleComponent->GetPosition();
+        auto radius = colliderComponent->GetRadius();
 
-        // Ignore collision from things that aren't visible.
-        if (cameraEntity)
+        if (particleComponent->GetBodyType() == StaticBody)
+            staticBroadPhase.Update(entity, position, radius);
+        else
         {
-            auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntity, "CameraComponent"));
-            auto cameraPosition = cameraComponent->GetPosition();
-
-            if (cameraPosition.CalculateDistance(position) > maxDistance)
-                continue;
-            else
-                quadtree.Add(entity, position);
+            // Ignore collision from things that aren't visible.
+            if (cameraEntity)
+            {
+                auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntity);
+                auto cameraPosition = cameraComponent->GetPosition();
+
+                if (cameraPosition.CalculateDistance(position) > maxDistance)
+                    continue;
+            }
+
+            broadPhase->Update(entity, position, radius);
+            movingEntities.push_back(entity);
         }
-        else
+
+        narrowPhase.SetCircle(entity, position, radius);
+
+        // Components deciding how collisions are solved are neither added nor
+        // removed while solving them, so roles are only found once per frame.
+        if (entity.GetId() >= entityRoleSets.size())
         {
-            quadtree.Add(entity, position);
+            entityRoleSets.resize(entity.GetId() + 1);
+            movedEntities.resize(entity.GetId() + 1);
         }
+
+        entityRoleSets[entity.GetId()] = GetRoleSetIndex(GetRoles(entity));
+        movedEntities[entity.GetId()] = false;
     }
 
-    // Detect and solve collisions.
-    for (unsigned int i = 0; i < collidableEntities.size(); ++i)
+    broadPhase->RemoveStaleEntities();
+    staticBroadPhase.RemoveStaleEntities();
+    broadPhase->GetPairs(pairs);
+
+    // Static bodies don't affect each other, so they are only paired with the
+    // moving ones.
+    for (auto entity : movingEntities)
     {
-        auto entity = collidableEntities[i];
+        auto colliderComponent = Engine::GetInstance().Get<ColliderComponent>(entity);
+        auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
+        staticBroadPhase.Query(entity, particleComponent->GetPosition(),
+            colliderComponent->GetRadius(), pairs);
+    }
 
-        auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
-        auto position = particleComponent->GetPosition();
-        auto quadtreeEntities = quadtree.Get(position);
+    // Detect collisions from the positions at the start of the frame.
+    narrowPhase.FindContacts(pairs, collisionGrainSize.Get(), contacts);
 
-        for (unsigned int j = 0; j < quadtreeEntities.size(); ++j)
-        {
-            auto otherEntity = quadtreeEntities[j];
+    // Compare them with the ones of the previous frame.
+    contactCache.Update(contacts, events);
 
-            if (std::find(deletedEntities.begin(), deletedEntities.end(),  entity->GetId()) != deletedEntities.end())
-                continue;
+    // Solve collisions in order.
+    CollisionEvent event;
 
-            if (std::find(deletedEntities.begin(), deletedEntities.end(),  otherEntity->GetId()) != deletedEntities.end())
-                continue;
+    while (events.Pop(event))
+    {
+        auto& contact = event.contact;
+
+        // Entities destroyed by previous collisions in this frame are still
+        // listed.
+        if (Engine::GetInstance().IsDeleted(contact.entity1)
+            || Engine::GetInstance().IsDeleted(contact.entity2))
+            continue;
 
-            if (entity->GetId() != otherEntity->GetId()
-                && IsColliding(entity, otherEntity))
-                SolveCollision(entity, otherEntity);
+        if (event.type == CollisionEnd)
+        {
+            LOG_D("[CollisionSystem] Collision ended between entities: "
+                << contact.entity1.GetId() << " and " << contact.entity2.GetId());
+            continue;
+        }
+
+        // Entities pushed apart by previous collisions may not be colliding
+        // anymore.
+        if (movedEntities[contact.entity1.GetId()]
+            || movedEntities[contact.entity2.GetId()])
+        {
+            if (!UpdateContact(contact))
+                continue;
         }
+
+        SolveCollision(contact, (event.type == CollisionBegin));
     }
 }
 
-bool CollisionSystem::IsColliding(std::shared_ptr<Entity> entity1,
-    std::shared_ptr<Entity> entity2)
+bool CollisionSystem::UpdateContact(Contact& contact)
 {
-    auto colliderComponent1 = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity1, "ColliderComponent"));
-    auto colliderComponent2 = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity2, "ColliderComponent"));
-    auto particleComponent1 = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity1, "ParticleComponent"));
-    auto particleComponent2 = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity2, "ParticleComponent"));
-    float radius1 = colliderComponent1->GetRadius();
-    float radius2 = colliderComponent2->GetRadius();
-    Vector position1 = particleComponent1->GetPosition();
-    Vector position2 = particleComponent2->GetPosition();
-    float distance = position1.CalculateDistance(position2);
-
-    if (distance < (radius1 + radius2))
-        return true;
-    return false;
+    auto colliderComponent1 = Engine::GetInstance().Get<ColliderComponent>(contact.entity1);
+    auto colliderComponent2 = Engine::GetInstance().Get<ColliderComponent>(contact.entity2);
+    auto particleComponent1 = Engine::GetInstance().Get<ParticleComponent>(contact.entity1);
+    auto particleComponent2 = Engine::GetInstance().Get<ParticleComponent>(contact.entity2);
+
+    return NarrowPhase::CreateContact(
+        contact.entity1, particleComponent1->GetPosition(), colliderComponent1->GetRadius(),
+        contact.entity2, particleComponent2->GetPosition(), colliderComponent2->GetRadius(),
+        contact);
 }
 
-void CollisionSystem::SolveCollision(std::shared_ptr<Entity> entity1,
-    std::shared_ptr<Entity> entity2)
+void CollisionSystem::SolveCollision(const Contact& contact,
+    bool beginning)
 {
-    if (reproductionEnabled &&
-        Engine::GetInstance().HasComponent(entity1, "ReproductionComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "ReproductionComponent"))
+    Entity entity1 = contact.entity1;
+    Entity entity2 = contact.entity2;
+    auto& handler = handlers[entityRoleSets[entity1.GetId()]*roleSets.size()
+        + entityRoleSets[entity2.GetId()]];
+
+    if (reproductionEnabled && handler.reproduce)
     {
         if (ReproduceEntities(entity1, entity2))
             return;
     }
 
-    if (complexityEnabled &&
-        Engine::GetInstance().HasComponent(entity1, "ComplexityComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "ComplexityComponent"))
+    if (beginning && complexityEnabled && handler.emitParticles)
     {
         EmitParticles(entity1);
         EmitParticles(entity2);
     }
 
-    if (Engine::GetInstance().HasComponent(entity1, "InfectionComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "InfectionComponent"))
+    // Each pair is solved once, in the order the broad phase found it, so
+    // infections are tried from both sides.
+    if (beginning && handler.transmitInfection)
     {
-        if (TransmitInfection(entity1, entity2))
+        if (TransmitInfection(entity1, entity2)
+            || TransmitInfection(entity2, entity1))
             return;
     }
-    else if (Engine::GetInstance().HasComponent(entity2, "InfectionComponent") && 
-        Engine::GetInstance().HasComponent(entity1, "InfectionComponent"))
+
+    if (handler.swapped)
+        std::swap(entity1, entity2);
+
+    switch (handler.action)
     {
-        if (TransmitInfection(entity2, entity1))
-            return;
+        case IncorporateAction:
+            IncorporateEntity(entity1, entity2);
+            break;
+        case EatAction:
+            EatEntity(entity1, entity2);
+            break;
+        case CombatAction:
+            CombatEntities(entity1, entity2, contact);
+            break;
+        case SlowAction:
+            SlowEntity(entity1, entity2);
+            break;
+        case VitaminateAction:
+            VitaminateEntity(entity1, entity2);
+            break;
+        case IgnoreAction:
+            break;
+        case BounceAction:
+            CollideBodies(contact);
+            break;
     }
+}
 
-    if (Engine::GetInstance().HasComponent(entity1, "ComplexityComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "CellParticleComponent"))
-        IncorporateEntity(entity1, entity2);
-    else if (Engine::GetInstance().HasComponent(entity2, "ComplexityComponent") && 
-        Engine::GetInstance().HasComponent(entity1, "CellParticleComponent"))
-        IncorporateEntity(entity2, entity1);
-    else if (Engine::GetInstance().HasComponent(entity1, "GrowthComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "EatableComponent"))
-        EatEntity(entity1, entity2);
-    else if (Engine::GetInstance().HasComponent(entity2, "GrowthComponent") && 
-        Engine::GetInstance().HasComponent(entity1, "EatableComponent"))
-        EatEntity(entity2, entity1);
-    else if (Engine::GetInstance().HasComponent(entity1, "CombatComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "CombatComponent"))
-        CombatEntities(entity1, entity2);
-    else if (Engine::GetInstance().HasComponent(entity1, "SlowingComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "ParticleComponent"))
-        SlowEntity(entity1, entity2);
-    else if (Engine::GetInstance().HasComponent(entity2, "SlowingComponent") && 
-        Engine::GetInstance().HasComponent(entity1, "ParticleComponent"))
-        SlowEntity(entity2, entity1);
-    else if (Engine::GetInstance().HasComponent(entity1, "VitaminComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "GrowthComponent"))
-        VitaminateEntity(entity1, entity2);
-    else if (Engine::GetInstance().HasComponent(entity2, "VitaminComponent") && 
-        Engine::GetInstance().HasComponent(entity1, "GrowthComponent"))
-        VitaminateEntity(entity2, entity1);
-    else if (Engine::GetInstance().HasComponent(entity1, "VitaminComponent") && 
-        Engine::GetInstance().HasComponent(entity2, "ParticleComponent"))
-        return;
-    else if (Engine::GetInstance().HasComponent(entity2, "VitaminComponent") && 
-        Engine::GetInstance().HasComponent(entity1, "ParticleComponent"))
-        return;
+unsigned int CollisionSystem::GetRoles(Entity entity)
+{
+    unsigned int roles = 0;
+
+    if (Engine::GetInstance().Has<ReproductionComponent>(entity))
+        roles |= ReproductionRole;
+    if (Engine::GetInstance().Has<ComplexityComponent>(entity))
+        roles |= ComplexityRole;
+    if (Engine::GetInstance().Has<InfectionComponent>(entity))
+        roles |= InfectionRole;
+    if (Engine::GetInstance().Has<CellParticleComponent>(entity))
+        roles |= CellParticleRole;
+    if (Engine::GetInstance().Has<GrowthComponent>(entity))
+        roles |= GrowthRole;
+    if (Engine::GetInstance().Has<EatableComponent>(entity))
+        roles |= EatableRole;
+    if (Engine::GetInstance().Has<CombatComponent>(entity))
+        roles |= CombatRole;
+    if (Engine::GetInstance().Has<SlowingComponent>(entity))
+        roles |= SlowingRole;
+    if (Engine::GetInstance().Has<ParticleComponent>(entity))
+        roles |= ParticleRole;
+    if (Engine::GetInstance().Has<VitaminComponent>(entity))
+        roles |= VitaminRole;
+
+    return roles;
+}
+
+unsigned int CollisionSystem::GetRoleSetIndex(unsigned int roles)
+{
+    if (roleSetIndices[roles] >= 0)
+        return roleSetIndices[roles];
+
+    // Only a handful of role sets exist, so the table is simply built again
+    // whenever a new one shows up.
+    roleSetIndices[roles] = roleSets.size();
+    roleSets.push_back(roles);
+    handlers.clear();
+
+    for (auto roles1 : roleSets)
+    {
+        for (auto roles2 : roleSets)
+            handlers.push_back(CreateHandler(roles1, roles2));
+    }
+
+    return roleSetIndices[roles];
+}
+
+CollisionSystem::CollisionHandler CollisionSystem::CreateHandler(
+    unsigned int roles1, unsigned int roles2)
+{
+    CollisionHandler handler;
+    unsigned int sharedRoles = roles1 & roles2;
+
+    handler.reproduce = (sharedRoles & ReproductionRole);
+    handler.emitParticles = (sharedRoles & ComplexityRole);
+    handler.transmitInfection = (sharedRoles & InfectionRole);
+    handler.swapped = false;
+
+    if ((roles1 & ComplexityRole) && (roles2 & CellParticleRole))
+        handler.action = IncorporateAction;
+    else if ((roles2 & ComplexityRole) && (roles1 & CellParticleRole))
+    {
+        handler.action = IncorporateAction;
+        handler.swapped = true;
+    }
+    else if ((roles1 & GrowthRole) && (roles2 & EatableRole))
+        handler.action = EatAction;
+    else if ((roles2 & GrowthRole) && (roles1 & EatableRole))
+    {
+        handler.action = EatAction;
+        handler.swapped = true;
+    }
+    else if (sharedRoles & CombatRole)
+        handler.action = CombatAction;
+    else if ((roles1 & SlowingRole) && (roles2 & ParticleRole))
+        handler.action = SlowAction;
+    else if ((roles2 & SlowingRole) && (roles1 & ParticleRole))
+    {
+        handler.action = SlowAction;
+        handler.swapped = true;
+    }
+    else if ((roles1 & VitaminRole) && (roles2 & GrowthRole))
+        handler.action = VitaminateAction;
+    else if ((roles2 & VitaminRole) && (roles1 & GrowthRole))
+    {
+        handler.action = VitaminateAction;
+        handler.swapped = true;
+    }
+    else if ((roles1 & VitaminRole) && (roles2 & ParticleRole))
+        handler.action = IgnoreAction;
+    else if ((roles2 & VitaminRole) && (roles1 & ParticleRole))
+        handler.action = IgnoreAction;
     else
-        CollideBodies(entity1, entity2);
+        handler.action = BounceAction;
+
+    return handler;
 }
 
-void CollisionSystem::CollideBodies(std::shared_ptr<Entity> entity1,
-    std::shared_ptr<Entity> entity2)
+void CollisionSystem::CollideBodies(const Contact& contact)
 {
-    LOG_D("[CollisionSystem] Colliding entities: " << entity1->GetId() << " and " << entity2->GetId());
-
-    auto particleComponent1 = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity1, "ParticleComponent"));
-    auto particleComponent2 = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity2, "ParticleComponent"));
-    auto colliderComponent1 = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity1, "ColliderComponent"));
-    auto colliderComponent2 = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity2, "ColliderComponent"));
-    float radius1 = colliderComponent1->GetRadius();
-    float radius2 = colliderComponent2->GetRadius();
+    LOG_D("[CollisionSystem] Colliding entities: " << contact.entity1.GetId() << " and " << contact.entity2.GetId());
+
+    auto particleComponent1 = Engine::GetInstance().Get<ParticleComponent>(contact.entity1);
+    auto particleComponent2 = Engine::GetInstance().Get<ParticleComponent>(contact.entity2);
     Vector position1 = particleComponent1->GetPosition();
     Vector position2 = particleComponent2->GetPosition();
-    float distance = position1.CalculateDistance(position2);
-    float difference = radius1 + radius2 - distance;
-
-    Vector direction = position2 - position1;
-    direction.Normalize();
+    float difference = contact.penetration;
+    Vector direction = contact.normal;
 
     // Applying force contrary to the collision direction. This force should
     // depend on the energy of the collision
@@ -215,42 +353,56 @@ void CollisionSystem::CollideBodies(std::shared_ptr<Entity> entity1,
     particleComponent1->SetForce(force1);
     particleComponent2->SetForce(force2);
     
-    // Avoiding overlapping
-    position1 += direction*(-difference/2);
-    position2 += direction*(difference/2);
+    // Avoiding overlapping. Static bodies stay in place, so the other body
+    // is moved all the way.
+    bool static1 = (particleComponent1->GetBodyType() == StaticBody);
+    bool static2 = (particleComponent2->GetBodyType() == StaticBody);
+
+    if (static1 && !static2)
+        position2 += direction*difference;
+    else if (static2 && !static1)
+        position1 += direction*(-difference);
+    else if (!static1 && !static2)
+    {
+        position1 += direction*(-difference/2);
+        position2 += direction*(difference/2);
+    }
 
     particleComponent1->SetPosition(position1);
     particleComponent2->SetPosition(position2);
+
+    movedEntities[contact.entity1.GetId()] = true;
+    movedEntities[contact.entity2.GetId()] = true;
 }
 
-void CollisionSystem::CombatEntities(std::shared_ptr<Entity> entity1,
-        std::shared_ptr<Entity> entity2)
+void CollisionSystem::CombatEntities(Entity entity1,
+        Entity entity2, const Contact& contact)
 {
-    auto combatComponent1 = std::static_pointer_cast<CombatComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity1, "CombatComponent"));
-    auto combatComponent2 = std::static_pointer_cast<CombatComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity2, "CombatComponent"));
+    auto combatComponent1 = Engine::GetInstance().Get<CombatComponent>(entity1);
+    auto combatComponent2 = Engine::GetInstance().Get<CombatComponent>(entity2);
 
     int power1 = combatComponent1->GetPower();
     int power2 = combatComponent2->GetPower();
 
-    LOG_D("[CollisionSystem] Combat between entity " << entity1->GetId()
-        << " and " << entity2->GetId());
+    LOG_D("[CollisionSystem] Combat between entity " << entity1.GetId()
+        << " and " << entity2.GetId());
 
     if (power1 > power2)
     {
-        LOG_D("[CollisionSystem] Entity " << entity1->GetId()
+        LOG_D("[CollisionSystem] Entity " << entity1.GetId()
             << " wins the combat");
 
-        if (Engine::GetInstance().HasComponent(entity1, "GrowthComponent"))
+        if (Engine::GetInstance().Has<GrowthComponent>(entity1))
             EatEntity(entity1, entity2);
         else
             DestroyEntity(entity2);
     }
     else if (power2 > power1)
     {
-        LOG_D("[CollisionSystem] Entity " << entity2->GetId()
+        LOG_D("[CollisionSystem] Entity " << entity2.GetId()
             << " wins the combat");
 
-        if (Engine::GetInstance().HasComponent(entity2, "GrowthComponent"))
+        if (Engine::GetInstance().Has<GrowthComponent>(entity2))
             EatEntity(entity2, entity1);
         else
             DestroyEntity(entity1);
@@ -258,32 +410,24 @@ void CollisionSystem::CombatEntities(std::shared_ptr<Entity> entity1,
     else
     {
         LOG_D("[CollisionSystem] Tied combat");
-        CollideBodies(entity1, entity2);
+        CollideBodies(contact);
     }
 }
 
-bool CollisionSystem::ReproduceEntities(std::shared_ptr<Entity> entity1,
-    std::shared_ptr<Entity> entity2)
+bool CollisionSystem::ReproduceEntities(Entity entity1,
+    Entity entity2)
 {
-    auto reproductionComponent1 = std::static_pointer_cast<ReproductionComponent>(
-        Engine::GetInstance().GetSingleComponentOfClass(entity1,
-            "ReproductionComponent"));
+    auto reproductionComponent1 = Engine::GetInstance().Get<ReproductionComponent>(entity1);
 
-    auto reproductionComponent2 = std::static_pointer_cast<ReproductionComponent>(
-        Engine::GetInstance().GetSingleComponentOfClass(entity2,
-            "ReproductionComponent"));
+    auto reproductionComponent2 = Engine::GetInstance().Get<ReproductionComponent>(entity2);
 
-    auto particleComponent1 = std::static_pointer_cast<ParticleComponent>(
-        Engine::GetInstance().GetSingleComponentOfClass(entity1,
-            "ParticleComponent"));
-    auto particleComponent2 = std::static_pointer_cast<ParticleComponent>(
-        Engine::GetInstance().GetSingleComponentOfClass(entity2,
-            "ParticleComponent"));
+    auto particleComponent1 = Engine::GetInstance().Get<ParticleComponent>(entity1);
+    auto particleComponent2 = Engine::GetInstance().Get<ParticleComponent>(entity2);
 
     auto position1 = particleComponent1->GetPosition();
     auto position2 = particleComponent2->GetPosition();
 
-    if (position1.CalculateDistance(position2) >= CFG_GETF("REPRODUCTION_DISTANCE_MAX"))
+    if (position1.CalculateDistance(position2) >= reproductionDistanceMax.Get())
         return true;
 
     auto enabled1 = reproductionComponent1->GetEnabled();
@@ -297,8 +441,8 @@ bool CollisionSystem::ReproduceEntities(std::shared_ptr<Entity> entity1,
 
     if (enabled1 && enabled2 && !reproduced1 && !reproduced2 && type1 == type2)
     {
-        LOG_D("[CollisionSystem] Reproducing entities " << entity1->GetId()
-            << " and " << entity2->GetId());
+        LOG_D("[CollisionSystem] Reproducing entities " << entity1.GetId()
+            << " and " << entity2.GetId());
         EntityFactory::CreateCell(particleComponent1->GetPosition() + Vector(50, 50));
         reproductionComponent1->SetReproduced(true);
         reproductionComponent2->SetReproduced(true);
@@ -308,17 +452,14 @@ bool CollisionSystem::ReproduceEntities(std::shared_ptr<Entity> entity1,
     return false;
 }
 
-void CollisionSystem::IncorporateEntity(std::shared_ptr<Entity> eaterEntity,
-    std::shared_ptr<Entity> eatableEntity)
+void CollisionSystem::IncorporateEntity(Entity eaterEntity,
+    Entity eatableEntity)
 {
-    LOG_D("[CollisionSystem] Entity " << eaterEntity->GetId()
-        << " is incorporating entity " << eatableEntity->GetId());
+    LOG_D("[CollisionSystem] Entity " << eaterEntity.GetId()
+        << " is incorporating entity " << eatableEntity.GetId());
 
-    auto spriteComponent = std::static_pointer_cast<SpriteComponent>(
-        Engine::GetInstance().GetSingleComponentOfClass(
-            eatableEntity, "SpriteComponent"));
-    auto complexityComponent = std::static_pointer_cast<ComplexityComponent>(
-        Engine::GetInstance().GetSingleComponentOfClass(eaterEntity, "ComplexityComponent"));
+    auto spriteComponent = Engine::GetInstance().Get<SpriteComponent>(eatableEntity);
+    auto complexityComponent = Engine::GetInstance().Get<ComplexityComponent>(eaterEntity);
 
     auto maxComplexity = complexityComponent->GetMaxComplexity();
     auto complexity = complexityComponent->GetComplexity();
@@ -338,52 +479,40 @@ void CollisionSystem::IncorporateEntity(std::shared_ptr<Entity> eaterEntity,
     }
 }
 
-void CollisionSystem::EatEntity(std::shared_ptr<Entity> eaterEntity,
-    std::shared_ptr<Entity> eatableEntity)
+void CollisionSystem::EatEntity(Entity eaterEntity,
+    Entity eatableEntity)
 {
-    LOG_D("[CollisionSystem] Entity " << eaterEntity->GetId() << " is eating entity " << eatableEntity->GetId());
+    LOG_D("[CollisionSystem] Entity " << eaterEntity.GetId() << " is eating entity " << eatableEntity.GetId());
 
-    if (Engine::GetInstance().HasComponent(eaterEntity, "InfectionComponent"))
+    if (Engine::GetInstance().Has<InfectionComponent>(eaterEntity))
     {
-        auto infectionComponent = std::static_pointer_cast<InfectionComponent>(Engine::GetInstance().GetSingleComponentOfClass(eaterEntity, "InfectionComponent"));
+        auto infectionComponent = Engine::GetInstance().Get<InfectionComponent>(eaterEntity);
 
         if (infectionComponent->GetInfectionType() == CannotEat)
             return;
     }
 
-    auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(eaterEntity, "GrowthComponent"));
+    auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(eaterEntity);
     auto energy = growthComponent->GetEnergy();
     ++energy;
     growthComponent->SetEnergy(energy);
     DestroyEntity(eatableEntity);
 
-    Engine::GetInstance().PlaySoundEffect(CFG_GETP("EAT_SOUND_EFFECT"));
+    Engine::GetInstance().PlaySoundEffect(eatSoundEffect.Get());
 }
 
-void CollisionSystem::DestroyEntity(std::shared_ptr<Entity> entity)
+void CollisionSystem::DestroyEntity(Entity entity)
 {
-    Engine::GetInstance().DeleteEntity(entity);
-
-    for (unsigned int i = 0; i < collidableEntities.size(); ++i)
-    {
-        auto entity = collidableEntities[i];
-
-        if (entity->GetId() == entity->GetId())
-        {
-            collidableEntities.erase(collidableEntities.begin() + i);
-            --i;
-        }
-    }
-
-    // Delete also from the entities to be collided.
-    deletedEntities.push_back(entity->GetId());
+    // The entity is only deleted after all systems are updated, but it is
+    // skipped by CheckCollisions for the rest of the frame.
+    Engine::GetInstance().DeleteEntityDeferred(entity);
 }
 
-void CollisionSystem::SlowEntity(std::shared_ptr<Entity> slowingEntity,
-    std::shared_ptr<Entity> movingEntity)
+void CollisionSystem::SlowEntity(Entity slowingEntity,
+    Entity movingEntity)
 {
-    auto slowingComponent = std::static_pointer_cast<SlowingComponent>(Engine::GetInstance().GetSingleComponentOfClass(slowingEntity, "SlowingComponent"));
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(movingEntity, "ParticleComponent"));
+    auto slowingComponent = Engine::GetInstance().Get<SlowingComponent>(slowingEntity);
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(movingEntity);
 
     float magnitude = slowingComponent->GetMagnitude();
     Vector velocity = particleComponent->GetVelocity();
@@ -393,11 +522,11 @@ void CollisionSystem::SlowEntity(std::shared_ptr<Entity> slowingEntity,
     particleComponent->SetVelocity(velocity);
 }
 
-void CollisionSystem::VitaminateEntity(std::shared_ptr<Entity> vitaminEntity,
-    std::shared_ptr<Entity> growingEntity)
+void CollisionSystem::VitaminateEntity(Entity vitaminEntity,
+    Entity growingEntity)
 {
-    auto vitaminComponent = std::static_pointer_cast<VitaminComponent>(Engine::GetInstance().GetSingleComponentOfClass(vitaminEntity, "VitaminComponent"));
-    auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(growingEntity, "GrowthComponent"));
+    auto vitaminComponent = Engine::GetInstance().Get<VitaminComponent>(vitaminEntity);
+    auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(growingEntity);
 
     auto growthFactor = vitaminComponent->GetGrowthFactor();
     auto growthPower = growthComponent->GetGrowthPower();
@@ -407,11 +536,11 @@ void CollisionSystem::VitaminateEntity(std::shared_ptr<Entity> vitaminEntity,
     growthComponent->SetGrowthPower(growthPower);
 }
 
-void CollisionSystem::EmitParticles(std::shared_ptr<Entity> entity)
+void CollisionSystem::EmitParticles(Entity entity)
 {
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
-    auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent");
-    auto complexityComponent = std::static_pointer_cast<ComplexityComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ComplexityComponent"));
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
+    auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(entity);
+    auto complexityComponent = Engine::GetInstance().Get<ComplexityComponent>(entity);
 
     if (spriteComponents.size() == 1)
         return;
@@ -421,17 +550,17 @@ void CollisionSystem::EmitParticles(std::shared_ptr<Entity> entity)
 
     for (unsigned int i = 1; i < spriteComponents.size(); ++i)
     {
-        auto sprite = std::static_pointer_cast<SpriteComponent>(spriteComponents[i]);
+        auto sprite = spriteComponents[i];
         Vector cellParticlePosition = sprite->GetPosition();
         cellParticlePosition.Rotate(particleComponent->GetAngle());
         cellParticlePosition += particleComponent->GetPosition();
         Vector cellParticleForce = sprite->GetPosition();
         cellParticleForce.Rotate(particleComponent->GetAngle());
         cellParticleForce.Normalize();
-        cellParticleForce *= CFG_GETF("COMPLEXITY_PARTICLE_EMIT_FORCE")*particleComponent->GetVelocity().GetMagnitude()/500;
+        cellParticleForce *= complexityParticleEmitForce.Get()*particleComponent->GetVelocity().GetMagnitude()/500;
 
         auto cellParticle = EntityFactory::CreateCellParticle(cellParticlePosition);
-        auto cellParticleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(cellParticle, "ParticleComponent"));
+        auto cellParticleComponent = Engine::GetInstance().Get<ParticleComponent>(cellParticle);
         cellParticleComponent->SetForce(cellParticleForce);
         cellParticleComponent->SetVelocity(particleComponent->GetVelocity());
     }
@@ -439,11 +568,11 @@ void CollisionSystem::EmitParticles(std::shared_ptr<Entity> entity)
     complexityComponent->SetComplexity(0);
 }
 
-bool CollisionSystem::TransmitInfection(std::shared_ptr<Entity> transmitterEntity,
-    std::shared_ptr<Entity> receiverEntity)
+bool CollisionSystem::TransmitInfection(Entity transmitterEntity,
+    Entity receiverEntity)
 {
-    auto transmitterInfectionComponent = std::static_pointer_cast<InfectionComponent>(Engine::GetInstance().GetSingleComponentOfClass(transmitterEntity, "InfectionComponent"));
-    auto receiverInfectionComponent = std::static_pointer_cast<InfectionComponent>(Engine::GetInstance().GetSingleComponentOfClass(receiverEntity, "InfectionComponent"));
+    auto transmitterInfectionComponent = Engine::GetInstance().Get<InfectionComponent>(transmitterEntity);
+    auto receiverInfectionComponent = Engine::GetInstance().Get<InfectionComponent>(receiverEntity);
 
     // Only transmit to healthy entities
     if (receiverInfectionComponent->GetInfectionType() != NoInfection)
@@ -462,43 +591,43 @@ bool CollisionSystem::TransmitInfection(std::shared_ptr<Entity> transmitterEntit
 
         if (transmitterInfectionComponent->GetInfectionType() == CannotInput)
         {
-            if (Engine::GetInstance().HasComponent(receiverEntity, "PlayerComponent"))
-                Engine::GetInstance().PlaySoundEffect(CFG_GETP("FROZEN_SOUND_EFFECT"));
+            if (Engine::GetInstance().Has<PlayerComponent>(receiverEntity))
+                Engine::GetInstance().PlaySoundEffect(frozenSoundEffect.Get());
 
-            auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(receiverEntity, "SpriteComponent");
+            auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(receiverEntity);
             Engine::GetInstance().GetEntityManager()->DeleteComponentsOfClass(receiverEntity, "SpriteComponent");
             Engine::GetInstance().AddComponent(
-            std::make_shared<SpriteComponent>(CFG_GETP("CELL_FROZEN_IMAGE"),
+            Engine::GetInstance().CreateComponent<SpriteComponent>(cellFrozenImage.Get(),
                 Vector(0, 0), 0, 0, true,
-                CFG_GETF("CELL_FROZEN_SCALE")), receiverEntity);
+                cellFrozenScale.Get()), receiverEntity);
             for (unsigned int i = 1; i < spriteComponents.size(); ++i)
                 Engine::GetInstance().AddComponent(spriteComponents[i], receiverEntity);
         }
         else if (transmitterInfectionComponent->GetInfectionType() == StrongImpulses)
         {
-            if (Engine::GetInstance().HasComponent(receiverEntity, "PlayerComponent"))
-                Engine::GetInstance().PlaySoundEffect(CFG_GETP("IMPULSES_SOUND_EFFECT"));
+            if (Engine::GetInstance().Has<PlayerComponent>(receiverEntity))
+                Engine::GetInstance().PlaySoundEffect(impulsesSoundEffect.Get());
 
-            auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(receiverEntity, "SpriteComponent");
+            auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(receiverEntity);
             Engine::GetInstance().GetEntityManager()->DeleteComponentsOfClass(receiverEntity, "SpriteComponent");
             Engine::GetInstance().AddComponent(
-            std::make_shared<SpriteComponent>(CFG_GETP("CELL_ERRACTIC_IMAGE"),
-                Vector(0, 0), 0, CFG_GETF("CELL_ERRACTIC_ROTATION_SPEED"),
-                true, CFG_GETF("CELL_ERRACTIC_SCALE")), receiverEntity);
+            Engine::GetInstance().CreateComponent<SpriteComponent>(cellErracticImage.Get(),
+                Vector(0, 0), 0, cellErracticRotationSpeed.Get(),
+                true, cellErracticScale.Get()), receiverEntity);
             for (unsigned int i = 1; i < spriteComponents.size(); ++i)
                 Engine::GetInstance().AddComponent(spriteComponents[i], receiverEntity);
         }
         else if (transmitterInfectionComponent->GetInfectionType() == CannotEat)
         {
-            if (Engine::GetInstance().HasComponent(receiverEntity, "PlayerComponent"))
-                Engine::GetInstance().PlaySoundEffect(CFG_GETP("IMPULSES_SOUND_EFFECT"));
+            if (Engine::GetInstance().Has<PlayerComponent>(receiverEntity))
+                Engine::GetInstance().PlaySoundEffect(impulsesSoundEffect.Get());
 
-            auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(receiverEntity, "SpriteComponent");
+            auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(receiverEntity);
             Engine::GetInstance().GetEntityManager()->DeleteComponentsOfClass(receiverEntity, "SpriteComponent");
             Engine::GetInstance().AddComponent(
-            std::make_shared<SpriteComponent>(CFG_GETP("CELL_CANNOT_EAT_IMAGE"),
+            Engine::GetInstance().CreateComponent<SpriteComponent>(cellCannotEatImage.Get(),
                 Vector(0, 0), 0, 0, true,
-                CFG_GETF("CELL_CANNOT_EAT_SCALE")), receiverEntity);
+                cellCannotEatScale.Get()), receiverEntity);
             for (unsigned int i = 1; i < spriteComponents.size(); ++i)
                 Engine::GetInstance().AddComponent(spriteComponents[i], receiverEntity);
         }
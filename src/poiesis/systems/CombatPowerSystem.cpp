@@ -1,5 +1,11 @@
 #include "poiesis/systems/CombatPowerSystem.h"
 
+CombatPowerSystem::CombatPowerSystem()
+{
+    Reads<GrowthComponent>();
+    Writes<CombatComponent>();
+}
+
 std::string CombatPowerSystem::GetName()
 {
     return "CombatPowerSystem";
@@ -10,14 +16,14 @@ void CombatPowerSystem::Update(float dt)
     // Avoid warnings for not using dt.
     LOG_D("[CombatPowerSystem] Update: " << dt);
 
-    auto combatEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("CombatComponent");
+    auto combatEntities = Engine::GetInstance().View<CombatComponent>();
 
     for (auto entity : combatEntities)
     {
-        if (Engine::GetInstance().HasComponent(entity, "GrowthComponent"))
+        if (Engine::GetInstance().Has<GrowthComponent>(entity))
         {
-            auto combatComponent = std::static_pointer_cast<CombatComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "CombatComponent"));
-            auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "GrowthComponent"));
+            auto combatComponent = Engine::GetInstance().Get<CombatComponent>(entity);
+            auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(entity);
 
             int power = growthComponent->GetLevel();
             combatComponent->SetPower(power);
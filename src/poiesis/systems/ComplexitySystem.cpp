@@ -1,5 +1,16 @@
 #include "poiesis/systems/ComplexitySystem.h"
 
+CfgFloat ComplexitySystem::complexityEnergyConsumingPeriod("COMPLEXITY_ENERGY_CONSUMING_PERIOD");
+CfgFloat ComplexitySystem::complexityEnergyConsumingChance("COMPLEXITY_ENERGY_CONSUMING_CHANCE");
+CfgInt ComplexitySystem::complexityMaximumEnergy("COMPLEXITY_MAXIMUM_ENERGY");
+CfgInt ComplexitySystem::complexityMinimumEnergy("COMPLEXITY_MINIMUM_ENERGY");
+CfgFloat ComplexitySystem::complexityParticleEmitForce("COMPLEXITY_PARTICLE_EMIT_FORCE");
+
+ComplexitySystem::ComplexitySystem() :
+    random("ComplexitySystem")
+{
+}
+
 std::string ComplexitySystem::GetName()
 {
     return "ComplexitySystem";
@@ -10,14 +21,14 @@ void ComplexitySystem::Update(float dt)
     std::shared_ptr<GrowthComponent> growthComponent;
     std::shared_ptr<SpriteComponent> spriteComponent;
     std::shared_ptr<ComplexityComponent> complexityComponent;
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("GrowthComponent");
+    auto entities = Engine::GetInstance().View<GrowthComponent>();
 
     timer.Update(dt);
 
     for (auto entity : entities)
     {
-        growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "GrowthComponent"));
-        complexityComponent = std::static_pointer_cast<ComplexityComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ComplexityComponent"));
+        growthComponent = Engine::GetInstance().Get<GrowthComponent>(entity);
+        complexityComponent = Engine::GetInstance().Get<ComplexityComponent>(entity);
 
         ConsumeEnergy(growthComponent);
         AdjustComplexityParticleDistance(entity, growthComponent);
@@ -26,30 +37,29 @@ void ComplexitySystem::Update(float dt)
     }
 
     if (timer.HasFired())
-        timer.SetTime(CFG_GETF("COMPLEXITY_ENERGY_CONSUMING_PERIOD"));
+        timer.SetTime(complexityEnergyConsumingPeriod.Get());
 }
 
 void ComplexitySystem::ConsumeEnergy(std::shared_ptr<GrowthComponent> growthComponent)
 {
-    Random r;
     int energy = growthComponent->GetEnergy();
 
-    if (timer.HasFired() && (r.GenerateFloat() < CFG_GETF("COMPLEXITY_ENERGY_CONSUMING_CHANCE")))
+    if (timer.HasFired() && (random.GenerateFloat() < complexityEnergyConsumingChance.Get()))
         --energy;
 
     growthComponent->SetEnergy(energy);
 }
 
 void ComplexitySystem::AdjustComplexityParticleDistance(
-    std::shared_ptr<Entity> entity,
+    Entity entity,
     std::shared_ptr<GrowthComponent> growthComponent)
 {
-    auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent");
+    auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(entity);
     std::shared_ptr<SpriteComponent> spriteComponent;
 
     for (unsigned int i = 1; i < spriteComponents.size(); ++i)
     {
-        spriteComponent = std::static_pointer_cast<SpriteComponent>(spriteComponents[i]);
+        spriteComponent = spriteComponents[i];
         auto position = spriteComponent->GetPosition();
         auto energy = growthComponent->GetEnergy();
         auto target = 100*(7 - energy)/10.0;
@@ -69,27 +79,27 @@ void ComplexitySystem::AdjustComplexityParticleDistance(
     }
 }
 
-bool ComplexitySystem::KillEntityWithoutEnergy(std::shared_ptr<Entity> entity,
+bool ComplexitySystem::KillEntityWithoutEnergy(Entity entity,
     std::shared_ptr<GrowthComponent> growthComponent)
 {
-    if (growthComponent->GetEnergy() > CFG_GETI("COMPLEXITY_MAXIMUM_ENERGY"))
+    if (growthComponent->GetEnergy() > complexityMaximumEnergy.Get())
     {
-        Engine::GetInstance().DeleteEntity(entity);
+        Engine::GetInstance().DeleteEntityDeferred(entity);
         return true;
     }
 
     return false;
 }
 
-void ComplexitySystem::EmitParticle(std::shared_ptr<Entity> entity)
+void ComplexitySystem::EmitParticle(Entity entity)
 {
-    auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "GrowthComponent"));
-    auto complexityComponent = std::static_pointer_cast<ComplexityComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ComplexityComponent"));
+    auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(entity);
+    auto complexityComponent = Engine::GetInstance().Get<ComplexityComponent>(entity);
 
-    if (growthComponent->GetEnergy() < CFG_GETI("COMPLEXITY_MINIMUM_ENERGY"))
+    if (growthComponent->GetEnergy() < complexityMinimumEnergy.Get())
     {
-        auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
-        auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent");
+        auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
+        auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(entity);
 
         if (spriteComponents.size() == 1)
             return;
@@ -102,20 +112,20 @@ void ComplexitySystem::EmitParticle(std::shared_ptr<Entity> entity)
             Engine::GetInstance().AddComponent(spriteComponent, entity);
         }
 
-        auto sprite = std::static_pointer_cast<SpriteComponent>(spriteComponents[spriteComponents.size()-1]);
+        auto sprite = spriteComponents[spriteComponents.size()-1];
         Vector cellParticlePosition = sprite->GetPosition();
         cellParticlePosition.Rotate(particleComponent->GetAngle());
         cellParticlePosition += particleComponent->GetPosition();
         Vector cellParticleForce = sprite->GetPosition();
         cellParticleForce.Rotate(particleComponent->GetAngle() + M_PI_2);
         cellParticleForce.Normalize();
-        cellParticleForce *= CFG_GETF("COMPLEXITY_PARTICLE_EMIT_FORCE");
+        cellParticleForce *= complexityParticleEmitForce.Get();
 
         complexityComponent->SetComplexity(complexityComponent->GetComplexity() - 1);
         growthComponent->SetEnergy(0);
 
         auto cellParticle = EntityFactory::CreateCellParticle(cellParticlePosition);
-        auto cellParticleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(cellParticle, "ParticleComponent"));
+        auto cellParticleComponent = Engine::GetInstance().Get<ParticleComponent>(cellParticle);
         cellParticleComponent->SetForce(cellParticleForce);
         cellParticleComponent->SetVelocity(particleComponent->GetVelocity());
     }
@@ -1,7 +1,16 @@
 #include "poiesis/systems/DebugSystem.h"
 
-DebugSystem::DebugSystem()
+CfgPath DebugSystem::fontFile("FONT_FILE");
+CfgInt DebugSystem::debugMessageSize("DEBUG_MESSAGE_SIZE");
+CfgInt DebugSystem::debugMessageX("DEBUG_MESSAGE_X");
+CfgInt DebugSystem::debugMessageY("DEBUG_MESSAGE_Y");
+CfgInt DebugSystem::debugProfilerZones("DEBUG_PROFILER_ZONES");
+
+DebugSystem::DebugSystem() :
+    numberOfAllocations(Allocations::GetNumberOfAllocations()),
+    frameAllocations(0)
 {
+    Presents();
     timer.SetPeriod(CFG_GETF("DEBUG_MESSAGE_PERIOD"));
     timer.SetCallback(std::bind(&DebugSystem::GenerateDebugMessages, this));
 }
@@ -19,15 +28,21 @@ void DebugSystem::Update(float dt)
     currentTime += dt;
     currentFps = 1/dt;
 
-    if (!Engine::GetInstance().GetGraphicsAdapter()->IsFontLoaded(CFG_GETP("FONT_FILE")))
-        Engine::GetInstance().GetGraphicsAdapter()->LoadFont(CFG_GETP("FONT_FILE"), CFG_GETI("DEBUG_MESSAGE_SIZE"));
+    // Counted from one update to the next, so the allocations of all systems
+    // and of the engine itself are included.
+    unsigned long allocations = Allocations::GetNumberOfAllocations();
+    frameAllocations = allocations - numberOfAllocations;
+    numberOfAllocations = allocations;
+
+    if (!Engine::GetInstance().GetGraphicsAdapter()->IsFontLoaded(fontFile.Get()))
+        Engine::GetInstance().GetGraphicsAdapter()->LoadFont(fontFile.Get(), debugMessageSize.Get());
 
     timer.Update(dt);
 
     for (unsigned int i = 0; i < messages.size(); ++i)
         Engine::GetInstance().GetGraphicsAdapter()->Write(messages[i],
-            CFG_GETP("FONT_FILE"), CFG_GETI("DEBUG_MESSAGE_X"),
-            CFG_GETI("DEBUG_MESSAGE_Y") + i*CFG_GETI("DEBUG_MESSAGE_SIZE"));
+            fontFile.Get(), debugMessageX.Get(),
+            debugMessageY.Get() + i*debugMessageSize.Get());
 }
 
 void DebugSystem::GenerateDebugMessages()
@@ -37,6 +52,7 @@ void DebugSystem::GenerateDebugMessages()
     GenerateFPSMessage();
     GenerateEngineMessage();
     GeneratePlayerMessage();
+    GenerateProfilerMessage();
 }
 
 void DebugSystem::GenerateTimeMessage()
@@ -47,13 +63,26 @@ void DebugSystem::GenerateTimeMessage()
 
 void DebugSystem::GenerateFPSMessage()
 {
+    FrameStats stats = Engine::GetInstance().GetFrameStats();
+    std::ostringstream frameTimes;
+
+    frameTimes << std::fixed << std::setprecision(2) << "Frame time: min "
+        << stats.minimum*1000 << " ms, avg " << stats.average*1000
+        << " ms, p99 " << stats.percentile99*1000 << " ms";
+
     messages.push_back("FPS: " + std::to_string(currentFps));
+    messages.push_back(frameTimes.str());
 }
 
 void DebugSystem::GenerateEngineMessage()
 {
     messages.push_back("Engine");
     messages.push_back("Entities: " + std::to_string(Engine::GetInstance().GetNumberOfEntities()));
+    messages.push_back("Pooled components: " + std::to_string(Engine::GetInstance().GetEntityManager()->GetNumberOfPooledComponents()));
+    messages.push_back("Component allocations: " + std::to_string(Engine::GetInstance().GetEntityManager()->GetNumberOfComponentAllocations()));
+
+    if (Allocations::IsCounting())
+        messages.push_back("Allocations last frame: " + std::to_string(frameAllocations));
 }
 
 void DebugSystem::GeneratePlayerMessage()
@@ -63,10 +92,10 @@ void DebugSystem::GeneratePlayerMessage()
 
     auto playerEntity = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
 
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "ParticleComponent"));
-    auto growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "GrowthComponent"));
-    auto combatComponent = std::static_pointer_cast<CombatComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "CombatComponent"));
-    auto complexityComponent = std::static_pointer_cast<ComplexityComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "ComplexityComponent"));
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(playerEntity);
+    auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(playerEntity);
+    auto combatComponent = Engine::GetInstance().Get<CombatComponent>(playerEntity);
+    auto complexityComponent = Engine::GetInstance().Get<ComplexityComponent>(playerEntity);
     messages.push_back("Player");
     messages.push_back("Position: " + particleComponent->GetPosition().ToString());
     messages.push_back("Velocity: " + std::to_string(particleComponent->GetVelocity().GetMagnitude()) + " " + std::to_string(particleComponent->GetVelocity().GetDirection()*180.0/M_PI));
@@ -75,4 +104,28 @@ void DebugSystem::GeneratePlayerMessage()
     messages.push_back("Growth power: " + std::to_string(growthComponent->GetGrowthPower()));
     messages.push_back("Combat power: " + std::to_string(combatComponent->GetPower()));
     messages.push_back("Complexity: " + std::to_string(complexityComponent->GetComplexity()));
+}
+
+void DebugSystem::GenerateProfilerMessage()
+{
+    if (!Profiler::GetInstance().IsEnabled())
+        return;
+
+    std::vector<ZoneStats> zoneStats = Profiler::GetInstance().GetZoneStats();
+    unsigned int numberOfZones = std::min<unsigned int>(zoneStats.size(),
+        debugProfilerZones.Get());
+
+    messages.push_back("Profiler");
+
+    for (unsigned int i = 0; i < numberOfZones; ++i)
+    {
+        std::ostringstream zoneTimes;
+
+        zoneTimes << std::fixed << std::setprecision(2) << zoneStats[i].name
+            << ": avg " << zoneStats[i].average*1000 << " ms, p95 "
+            << zoneStats[i].percentile95*1000 << " ms, max "
+            << zoneStats[i].maximum*1000 << " ms";
+
+        messages.push_back(zoneTimes.str());
+    }
 }
\ No newline at end of file
@@ -1,5 +1,26 @@
 #include "poiesis/systems/GrowthSystem.h"
 
+CfgFloat GrowthSystem::growthEnergyConsumingPeriod("GROWTH_ENERGY_CONSUMING_PERIOD");
+CfgFloat GrowthSystem::growthEnergyConsumingChance("GROWTH_ENERGY_CONSUMING_CHANCE");
+CfgInt GrowthSystem::growthEnergyLevelFastShrink("GROWTH_ENERGY_LEVEL_FAST_SHRINK");
+CfgInt GrowthSystem::growthEnergyLevelShrink("GROWTH_ENERGY_LEVEL_SHRINK");
+CfgInt GrowthSystem::growthEnergyLevelStagnation("GROWTH_ENERGY_LEVEL_STAGNATION");
+CfgInt GrowthSystem::growthEnergyLevelGrow("GROWTH_ENERGY_LEVEL_GROW");
+CfgInt GrowthSystem::growthDeltaFastShrink("GROWTH_DELTA_FAST_SHRINK");
+CfgInt GrowthSystem::growthDeltaShrink("GROWTH_DELTA_SHRINK");
+CfgInt GrowthSystem::growthDeltaStagnation("GROWTH_DELTA_STAGNATION");
+CfgInt GrowthSystem::growthDeltaGrow("GROWTH_DELTA_GROW");
+CfgInt GrowthSystem::growthDeltaFastGrow("GROWTH_DELTA_FAST_GROW");
+CfgInt GrowthSystem::growthUpperThreshold("GROWTH_UPPER_THRESHOLD");
+CfgInt GrowthSystem::growthLowerThreshold("GROWTH_LOWER_THRESHOLD");
+CfgInt GrowthSystem::growthLevelLimit("GROWTH_LEVEL_LIMIT");
+
+GrowthSystem::GrowthSystem() :
+    random("GrowthSystem")
+{
+    Writes<GrowthComponent, ColliderComponent, SpriteComponent>();
+}
+
 std::string GrowthSystem::GetName()
 {
     return "GrowthSystem";
@@ -10,15 +31,15 @@ void GrowthSystem::Update(float dt)
     std::shared_ptr<GrowthComponent> growthComponent;
     std::shared_ptr<SpriteComponent> spriteComponent;
     std::shared_ptr<ColliderComponent> colliderComponent;
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("GrowthComponent");
+    auto entities = Engine::GetInstance().View<GrowthComponent>();
 
     timer.Update(dt);
 
     for (auto entity : entities)
     {
         // Load entity's data
-        growthComponent = std::static_pointer_cast<GrowthComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "GrowthComponent"));
-        colliderComponent = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ColliderComponent"));
+        growthComponent = Engine::GetInstance().Get<GrowthComponent>(entity);
+        colliderComponent = Engine::GetInstance().Get<ColliderComponent>(entity);
 
         // Execute growth logic
         ConsumeEnergy(growthComponent);
@@ -32,24 +53,23 @@ void GrowthSystem::Update(float dt)
         UpdateCollisionRadius(growthComponent, colliderComponent);
 
         // Save entity's data
-        for (auto component : Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent"))
+        for (auto component : Engine::GetInstance().GetComponents<SpriteComponent>(entity))
         {
-            spriteComponent = std::static_pointer_cast<SpriteComponent>(component);
+            spriteComponent = component;
             UpdateSpriteSize(spriteComponent, growthComponent);
             UpdateSpriteFrameDuration(spriteComponent, growthComponent);
         }
     }
 
     if (timer.HasFired())
-        timer.SetTime(CFG_GETF("GROWTH_ENERGY_CONSUMING_PERIOD"));
+        timer.SetTime(growthEnergyConsumingPeriod.Get());
 }
 
 void GrowthSystem::ConsumeEnergy(std::shared_ptr<GrowthComponent> growthComponent)
 {
-    Random r;
     int energy = growthComponent->GetEnergy();
 
-    if (timer.HasFired() && (r.GenerateFloat() < CFG_GETF("GROWTH_ENERGY_CONSUMING_CHANCE")))
+    if (timer.HasFired() && (random.GenerateFloat() < growthEnergyConsumingChance.Get()))
         --energy;
 
     growthComponent->SetEnergy(energy);
@@ -67,38 +87,38 @@ int GrowthSystem::CalculateGrowthDelta(std::shared_ptr<GrowthComponent> growthCo
     int energy = growthComponent->GetEnergy();
     int delta;
 
-    if (energy <= CFG_GETI("GROWTH_ENERGY_LEVEL_FAST_SHRINK"))
-        delta = CFG_GETI("GROWTH_DELTA_FAST_SHRINK");
-    else if (energy <= CFG_GETI("GROWTH_ENERGY_LEVEL_SHRINK"))
-        delta = CFG_GETI("GROWTH_DELTA_SHRINK");
-    else if (energy <= CFG_GETI("GROWTH_ENERGY_LEVEL_STAGNATION"))
-        delta = CFG_GETI("GROWTH_DELTA_STAGNATION");
-    else if (energy <= CFG_GETI("GROWTH_ENERGY_LEVEL_GROW"))
-        delta = CFG_GETI("GROWTH_DELTA_GROW");
+    if (energy <= growthEnergyLevelFastShrink.Get())
+        delta = growthDeltaFastShrink.Get();
+    else if (energy <= growthEnergyLevelShrink.Get())
+        delta = growthDeltaShrink.Get();
+    else if (energy <= growthEnergyLevelStagnation.Get())
+        delta = growthDeltaStagnation.Get();
+    else if (energy <= growthEnergyLevelGrow.Get())
+        delta = growthDeltaGrow.Get();
     else
-        delta = CFG_GETI("GROWTH_DELTA_FAST_GROW");
+        delta = growthDeltaFastGrow.Get();
 
     return delta;
 }
 
-void GrowthSystem::GrowOrShrink(std::shared_ptr<Entity> entity,
+void GrowthSystem::GrowOrShrink(Entity entity,
     std::shared_ptr<GrowthComponent> growthComponent)
 {
     int growthPower = growthComponent->GetGrowthPower();
 
-    if (growthPower >= CFG_GETI("GROWTH_UPPER_THRESHOLD"))
+    if (growthPower >= growthUpperThreshold.Get())
         Grow(entity, growthComponent);
-    else if (growthPower <= CFG_GETI("GROWTH_LOWER_THRESHOLD"))
+    else if (growthPower <= growthLowerThreshold.Get())
         Shrink(entity, growthComponent);
 }
 
-void GrowthSystem::Grow(std::shared_ptr<Entity> entity,
+void GrowthSystem::Grow(Entity entity,
     std::shared_ptr<GrowthComponent> growthComponent)
 {
     int level = growthComponent->GetLevel();
 
     level += 1;
-    LOG_I("[GrowthSystem] Entity \"" << entity->GetId() << "\" has grown to "
+    LOG_I("[GrowthSystem] Entity \"" << entity.GetId() << "\" has grown to "
         << "level " << level);
 
     growthComponent->SetEnergy(0);
@@ -106,13 +126,13 @@ void GrowthSystem::Grow(std::shared_ptr<Entity> entity,
     growthComponent->SetLevel(level);
 }
 
-void GrowthSystem::Shrink(std::shared_ptr<Entity> entity,
+void GrowthSystem::Shrink(Entity entity,
     std::shared_ptr<GrowthComponent> growthComponent)
 {
     int level = growthComponent->GetLevel();
 
     level -= 1;
-    LOG_I("[GrowthSystem] Entity \"" << entity->GetId() << "\" has shrunk "
+    LOG_I("[GrowthSystem] Entity \"" << entity.GetId() << "\" has shrunk "
         << "to level " << level);
 
     growthComponent->SetEnergy(0);
@@ -123,7 +143,7 @@ void GrowthSystem::Shrink(std::shared_ptr<Entity> entity,
 void GrowthSystem::SaturateLevel(std::shared_ptr<GrowthComponent> growthComponent)
 {
     int level = growthComponent->GetLevel();
-    int maxLevel = CFG_GETI("GROWTH_LEVEL_LIMIT");
+    int maxLevel = growthLevelLimit.Get();
 
     if (level > maxLevel)
         level = maxLevel;
@@ -131,12 +151,12 @@ void GrowthSystem::SaturateLevel(std::shared_ptr<GrowthComponent> growthComponen
     growthComponent->SetLevel(level);
 }
 
-bool GrowthSystem::KillSmallEntity(std::shared_ptr<Entity> entity,
+bool GrowthSystem::KillSmallEntity(Entity entity,
     std::shared_ptr<GrowthComponent> growthComponent)
 {
     if (growthComponent->GetLevel() <= 0)
     {
-        Engine::GetInstance().DeleteEntity(entity);
+        Engine::GetInstance().DeleteEntityDeferred(entity);
         return true;
     }
 
@@ -163,9 +183,9 @@ void GrowthSystem::UpdateSpriteFrameDuration(std::shared_ptr<SpriteComponent> sp
     float growthPower = growthComponent->GetGrowthPower();
     float duration;
 
-    if (growthPower > CFG_GETI("GROWTH_UPPER_THRESHOLD")/3)
+    if (growthPower > growthUpperThreshold.Get()/3)
         duration = 0.01;
-    else if (growthPower < CFG_GETI("GROWTH_LOWER_THRESHOLD")/3)
+    else if (growthPower < growthLowerThreshold.Get()/3)
         duration = 0.5;
     else
         duration = 0.1;
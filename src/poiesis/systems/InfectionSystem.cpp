@@ -1,5 +1,20 @@
 #include "poiesis/systems/InfectionSystem.h"
 
+CfgFloat InfectionSystem::infectionImpulsesForce("INFECTION_IMPULSES_FORCE");
+CfgPath InfectionSystem::cellAnimation("CELL_ANIMATION");
+CfgFloat InfectionSystem::cellAnimationScale("CELL_ANIMATION_SCALE");
+CfgInt InfectionSystem::cellAnimationNumFrames("CELL_ANIMATION_NUM_FRAMES");
+CfgFloat InfectionSystem::cellAnimationFrameDuration("CELL_ANIMATION_FRAME_DURATION");
+CfgPath InfectionSystem::reproductionMaturingAnimation("REPRODUCTION_MATURING_ANIMATION");
+CfgFloat InfectionSystem::reproductionMaturingRotationSpeed("REPRODUCTION_MATURING_ROTATION_SPEED");
+CfgFloat InfectionSystem::reproductionMaturingScale("REPRODUCTION_MATURING_SCALE");
+CfgInt InfectionSystem::reproductionMaturingNumFrames("REPRODUCTION_MATURING_NUM_FRAMES");
+
+InfectionSystem::InfectionSystem() :
+    isLevel3(false), random("InfectionSystem")
+{
+}
+
 void InfectionSystem::SetLevel3(bool isLevel3)
 {
     this->isLevel3 = isLevel3;
@@ -12,11 +27,11 @@ std::string InfectionSystem::GetName()
 
 void InfectionSystem::Update(float dt)
 {
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("InfectionComponent");
+    auto entities = Engine::GetInstance().View<InfectionComponent>();
 
     for (auto entity : entities)
     {
-        auto infectionComponent = std::static_pointer_cast<InfectionComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "InfectionComponent"));
+        auto infectionComponent = Engine::GetInstance().Get<InfectionComponent>(entity);
         
         if (infectionComponent->GetTemporary())
         {
@@ -30,26 +45,26 @@ void InfectionSystem::Update(float dt)
                 infectionComponent->SetInfectionType(NoInfection);
                 infectionComponent->SetTemporary(false);
 
-                auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent");
+                auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(entity);
                 Engine::GetInstance().GetEntityManager()->DeleteComponentsOfClass(entity, "SpriteComponent");
 
                 if (!isLevel3)
                 {
                     Engine::GetInstance().AddComponent(
-                        std::make_shared<SpriteComponent>(CFG_GETP("CELL_ANIMATION"),
+                        Engine::GetInstance().CreateComponent<SpriteComponent>(cellAnimation.Get(),
                             Vector(0, 0), 0, 0, true,
-                            CFG_GETF("CELL_ANIMATION_SCALE"),
-                            CFG_GETI("CELL_ANIMATION_NUM_FRAMES"),
-                            CFG_GETF("CELL_ANIMATION_FRAME_DURATION"), true, true),
+                            cellAnimationScale.Get(),
+                            cellAnimationNumFrames.Get(),
+                            cellAnimationFrameDuration.Get(), true, true),
                         entity);
                 }
                 else
                 {
                     Engine::GetInstance().AddComponent(
-                        std::make_shared<SpriteComponent>(CFG_GETP("REPRODUCTION_MATURING_ANIMATION"),
-                            Vector(0, 0), 0, CFG_GETF("REPRODUCTION_MATURING_ROTATION_SPEED"), true,
-                            CFG_GETF("REPRODUCTION_MATURING_SCALE"),
-                            CFG_GETI("REPRODUCTION_MATURING_NUM_FRAMES"),
+                        Engine::GetInstance().CreateComponent<SpriteComponent>(reproductionMaturingAnimation.Get(),
+                            Vector(0, 0), 0, reproductionMaturingRotationSpeed.Get(), true,
+                            reproductionMaturingScale.Get(),
+                            reproductionMaturingNumFrames.Get(),
                             1, true, true),
                         entity);
                 }
@@ -63,15 +78,14 @@ void InfectionSystem::Update(float dt)
 
         if (infectionComponent->GetInfectionType() == StrongImpulses)
         {
-            Random r;
             float strongImpulseChance = 0.1;
 
-            if (r.GenerateFloat() < strongImpulseChance)
+            if (random.GenerateFloat() < strongImpulseChance)
             {
-                auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
+                auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
 
-                Vector randomForce(r.GenerateFloat(-1, 1), r.GenerateFloat(-1, 1));
-                randomForce *= CFG_GETF("INFECTION_IMPULSES_FORCE");
+                Vector randomForce(random.GenerateFloat(-1, 1), random.GenerateFloat(-1, 1));
+                randomForce *= infectionImpulsesForce.Get();
 
                 particleComponent->SetForce(randomForce);
             }
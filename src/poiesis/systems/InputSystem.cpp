@@ -1,5 +1,10 @@
 #include "poiesis/systems/InputSystem.h"
 
+CfgInt InputSystem::windowWidth("WINDOW_WIDTH");
+CfgInt InputSystem::windowHeight("WINDOW_HEIGHT");
+CfgFloat InputSystem::inputPeriod("INPUT_PERIOD");
+CfgFloat InputSystem::inputForceMagnitude("INPUT_FORCE");
+
 std::string InputSystem::GetName()
 {
     return "InputSystem";
@@ -28,19 +33,19 @@ bool InputSystem::ProcessButtonClick()
     Vector mousePosition = Engine::GetInstance().GetMousePosition();
     Rectangle rectangle;
     std::shared_ptr<ButtonComponent> buttonComponent;
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("ButtonComponent");
+    auto entities = Engine::GetInstance().View<ButtonComponent>();
 
     for (auto entity : entities)
     {
-        if (!Engine::GetInstance().HasComponent(entity, "ButtonComponent"))
+        if (!Engine::GetInstance().Has<ButtonComponent>(entity))
             continue;
 
-        buttonComponent = std::static_pointer_cast<ButtonComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ButtonComponent"));
+        buttonComponent = Engine::GetInstance().Get<ButtonComponent>(entity);
         rectangle = buttonComponent->GetRectangle();
 
         if (rectangle.IsInside(mousePosition))
         {
-            LOG_I("[InputType] Clicked on button " << entity->GetId());
+            LOG_I("[InputType] Clicked on button " << entity.GetId());
             auto callback = buttonComponent->GetCallback();
             callback();
             processed = true;
@@ -56,9 +61,9 @@ bool InputSystem::ProcessPlayerImpulse()
         return false;
 
     auto playerEntity = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
-    auto colliderComponent = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "ColliderComponent"));
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "ParticleComponent"));
-    auto infectionComponent = std::static_pointer_cast<InfectionComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "InfectionComponent"));
+    auto colliderComponent = Engine::GetInstance().Get<ColliderComponent>(playerEntity);
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(playerEntity);
+    auto infectionComponent = Engine::GetInstance().Get<InfectionComponent>(playerEntity);
     auto mousePosition = Engine::GetInstance().GetMousePosition();
 
     if (infectionComponent->GetInfectionType() == CannotInput)
@@ -95,8 +100,8 @@ bool InputSystem::ProcessPlayerImpulse()
 bool InputSystem::HasClickedOnPlayer(Vector mousePosition)
 {
     auto playerEntity = Engine::GetInstance().GetEntityWithComponentOfClass("PlayerComponent");
-    auto colliderComponent = std::static_pointer_cast<ColliderComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "ColliderComponent"));
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(playerEntity, "ParticleComponent"));
+    auto colliderComponent = Engine::GetInstance().Get<ColliderComponent>(playerEntity);
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(playerEntity);
     auto playerPosition = particleComponent->GetPosition();
     Vector worldClickPosition = ConvertWindowToWorldPosition(mousePosition);
     return worldClickPosition.CalculateDistance(playerPosition) <= colliderComponent->GetRadius();
@@ -104,7 +109,7 @@ bool InputSystem::HasClickedOnPlayer(Vector mousePosition)
 
 Vector InputSystem::ConvertWindowToWorldPosition(Vector windowPosition)
 {
-    Vector screenOffset = Vector(CFG_GETI("WINDOW_WIDTH"), CFG_GETI("WINDOW_HEIGHT"))*0.5;
+    Vector screenOffset = Vector(windowWidth.Get(), windowHeight.Get())*0.5;
     Vector cameraPosition = GetCameraPosition();
     float cameraHeight = GetCameraHeight();
     Vector worldPosition = cameraPosition + (windowPosition - screenOffset)*cameraHeight;
@@ -118,7 +123,7 @@ Vector InputSystem::GetCameraPosition()
     if (Engine::GetInstance().HasEntityWithComponentOfClass("CameraComponent"))
     {
         auto cameraEntity = Engine::GetInstance().GetEntityWithComponentOfClass("CameraComponent");
-        auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntity, "CameraComponent"));
+        auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntity);
         cameraPosition = cameraComponent->GetPosition();
     }
 
@@ -128,11 +133,11 @@ Vector InputSystem::GetCameraPosition()
 float InputSystem::GetCameraHeight()
 {
     float cameraHeight = 1;
-    auto cameraEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("CameraComponent");
+    auto& cameraEntities = Engine::GetInstance().View<CameraComponent>();
 
     if (cameraEntities.size() > 0)
     {
-        auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntities[0], "CameraComponent"));
+        auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntities[0]);
         cameraHeight = cameraComponent->GetHeight();
     }
 
@@ -147,11 +152,11 @@ bool InputSystem::ProcessParticleForceInput()
     if (!particleForceTimer.HasFired())
         return false;
 
-    particleForceTimer.SetTime(CFG_GETF("INPUT_PERIOD"));
+    particleForceTimer.SetTime(inputPeriod.Get());
 
     Vector mousePosition = Engine::GetInstance().GetMousePosition();
     Vector worldPosition = ConvertWindowToWorldPosition(mousePosition);
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("MoveableComponent");
+    auto entities = Engine::GetInstance().View<MoveableComponent>();
     std::shared_ptr<MoveableComponent> moveableComponent;
     std::shared_ptr<ParticleComponent> particleComponent;
     Vector particlePosition;
@@ -163,8 +168,8 @@ bool InputSystem::ProcessParticleForceInput()
 
     for (auto entity : entities)
     {
-        moveableComponent = std::static_pointer_cast<MoveableComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "MoveableComponent"));
-        particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
+        moveableComponent = Engine::GetInstance().Get<MoveableComponent>(entity);
+        particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
 
         if (moveableComponent->GetActive())
         {
@@ -172,7 +177,7 @@ bool InputSystem::ProcessParticleForceInput()
             distance = particlePosition.CalculateDistance(worldPosition);
             inputForce = worldPosition - particlePosition;
             inputForce.Normalize();
-            inputForce *= -CFG_GETF("INPUT_FORCE")/(1 + distance); // Summing with 1 to avoid division by zero.
+            inputForce *= -inputForceMagnitude.Get()/(1 + distance); // Summing with 1 to avoid division by zero.
             resultantForce = inputForce + particleComponent->GetForce();
             particleComponent->SetForce(resultantForce);
         }
@@ -1,62 +1,39 @@
 #include "poiesis/systems/ParticleSystem.h"
 
-std::string ParticleSystem::GetName()
-{
-    return "ParticleSystem";
-}
+CfgFloat ParticleSystem::particleRandomForceMag("PARTICLE_RANDOM_FORCE_MAG");
+CfgInt ParticleSystem::particleGrainSize("PARTICLE_GRAIN_SIZE");
 
-void ParticleSystem::Update(float dt)
+ParticleSystem::ParticleSystem() :
+    store(ParticleStore::GetIntegratedStore()),
+    randomStream(Random::GetStreamId("ParticleSystem")), numberOfUpdates(0)
 {
-    auto components = Engine::GetInstance().GetAllComponentsOfClass("ParticleComponent");
-    std::shared_ptr<ParticleComponent> particleComponent;
-
-    for (auto component : components)
-    {
-        particleComponent = std::static_pointer_cast<ParticleComponent>(component);
-        UpdateParticleProperties(particleComponent, dt);
-
-        // Erases the force vector since if no force is applied, no acceleration
-        // exists.
-        particleComponent->SetForce(Vector(0, 0));
-    }
+    Writes<ParticleComponent>();
 }
 
-void ParticleSystem::UpdateParticleProperties(
-    std::shared_ptr<ParticleComponent> particleComponent, float dt)
+std::string ParticleSystem::GetName()
 {
-    float inverseMass = particleComponent->GetInverseMass();
-    float damping = particleComponent->GetDamping();
-    Vector force = particleComponent->GetForce();
-    Vector position = particleComponent->GetPosition();
-    Vector velocity = particleComponent->GetVelocity();
-    Vector acceleration = particleComponent->GetAcceleration();
-    float angle = particleComponent->GetAngle();
-    float angularVelocity = particleComponent->GetAngularVelocity();
-    Vector randomVector = GenerateRandomForce();
-
-    force += randomVector;
-    position = position + velocity*dt + acceleration*dt*dt*0.5;
-    velocity = velocity*damping + acceleration*dt;
-    acceleration = force*inverseMass;
-
-    Vector angleVector(1, 0);
-    angleVector.Rotate(angle + angularVelocity*dt);
-    angle = angleVector.GetDirection();
-
-    particleComponent->SetPosition(position);
-    particleComponent->SetVelocity(velocity);
-    particleComponent->SetAcceleration(acceleration);
-    particleComponent->SetForce(force);
-    particleComponent->SetAngle(angle);
-    particleComponent->SetAngularVelocity(angularVelocity);
+    return "ParticleSystem";
 }
 
-Vector ParticleSystem::GenerateRandomForce()
+void ParticleSystem::Update(float dt)
 {
-    Random random;
-    float randomFactor = CFG_GETF("PARTICLE_RANDOM_FORCE_MAG");
-    float randomX = random.GenerateFloat(-1, 1);
-    float randomY = random.GenerateFloat(-1, 1);
-    Vector randomVector = Vector(randomX, randomY)*randomFactor;
-    return randomVector;
-}
\ No newline at end of file
+    float randomForceMagnitude = particleRandomForceMag.Get();
+    uint64_t update = numberOfUpdates++;
+
+    // Particles are integrated in place in their store, each range of
+    // indices by a different job.
+    Engine::GetInstance().GetJobSystem()->ParallelFor(
+        store->GetNumberOfSlots(), particleGrainSize.Get(),
+        [this, dt, randomForceMagnitude, update](unsigned int first,
+            unsigned int last)
+        {
+            // Each range draws from its own substream, so random forces
+            // depend neither on the thread running the job nor on the number
+            // of workers.
+            Random random(randomStream, (update << 32) | first);
+
+            store->GenerateRandomForces(first, last, random,
+                randomForceMagnitude);
+            store->Integrate(first, last, dt);
+        });
+}
@@ -1,5 +1,14 @@
 #include "poiesis/systems/RenderingSystem.h"
 
+CfgInt RenderingSystem::windowWidth("WINDOW_WIDTH");
+CfgInt RenderingSystem::windowHeight("WINDOW_HEIGHT");
+CfgFloat RenderingSystem::renderingMaxDistance("RENDERING_MAX_DISTANCE");
+
+RenderingSystem::RenderingSystem()
+{
+    Presents();
+}
+
 std::string RenderingSystem::GetName()
 {
     return "RenderingSystem";
@@ -10,7 +19,7 @@ void RenderingSystem::Update(float dt)
     // Avoid warnings for not using dt.
     LOG_D("[RenderingSystem] Update: " << dt);
 
-    auto entities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("SpriteComponent");
+    auto& entities = Engine::GetInstance().View<SpriteComponent>();
     Vector cameraOffset = CalculateCameraOffset();
     Vector cameraPosition = cameraOffset + CalculateScreenOffset();
     float cameraHeight = GetCameraHeight();
@@ -19,17 +28,17 @@ void RenderingSystem::Update(float dt)
 
     for (auto entity : entities)
     {
-        if (Engine::GetInstance().HasComponent(entity, "ButtonComponent"))
+        if (Engine::GetInstance().Has<ButtonComponent>(entity))
         {
             RenderGUI(entity);
         }
-        else if (Engine::GetInstance().HasComponent(entity, "ParticleComponent"))
+        else if (Engine::GetInstance().Has<ParticleComponent>(entity))
         {
             RenderParticle(entity, cameraPosition, cameraHeight);
         }
         else
         {
-            LOG_E("[RenderingSystem] Entity " << entity->GetId() << " contains sprite without positioning components.");
+            LOG_E("[RenderingSystem] Entity " << entity.GetId() << " contains sprite without positioning components.");
             exit(1);
         }
     }
@@ -39,19 +48,20 @@ void RenderingSystem::Update(float dt)
 
 Vector RenderingSystem::CalculateScreenOffset()
 {
-    return Vector(CFG_GETI("WINDOW_WIDTH"), CFG_GETI("WINDOW_HEIGHT"))*0.5;
+    return Vector(windowWidth.Get(), windowHeight.Get())*0.5;
 }
 
 Vector RenderingSystem::CalculateCameraOffset()
 {
     Vector cameraOffset;
-    auto cameraEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("CameraComponent");
+    auto& cameraEntities = Engine::GetInstance().View<CameraComponent>();
 
     if (cameraEntities.size() > 0)
     {
-        auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntities[0], "CameraComponent"));
+        auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntities[0]);
         Vector screenOffset = CalculateScreenOffset();
-        cameraOffset = cameraComponent->GetPosition() - screenOffset;
+        cameraOffset = cameraComponent->GetInterpolatedPosition(
+            Engine::GetInstance().GetInterpolation()) - screenOffset;
     }
 
     return cameraOffset;
@@ -60,55 +70,59 @@ Vector RenderingSystem::CalculateCameraOffset()
 float RenderingSystem::GetCameraHeight()
 {
     float cameraHeight = 1;
-    auto cameraEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("CameraComponent");
+    auto& cameraEntities = Engine::GetInstance().View<CameraComponent>();
 
     if (cameraEntities.size() > 0)
     {
-        auto cameraComponent = std::static_pointer_cast<CameraComponent>(Engine::GetInstance().GetSingleComponentOfClass(cameraEntities[0], "CameraComponent"));
+        auto cameraComponent = Engine::GetInstance().Get<CameraComponent>(cameraEntities[0]);
         cameraHeight = cameraComponent->GetHeight();
     }
 
     return cameraHeight;
 }
 
-void RenderingSystem::RenderParticle(std::shared_ptr<Entity> entity, Vector cameraPosition, float cameraHeight)
+void RenderingSystem::RenderParticle(Entity entity, Vector cameraPosition, float cameraHeight)
 {
     Vector position;
     std::shared_ptr<SpriteComponent> spriteComponent;
-    auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent");
-    auto particleComponent = std::static_pointer_cast<ParticleComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ParticleComponent"));
+    auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(entity);
+    auto particleComponent = Engine::GetInstance().Get<ParticleComponent>(entity);
+
+    // Particles are drawn between their last two simulation steps.
+    float interpolation = Engine::GetInstance().GetInterpolation();
+    Vector particlePosition = particleComponent->GetInterpolatedPosition(interpolation);
+    float particleAngle = particleComponent->GetInterpolatedAngle(interpolation);
             
     // Skip rendering entities that are too far from the screen.
-    if (particleComponent->GetPosition().CalculateDistance(cameraPosition) > CFG_GETF("RENDERING_MAX_DISTANCE")*GetCameraHeight())
+    if (particlePosition.CalculateDistance(cameraPosition) > renderingMaxDistance.Get()*GetCameraHeight())
         return;
 
     for (auto component : spriteComponents)
     {
-        spriteComponent = std::static_pointer_cast<SpriteComponent>(component);
+        spriteComponent = component;
         Vector spritePosition = spriteComponent->GetPosition();
-        spritePosition.Rotate(particleComponent->GetAngle());
-        Vector particlePosition = particleComponent->GetPosition();
+        spritePosition.Rotate(particleAngle);
         position = CalculateScreenOffset() - (cameraPosition - (spritePosition + particlePosition))*(1/cameraHeight);
         RenderSprite(entity, spriteComponent, position, cameraHeight);
     }
 }
 
-void RenderingSystem::RenderGUI(std::shared_ptr<Entity> entity)
+void RenderingSystem::RenderGUI(Entity entity)
 {
     Vector position;
     std::shared_ptr<SpriteComponent> spriteComponent;
-    auto spriteComponents = Engine::GetInstance().GetComponentsOfClass(entity, "SpriteComponent");
-    std::shared_ptr<ButtonComponent> buttonComponent = std::static_pointer_cast<ButtonComponent>(Engine::GetInstance().GetSingleComponentOfClass(entity, "ButtonComponent"));
+    auto spriteComponents = Engine::GetInstance().GetComponents<SpriteComponent>(entity);
+    std::shared_ptr<ButtonComponent> buttonComponent = Engine::GetInstance().Get<ButtonComponent>(entity);
 
     for (auto component : spriteComponents)
     {
-        spriteComponent = std::static_pointer_cast<SpriteComponent>(component);
+        spriteComponent = component;
         position = spriteComponent->GetPosition() + buttonComponent->GetRectangle().GetCenter();
         RenderSprite(entity, spriteComponent, position);
     }
 }
 
-void RenderingSystem::RenderSprite(std::shared_ptr<Entity> entity, std::shared_ptr<SpriteComponent> spriteComponent, Vector position, float height)
+void RenderingSystem::RenderSprite(Entity entity, std::shared_ptr<SpriteComponent> spriteComponent, Vector position, float height)
 {
     std::string filename = spriteComponent->GetFilename();
 
@@ -121,7 +135,7 @@ void RenderingSystem::RenderSprite(std::shared_ptr<Entity> entity, std::shared_p
     if (!Engine::GetInstance().GetGraphicsAdapter()->IsLoaded(filename))
     {
         Engine::GetInstance().GetGraphicsAdapter()->LoadImage(filename);
-        LOG_D("[RenderingSystem] Loaded image \"" << filename << "\" for entity with ID: " << entity->GetId());
+        LOG_D("[RenderingSystem] Loaded image \"" << filename << "\" for entity with ID: " << entity.GetId());
     }
 
     auto currentFrame = spriteComponent->GetCurrentFrame();
@@ -137,5 +151,5 @@ void RenderingSystem::RenderSprite(std::shared_ptr<Entity> entity, std::shared_p
         Engine::GetInstance().GetGraphicsAdapter()->RenderCenteredImage(filename, position.GetX(), position.GetY(), spriteComponent->GetRotation(), spriteComponent->GetScale()/height, currentFrame, numFrames);
     else
         Engine::GetInstance().GetGraphicsAdapter()->RenderImage(filename, position.GetX(), position.GetY(), spriteComponent->GetRotation(), spriteComponent->GetScale()/height, currentFrame, numFrames);
-    LOG_D("[RenderingSystem] Rendered image \"" << filename << "\" for entity with ID: " << entity->GetId());
+    LOG_D("[RenderingSystem] Rendered image \"" << filename << "\" for entity with ID: " << entity.GetId());
 }
\ No newline at end of file
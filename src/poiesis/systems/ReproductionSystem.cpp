@@ -1,5 +1,15 @@
 #include "poiesis/systems/ReproductionSystem.h"
 
+CfgFloat ReproductionSystem::reproductionEnergyConsumingPeriod("REPRODUCTION_ENERGY_CONSUMING_PERIOD");
+CfgFloat ReproductionSystem::reproductionEnergyConsumingChance("REPRODUCTION_ENERGY_CONSUMING_CHANCE");
+CfgInt ReproductionSystem::level3MaxEnergy("LEVEL_3_MAX_ENERGY");
+
+ReproductionSystem::ReproductionSystem() :
+    random("ReproductionSystem")
+{
+    Writes<ReproductionComponent, GrowthComponent, SpriteComponent>();
+}
+
 std::string ReproductionSystem::GetName()
 {
     return "ReproductionSystem";
@@ -10,45 +20,38 @@ void ReproductionSystem::Update(float dt)
     // Avoid warnings for not using dt.
     LOG_D("[ReproductionSystem] Update: " << dt);
 
-    auto combatEntities = Engine::GetInstance().GetAllEntitiesWithComponentOfClass("ReproductionComponent");
+    auto combatEntities = Engine::GetInstance().View<ReproductionComponent>();
 
     timer.Update(dt);
 
     for (auto entity : combatEntities)
     {
-        auto reproductionComponent = std::static_pointer_cast<ReproductionComponent>(
-            Engine::GetInstance().GetSingleComponentOfClass(entity,
-                "ReproductionComponent"));
-        auto growthComponent = std::static_pointer_cast<GrowthComponent>(
-            Engine::GetInstance().GetSingleComponentOfClass(entity,
-                "GrowthComponent"));
-        auto spriteComponent = std::static_pointer_cast<SpriteComponent>(
-            Engine::GetInstance().GetSingleComponentOfClass(entity,
-                "SpriteComponent"));
+        auto reproductionComponent = Engine::GetInstance().Get<ReproductionComponent>(entity);
+        auto growthComponent = Engine::GetInstance().Get<GrowthComponent>(entity);
+        auto spriteComponent = Engine::GetInstance().Get<SpriteComponent>(entity);
 
         ConsumeEnergy(growthComponent);
         spriteComponent->SetCurrentFrame(growthComponent->GetEnergy());
 
-        if (growthComponent->GetEnergy() == CFG_GETI("LEVEL_3_MAX_ENERGY")-1)
+        if (growthComponent->GetEnergy() == level3MaxEnergy.Get()-1)
             reproductionComponent->SetEnabled(true);
         else
             reproductionComponent->SetEnabled(false);
     }
 
     if (timer.HasFired())
-        timer.SetTime(CFG_GETF("REPRODUCTION_ENERGY_CONSUMING_PERIOD"));
+        timer.SetTime(reproductionEnergyConsumingPeriod.Get());
 }
 
 void ReproductionSystem::ConsumeEnergy(std::shared_ptr<GrowthComponent> growthComponent)
 {
-    Random r;
     int energy = growthComponent->GetEnergy();
 
-    if (timer.HasFired() && (r.GenerateFloat() < CFG_GETF("REPRODUCTION_ENERGY_CONSUMING_CHANCE")) && energy > 0)
+    if (timer.HasFired() && (random.GenerateFloat() < reproductionEnergyConsumingChance.Get()) && energy > 0)
         --energy;
 
-    if (energy >= CFG_GETI("LEVEL_3_MAX_ENERGY"))
-        energy = CFG_GETI("LEVEL_3_MAX_ENERGY")-1;
+    if (energy >= level3MaxEnergy.Get())
+        energy = level3MaxEnergy.Get()-1;
 
     growthComponent->SetEnergy(energy);
 }
\ No newline at end of file
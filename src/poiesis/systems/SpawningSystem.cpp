@@ -1,5 +1,10 @@
 #include "poiesis/systems/SpawningSystem.h"
 
+CfgFloat SpawningSystem::level1MinX("LEVEL_1_MIN_X");
+CfgFloat SpawningSystem::level1MaxX("LEVEL_1_MAX_X");
+CfgFloat SpawningSystem::level1MinY("LEVEL_1_MIN_Y");
+CfgFloat SpawningSystem::level1MaxY("LEVEL_1_MAX_Y");
+
 SpawningSystem::SpawningSystem(SpawningType spawningType, float spawningChance,
     float spawningPeriod) :
     spawningType(spawningType), spawningChance(spawningChance)
@@ -54,70 +59,70 @@ void SpawningSystem::Spawn()
 
 void SpawningSystem::SpawnCell()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     EntityFactory::CreateCell(Vector(x, y));
-    LOG_I("[SpawningSystem] Spawning new cell at " << x << ", " << y);
+    LOG_D("[SpawningSystem] Spawning new cell at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnLevel1Cell()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     auto cell = EntityFactory::CreateCell(Vector(x, y));
     Engine::GetInstance().AddComponent(
-        std::make_shared<AIComponent>("EatableComponent"), cell);
-    LOG_I("[SpawningSystem] Spawning new level 1 cell at " << x << ", " << y);
+        Engine::GetInstance().CreateComponent<AIComponent>("EatableComponent"), cell);
+    LOG_D("[SpawningSystem] Spawning new level 1 cell at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnLevel2Cell()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     auto cell = EntityFactory::CreateCell(Vector(x, y));
     Engine::GetInstance().AddComponent(
-        std::make_shared<AIComponent>("CellParticleComponent"), cell);
-    LOG_I("[SpawningSystem] Spawning new level 2 cell at " << x << ", " << y);
+        Engine::GetInstance().CreateComponent<AIComponent>("CellParticleComponent"), cell);
+    LOG_D("[SpawningSystem] Spawning new level 2 cell at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnLevel3Cell()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     auto cell = EntityFactory::CreateCell(Vector(x, y));
     Engine::GetInstance().AddComponent(
-        std::make_shared<AIComponent>("EatableComponent"), cell);
-    LOG_I("[SpawningSystem] Spawning new level 3 cell at " << x << ", " << y);
+        Engine::GetInstance().CreateComponent<AIComponent>("EatableComponent"), cell);
+    LOG_D("[SpawningSystem] Spawning new level 3 cell at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnCellParticle()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     EntityFactory::CreateCellParticle(Vector(x, y));
-    LOG_I("[SpawningSystem] Spawning new cell particle at " << x << ", " << y);
+    LOG_D("[SpawningSystem] Spawning new cell particle at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnFood()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     EntityFactory::CreateFood(Vector(x, y));
-    LOG_I("[SpawningSystem] Spawning new food at " << x << ", " << y);
+    LOG_D("[SpawningSystem] Spawning new food at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnBacterium()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     EntityFactory::CreateBacterium(Vector(x, y));
-    LOG_I("[SpawningSystem] Spawning new bacterium at " << x << ", " << y);
+    LOG_D("[SpawningSystem] Spawning new bacterium at " << x << ", " << y);
 }
 
 void SpawningSystem::SpawnVirus()
 {
-    float x = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_X"), CFG_GETF("LEVEL_1_MAX_X"));
-    float y = random.GenerateFloat(CFG_GETF("LEVEL_1_MIN_Y"), CFG_GETF("LEVEL_1_MAX_Y"));
+    float x = random.GenerateFloat(level1MinX.Get(), level1MaxX.Get());
+    float y = random.GenerateFloat(level1MinY.Get(), level1MaxY.Get());
     EntityFactory::CreateVirus(Vector(x, y));
-    LOG_I("[SpawningSystem] Spawning new virus at " << x << ", " << y);
+    LOG_D("[SpawningSystem] Spawning new virus at " << x << ", " << y);
 }
\ No newline at end of file